@@ -0,0 +1,109 @@
+#include "disk_result_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+// The files start with the magic, the cache version and the amount of iterations, followed by the dps of the
+// iterations. They're written in the machine's byte order since they never leave it.
+constexpr char kMagic[4] = {'W', 'S', 'R', 'C'};
+
+std::filesystem::path EntryPath(const std::string& directory, uint64_t key) {
+  char file_name[32];
+  std::snprintf(file_name, sizeof(file_name), "%016llx.bin", static_cast<unsigned long long>(key));
+  return std::filesystem::path(directory) / file_name;
+}
+
+// A truncated or otherwise corrupt entry counts as not cached
+bool LoadEntry(const std::string& directory, uint64_t key, CachedIterations& iterations) {
+  const auto kPath = EntryPath(directory, key);
+  std::ifstream file(kPath, std::ios::binary);
+  char magic[4];
+  uint32_t version = 0;
+  uint32_t amount = 0;
+
+  if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(magic)) != 0 ||
+      !file.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != kResultCacheVersion ||
+      !file.read(reinterpret_cast<char*>(&amount), sizeof(amount))) {
+    return false;
+  }
+
+  // The amount is only trusted if the file holds exactly that many dps values, so that a corrupt one can't make it
+  // allocate more than the file's size
+  std::error_code error;
+  const auto kFileSize = std::filesystem::file_size(kPath, error);
+  constexpr auto kHeaderSize = sizeof(kMagic) + sizeof(version) + sizeof(amount);
+
+  if (error || kFileSize < kHeaderSize || (kFileSize - kHeaderSize) / sizeof(double) != amount ||
+      (kFileSize - kHeaderSize) % sizeof(double) != 0) {
+    return false;
+  }
+
+  iterations.dps.resize(amount);
+
+  return static_cast<bool>(file.read(reinterpret_cast<char*>(iterations.dps.data()), amount * sizeof(double)));
+}
+
+// Writes to a temporary file first and renames it over the entry, so that a sim running at the same time never reads
+// a half written entry
+void StoreEntry(const std::string& directory, uint64_t key, const CachedIterations& iterations) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    return;
+  }
+
+  const auto kPath = EntryPath(directory, key);
+  auto temporary_path = kPath;
+  temporary_path += ".tmp" + std::to_string(std::random_device()());
+  const auto kAmount = static_cast<uint32_t>(iterations.dps.size());
+
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(&kResultCacheVersion), sizeof(kResultCacheVersion));
+    file.write(reinterpret_cast<const char*>(&kAmount), sizeof(kAmount));
+    file.write(reinterpret_cast<const char*>(iterations.dps.data()), kAmount * sizeof(double));
+
+    if (!file.flush()) {
+      file.close();
+      std::filesystem::remove(temporary_path, error);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temporary_path, kPath, error);
+  if (error) {
+    std::filesystem::remove(temporary_path, error);
+  }
+}
+}  // namespace
+
+ResultCache DiskResultCache(const std::string& directory) {
+  auto cache = ResultCache();
+
+  cache.load = [directory](uint64_t key, CachedIterations& iterations) {
+    return LoadEntry(directory, key, iterations);
+  };
+  cache.store = [directory](uint64_t key, const CachedIterations& iterations) {
+    StoreEntry(directory, key, iterations);
+  };
+
+  return cache;
+}
+
+std::string DefaultResultCacheDirectory() {
+  if (const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME"); xdg_cache_home != NULL && *xdg_cache_home != '\0') {
+    return (std::filesystem::path(xdg_cache_home) / "warlock-sim").string();
+  }
+  if (const char* home = std::getenv("HOME"); home != NULL && *home != '\0') {
+    return (std::filesystem::path(home) / ".cache" / "warlock-sim").string();
+  }
+
+  return "";
+}
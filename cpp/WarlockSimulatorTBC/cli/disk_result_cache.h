@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include "../include/result_cache.h"
+
+// A result cache that keeps every entry in its own file in the directory, named after the entry's key. Entries that
+// can't be read (missing, corrupt or from another cache version) count as not cached, and failing to write one only
+// means that the iterations will be simulated again next time, so neither is an error.
+ResultCache DiskResultCache(const std::string& directory);
+// $XDG_CACHE_HOME/warlock-sim, or ~/.cache/warlock-sim. Empty if neither variable is set.
+std::string DefaultResultCacheDirectory();
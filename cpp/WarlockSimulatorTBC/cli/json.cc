@@ -0,0 +1,261 @@
+#include "json.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+struct JsonParser {
+  const std::string& text;
+  size_t position = 0;
+
+  explicit JsonParser(const std::string& json_text) : text(json_text) {}
+
+  void Fail(const std::string& error) const {
+    throw std::runtime_error("Invalid JSON at position " + std::to_string(position) + ": " + error);
+  }
+
+  void SkipWhitespace() {
+    while (position < text.size() &&
+           (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r')) {
+      position++;
+    }
+  }
+
+  void Expect(char character) {
+    SkipWhitespace();
+    if (position >= text.size() || text[position] != character) {
+      Fail(std::string("expected '") + character + "'");
+    }
+    position++;
+  }
+
+  bool Consume(const std::string& word) {
+    if (text.compare(position, word.size(), word) == 0) {
+      position += word.size();
+      return true;
+    }
+    return false;
+  }
+
+  JsonValue ParseValue() {
+    SkipWhitespace();
+    if (position >= text.size()) {
+      Fail("unexpected end of input");
+    }
+
+    JsonValue value;
+    const char kCharacter = text[position];
+
+    if (kCharacter == '{') {
+      value.type = JsonValue::Type::kObject;
+      position++;
+      SkipWhitespace();
+      if (position < text.size() && text[position] == '}') {
+        position++;
+        return value;
+      }
+      do {
+        SkipWhitespace();
+        if (position >= text.size() || text[position] != '"') {
+          Fail("expected a key");
+        }
+        auto key = ParseString();
+        Expect(':');
+        value.object.emplace_back(std::move(key), ParseValue());
+        SkipWhitespace();
+      } while (position < text.size() && text[position] == ',' && ++position);
+      Expect('}');
+    } else if (kCharacter == '[') {
+      value.type = JsonValue::Type::kArray;
+      position++;
+      SkipWhitespace();
+      if (position < text.size() && text[position] == ']') {
+        position++;
+        return value;
+      }
+      do {
+        value.array.push_back(ParseValue());
+        SkipWhitespace();
+      } while (position < text.size() && text[position] == ',' && ++position);
+      Expect(']');
+    } else if (kCharacter == '"') {
+      value.type = JsonValue::Type::kString;
+      value.string = ParseString();
+    } else if (Consume("true")) {
+      value.type = JsonValue::Type::kBool;
+      value.boolean = true;
+    } else if (Consume("false")) {
+      value.type = JsonValue::Type::kBool;
+    } else if (Consume("null")) {
+      value.type = JsonValue::Type::kNull;
+    } else {
+      const char* kStart = text.c_str() + position;
+      char* end = nullptr;
+      value.type = JsonValue::Type::kNumber;
+      value.number = std::strtod(kStart, &end);
+      if (end == kStart) {
+        Fail("unexpected character");
+      }
+      position += end - kStart;
+    }
+
+    return value;
+  }
+
+  std::string ParseString() {
+    std::string result;
+    position++;  // The opening quote
+
+    while (position < text.size() && text[position] != '"') {
+      char character = text[position++];
+
+      if (character != '\\') {
+        result += character;
+        continue;
+      }
+      if (position >= text.size()) {
+        break;
+      }
+
+      character = text[position++];
+      if (character == 'n') {
+        result += '\n';
+      } else if (character == 't') {
+        result += '\t';
+      } else if (character == 'r') {
+        result += '\r';
+      } else if (character == 'b') {
+        result += '\b';
+      } else if (character == 'f') {
+        result += '\f';
+      } else if (character == 'u') {
+        if (position + 4 > text.size()) {
+          Fail("invalid unicode escape");
+        }
+        // Encode the code point as UTF-8. Surrogate pairs aren't combined since the settings don't contain them.
+        const auto kCodePoint = std::strtoul(text.substr(position, 4).c_str(), nullptr, 16);
+        position += 4;
+        if (kCodePoint < 0x80) {
+          result += static_cast<char>(kCodePoint);
+        } else if (kCodePoint < 0x800) {
+          result += static_cast<char>(0xC0 | (kCodePoint >> 6));
+          result += static_cast<char>(0x80 | (kCodePoint & 0x3F));
+        } else {
+          result += static_cast<char>(0xE0 | (kCodePoint >> 12));
+          result += static_cast<char>(0x80 | ((kCodePoint >> 6) & 0x3F));
+          result += static_cast<char>(0x80 | (kCodePoint & 0x3F));
+        }
+      } else {
+        result += character;
+      }
+    }
+
+    if (position >= text.size()) {
+      Fail("unterminated string");
+    }
+    position++;  // The closing quote
+
+    return result;
+  }
+};
+}  // namespace
+
+JsonValue JsonValue::Parse(const std::string& text) {
+  auto parser = JsonParser(text);
+  auto value = parser.ParseValue();
+
+  parser.SkipWhitespace();
+  if (parser.position != text.size()) {
+    parser.Fail("unexpected data after the end of the document");
+  }
+
+  return value;
+}
+
+bool JsonValue::Has(const std::string& key) const {
+  for (const auto& kMember : object) {
+    if (kMember.first == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const {
+  static const JsonValue kNull;
+
+  for (const auto& kMember : object) {
+    if (kMember.first == key) {
+      return kMember.second;
+    }
+  }
+  return kNull;
+}
+
+int JsonValue::ToInt() const {
+  if (type == Type::kNumber && std::isfinite(number)) {
+    return static_cast<int>(number);
+  }
+  if (type == Type::kString) {
+    return static_cast<int>(std::strtol(string.c_str(), nullptr, 10));
+  }
+  return 0;
+}
+
+double JsonValue::ToDouble() const {
+  if (type == Type::kNumber) {
+    return number;
+  }
+  if (type == Type::kString) {
+    return std::strtod(string.c_str(), nullptr);
+  }
+  return 0;
+}
+
+bool JsonValue::IsTruthy() const {
+  if (type == Type::kBool) {
+    return boolean;
+  }
+  if (type == Type::kNumber) {
+    return number != 0 && !std::isnan(number);
+  }
+  if (type == Type::kString) {
+    return !string.empty();
+  }
+  return type == Type::kArray || type == Type::kObject;
+}
+
+bool JsonValue::IsString(const std::string& value) const { return type == Type::kString && string == value; }
+
+std::string JsonString(const std::string& value) {
+  std::string result = "\"";
+
+  for (const char kCharacter : value) {
+    if (kCharacter == '"' || kCharacter == '\\') {
+      result += '\\';
+      result += kCharacter;
+    } else if (kCharacter == '\n') {
+      result += "\\n";
+    } else if (static_cast<unsigned char>(kCharacter) < 0x20) {
+      char escaped[7];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", kCharacter);
+      result += escaped;
+    } else {
+      result += kCharacter;
+    }
+  }
+
+  return result + "\"";
+}
+
+std::string JsonNumber(double value) {
+  if (!std::isfinite(value)) {
+    return "null";
+  }
+
+  char number[32];
+  std::snprintf(number, sizeof(number), "%.15g", value);
+  return number;
+}
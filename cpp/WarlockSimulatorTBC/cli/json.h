@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// A parsed JSON document. Only as much of JSON as the command-line runner needs to read the web worker's settings and
+// write its results.
+struct JsonValue {
+  enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+
+  Type type = Type::kNull;
+  bool boolean = false;
+  double number = 0;
+  std::string string;
+  std::vector<JsonValue> array;
+  std::vector<std::pair<std::string, JsonValue>> object;
+
+  static JsonValue Parse(const std::string& text);
+  bool Has(const std::string& key) const;
+  // The null value if the key doesn't exist
+  const JsonValue& operator[](const std::string& key) const;
+  // These convert the same way as the web worker's parseInt(value) || 0, parseFloat(value) || 0 and value || false
+  int ToInt() const;
+  double ToDouble() const;
+  bool IsTruthy() const;
+  bool IsString(const std::string& value) const;
+};
+
+// Quotes and escapes a string for writing it to JSON
+std::string JsonString(const std::string& value);
+// Numbers that JSON can't represent (infinity and NaN) are written as null
+std::string JsonNumber(double value);
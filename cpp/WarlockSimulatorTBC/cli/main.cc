@@ -0,0 +1,504 @@
+// Command-line runner for the simulation. It reads the same message that the web worker gets from the website (an
+// object with playerSettings, simulationSettings, simulationType, randomSeed etc.) as JSON from a file or stdin, runs
+// it natively on every core and prints the results as JSON.
+//
+// Usage: warlock-sim [--cache-dir <directory>] [--no-cache] [settings.json]
+//
+// simulationType is 0 for a normal sim, 1 for all items and 2 for stat weights. All-items sims take the items to sim
+// from itemCandidates, an array of {itemId, metaGemId, items, sets, stats} like the website sends to its workers.
+//
+// With antitheticVariates every iteration is the average of a fight and its mirrored twin, so minDps and maxDps are
+// the lowest and highest of those pair averages, not of single fights.
+//
+// The dps of every simulated configuration is cached on disk (in DefaultResultCacheDirectory() unless --cache-dir is
+// given), so simming the same settings again only simulates the iterations that aren't in the cache yet. The seed is
+// part of the cache key, so settings without a randomSeed use a fixed one to be able to use the cache.
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../include/bindings.h"
+#include "../include/player.h"
+#include "../include/simulation.h"
+#include "disk_result_cache.h"
+#include "json.h"
+
+// The keys the website uses for each setting, same as in web.worker.js
+static const std::vector<std::pair<const char*, int Items::*>> kItemKeys{
+    {"head", &Items::head},
+    {"neck", &Items::neck},
+    {"shoulders", &Items::shoulders},
+    {"back", &Items::back},
+    {"chest", &Items::chest},
+    {"bracer", &Items::bracers},
+    {"gloves", &Items::gloves},
+    {"belt", &Items::belt},
+    {"legs", &Items::legs},
+    {"boots", &Items::boots},
+    {"ring1", &Items::ring_1},
+    {"ring2", &Items::ring_2},
+    {"trinket1", &Items::trinket_1},
+    {"trinket2", &Items::trinket_2},
+    {"mainhand", &Items::main_hand},
+    {"offhand", &Items::off_hand},
+    {"twohand", &Items::two_hand},
+    {"wand", &Items::wand},
+};
+
+static const std::vector<std::pair<const char*, bool AuraSelection::*>> kAuraKeys{
+    {"felArmor", &AuraSelection::fel_armor},
+    {"judgementOfWisdom", &AuraSelection::judgement_of_wisdom},
+    {"manaSpringTotem", &AuraSelection::mana_spring_totem},
+    {"wrathOfAirTotem", &AuraSelection::wrath_of_air_totem},
+    {"totemOfWrath", &AuraSelection::totem_of_wrath},
+    {"markOfTheWild", &AuraSelection::mark_of_the_wild},
+    {"prayerOfSpirit", &AuraSelection::prayer_of_spirit},
+    {"bloodPact", &AuraSelection::blood_pact},
+    {"inspiringPresence", &AuraSelection::inspiring_presence},
+    {"moonkinAura", &AuraSelection::moonkin_aura},
+    {"powerInfusion", &AuraSelection::power_infusion},
+    {"powerOfTheGuardianWarlock", &AuraSelection::atiesh_warlock},
+    {"powerOfTheGuardianMage", &AuraSelection::atiesh_mage},
+    {"eyeOfTheNight", &AuraSelection::eye_of_the_night},
+    {"chainOfTheTwilightOwl", &AuraSelection::chain_of_the_twilight_owl},
+    {"jadePendantOfBlasting", &AuraSelection::jade_pendant_of_blasting},
+    {"drumsOfBattle", &AuraSelection::drums_of_battle},
+    {"drumsOfWar", &AuraSelection::drums_of_war},
+    {"drumsOfRestoration", &AuraSelection::drums_of_restoration},
+    {"bloodlust", &AuraSelection::bloodlust},
+    {"ferociousInspiration", &AuraSelection::ferocious_inspiration},
+    {"innervate", &AuraSelection::innervate},
+    {"manaTideTotem", &AuraSelection::mana_tide_totem},
+    {"airmansRibbonOfGallantry", &AuraSelection::airmans_ribbon_of_gallantry},
+    {"curseOfTheElements", &AuraSelection::curse_of_the_elements},
+    {"shadowWeaving", &AuraSelection::shadow_weaving},
+    {"improvedScorch", &AuraSelection::improved_scorch},
+    {"misery", &AuraSelection::misery},
+    {"judgementOfTheCrusader", &AuraSelection::judgement_of_the_crusader},
+    {"vampiricTouch", &AuraSelection::vampiric_touch},
+    {"faerieFire", &AuraSelection::faerie_fire},
+    {"sunderArmor", &AuraSelection::sunder_armor},
+    {"exposeArmor", &AuraSelection::expose_armor},
+    {"curseOfRecklessness", &AuraSelection::curse_of_recklessness},
+    {"bloodFrenzy", &AuraSelection::blood_frenzy},
+    {"exposeWeakness", &AuraSelection::expose_weakness},
+    {"annihilator", &AuraSelection::annihilator},
+    {"improvedHuntersMark", &AuraSelection::improved_hunters_mark},
+    {"superManaPotion", &AuraSelection::super_mana_potion},
+    {"destructionPotion", &AuraSelection::destruction_potion},
+    {"demonicRune", &AuraSelection::demonic_rune},
+    {"flameCap", &AuraSelection::flame_cap},
+    {"chippedPowerCore", &AuraSelection::chipped_power_core},
+    {"crackedPowerCore", &AuraSelection::cracked_power_core},
+    {"blessingOfKingsPet", &AuraSelection::pet_blessing_of_kings},
+    {"blessingOfWisdomPet", &AuraSelection::pet_blessing_of_wisdom},
+    {"blessingOfMight", &AuraSelection::pet_blessing_of_might},
+    {"battleSquawk", &AuraSelection::pet_battle_squawk},
+    {"arcaneIntellectPet", &AuraSelection::pet_arcane_intellect},
+    {"markOfTheWildPet", &AuraSelection::pet_mark_of_the_wild},
+    {"prayerOfFortitudePet", &AuraSelection::pet_prayer_of_fortitude},
+    {"prayerOfSpiritPet", &AuraSelection::pet_prayer_of_spirit},
+    {"kiblersBits", &AuraSelection::pet_kiblers_bits},
+    {"heroicPresence", &AuraSelection::pet_heroic_presence},
+    {"strengthOfEarthTotem", &AuraSelection::pet_strength_of_earth_totem},
+    {"graceOfAirTotem", &AuraSelection::pet_grace_of_air_totem},
+    {"battleShout", &AuraSelection::pet_battle_shout},
+    {"trueshotAura", &AuraSelection::pet_trueshot_aura},
+    {"leaderOfThePack", &AuraSelection::pet_leader_of_the_pack},
+    {"unleashedRage", &AuraSelection::pet_unleashed_rage},
+    {"scrollOfStaminaV", &AuraSelection::pet_stamina_scroll},
+    {"scrollOfIntellectV", &AuraSelection::pet_intellect_scroll},
+    {"scrollOfStrengthV", &AuraSelection::pet_strength_scroll},
+    {"scrollOfAgilityV", &AuraSelection::pet_agility_scroll},
+    {"scrollOfSpiritV", &AuraSelection::pet_spirit_scroll},
+};
+
+static const std::vector<std::pair<const char*, int Talents::*>> kTalentKeys{
+    {"suppression", &Talents::suppression},
+    {"improvedCorruption", &Talents::improved_corruption},
+    {"improvedLifeTap", &Talents::improved_life_tap},
+    {"improvedCurseOfAgony", &Talents::improved_curse_of_agony},
+    {"amplifyCurse", &Talents::amplify_curse},
+    {"nightfall", &Talents::nightfall},
+    {"empoweredCorruption", &Talents::empowered_corruption},
+    {"siphonLife", &Talents::siphon_life},
+    {"shadowMastery", &Talents::shadow_mastery},
+    {"contagion", &Talents::contagion},
+    {"darkPact", &Talents::dark_pact},
+    {"unstableAffliction", &Talents::unstable_affliction},
+    {"improvedImp", &Talents::improved_imp},
+    {"demonicEmbrace", &Talents::demonic_embrace},
+    {"felIntellect", &Talents::fel_intellect},
+    {"felStamina", &Talents::fel_stamina},
+    {"improvedSuccubus", &Talents::improved_succubus},
+    {"demonicAegis", &Talents::demonic_aegis},
+    {"unholyPower", &Talents::unholy_power},
+    {"demonicSacrifice", &Talents::demonic_sacrifice},
+    {"manaFeed", &Talents::mana_feed},
+    {"masterDemonologist", &Talents::master_demonologist},
+    {"soulLink", &Talents::soul_link},
+    {"demonicKnowledge", &Talents::demonic_knowledge},
+    {"demonicTactics", &Talents::demonic_tactics},
+    {"improvedShadowBolt", &Talents::improved_shadow_bolt},
+    {"cataclysm", &Talents::cataclysm},
+    {"bane", &Talents::bane},
+    {"improvedFirebolt", &Talents::improved_firebolt},
+    {"improvedLashOfPain", &Talents::improved_lash_of_pain},
+    {"devastation", &Talents::devastation},
+    {"shadowburn", &Talents::shadowburn},
+    {"improvedSearingPain", &Talents::improved_searing_pain},
+    {"improvedImmolate", &Talents::improved_immolate},
+    {"ruin", &Talents::ruin},
+    {"emberstorm", &Talents::emberstorm},
+    {"backlash", &Talents::backlash},
+    {"conflagrate", &Talents::conflagrate},
+    {"shadowAndFlame", &Talents::shadow_and_flame},
+    {"shadowfury", &Talents::shadowfury},
+};
+
+static const std::vector<std::pair<const char*, int Sets::*>> kSetKeys{
+    {"529", &Sets::t3},
+    {"552", &Sets::spellfire},
+    {"559", &Sets::spellstrike},
+    {"644", &Sets::oblivion},
+    {"658", &Sets::mana_etched},
+    {"667", &Sets::twin_stars},
+    {"645", &Sets::t4},
+    {"646", &Sets::t5},
+    {"670", &Sets::t6},
+};
+
+static const std::vector<std::pair<const char*, double CharacterStats::*>> kStatKeys{
+    {"health", &CharacterStats::health},
+    {"mana", &CharacterStats::mana},
+    {"stamina", &CharacterStats::stamina},
+    {"intellect", &CharacterStats::intellect},
+    {"spirit", &CharacterStats::spirit},
+    {"spellPower", &CharacterStats::spell_power},
+    {"shadowPower", &CharacterStats::shadow_power},
+    {"firePower", &CharacterStats::fire_power},
+    {"hasteRating", &CharacterStats::spell_haste_rating},
+    {"hitRating", &CharacterStats::spell_hit_rating},
+    {"critRating", &CharacterStats::spell_crit_rating},
+    {"mp5", &CharacterStats::mp5},
+    {"spellPenetration", &CharacterStats::spell_penetration},
+    {"fireModifier", &CharacterStats::fire_modifier},
+    {"shadowModifier", &CharacterStats::shadow_modifier},
+    {"staminaModifier", &CharacterStats::stamina_modifier},
+    {"intellectModifier", &CharacterStats::intellect_modifier},
+    {"spiritModifier", &CharacterStats::spirit_modifier},
+};
+
+static const std::vector<std::pair<const char*, EmbindConstant>> kEmbindConstantNames{
+    {"aldor", EmbindConstant::kAldor},
+    {"scryers", EmbindConstant::kScryers},
+    {"onCooldown", EmbindConstant::kOnCooldown},
+    {"singleTarget", EmbindConstant::kSingleTarget},
+    {"aoe", EmbindConstant::kAoe},
+    {"noIsb", EmbindConstant::kNoIsb},
+    {"human", EmbindConstant::kHuman},
+    {"gnome", EmbindConstant::kGnome},
+    {"orc", EmbindConstant::kOrc},
+    {"undead", EmbindConstant::kUndead},
+    {"bloodElf", EmbindConstant::kBloodElf},
+    {"simChooses", EmbindConstant::kSimChooses},
+    {"userChooses", EmbindConstant::kUserChooses},
+    {"stamina", EmbindConstant::kStamina},
+    {"intellect", EmbindConstant::kIntellect},
+    {"spirit", EmbindConstant::kSpirit},
+    {"spellPower", EmbindConstant::kSpellPower},
+    {"shadowPower", EmbindConstant::kShadowPower},
+    {"firePower", EmbindConstant::kFirePower},
+    {"hitRating", EmbindConstant::kHitRating},
+    {"critRating", EmbindConstant::kCritRating},
+    {"hasteRating", EmbindConstant::kHasteRating},
+    {"mp5", EmbindConstant::kMp5},
+    {"normal", EmbindConstant::kNormal},
+    {"imp", EmbindConstant::kImp},
+    {"succubus", EmbindConstant::kSuccubus},
+    {"felhunter", EmbindConstant::kFelhunter},
+    {"felguard", EmbindConstant::kFelguard},
+    {"passive", EmbindConstant::kPassive},
+    {"aggressive", EmbindConstant::kAggressive},
+};
+
+static EmbindConstant EmbindConstantFromName(const std::string& name) {
+  for (const auto& kConstant : kEmbindConstantNames) {
+    if (name == kConstant.first) {
+      return kConstant.second;
+    }
+  }
+  return EmbindConstant::kUnused;
+}
+
+static Items ReadItems(const JsonValue& json) {
+  auto items = Items();
+  for (const auto& kKey : kItemKeys) {
+    items.*kKey.second = json[kKey.first].ToInt();
+  }
+  return items;
+}
+
+static Sets ReadSets(const JsonValue& json) {
+  auto sets = Sets();
+  for (const auto& kKey : kSetKeys) {
+    sets.*kKey.second = json[kKey.first].ToInt();
+  }
+  return sets;
+}
+
+static CharacterStats ReadStats(const JsonValue& json) {
+  auto stats = CharacterStats();
+  for (const auto& kKey : kStatKeys) {
+    stats.*kKey.second = json[kKey.first].ToDouble();
+  }
+  return stats;
+}
+
+// Fills in the rest of the player settings the same way as web.worker.js
+static void ReadPlayerSettings(const JsonValue& message, PlayerSettings& settings) {
+  const auto& kPlayerData = message["playerSettings"];
+  const auto& kSimSettings = kPlayerData["simSettings"];
+  const auto& kRotation = kPlayerData["rotation"];
+  const auto& kPetChoice = kSimSettings["petChoice"];
+
+  settings.item_id = message["itemId"].ToInt();
+  settings.meta_gem_id = kPlayerData["metaGemId"].ToInt();
+  // The combat log and breakdown are only shown on the website
+  settings.equipped_item_simulation = false;
+  settings.recording_combat_log_breakdown = false;
+  settings.custom_stat = EmbindConstantFromName(message.Has("customStat") ? message["customStat"].string : "normal");
+  settings.shattrath_faction =
+      kSimSettings["shattrathFaction"].IsString("Aldor") ? EmbindConstant::kAldor : EmbindConstant::kScryers;
+  settings.enemy_level = kSimSettings["target-level"].ToInt();
+  settings.enemy_shadow_resist = kSimSettings["target-shadow-resistance"].ToInt();
+  settings.enemy_fire_resist = kSimSettings["target-fire-resistance"].ToInt();
+  settings.mage_atiesh_amount = kSimSettings["mageAtieshAmount"].ToInt();
+  settings.totem_of_wrath_amount = kSimSettings["totemOfWrathAmount"].ToInt();
+  settings.chipped_power_core_amount = kSimSettings["chippedPowerCoreAmount"].ToInt();
+  settings.cracked_power_core_amount = kSimSettings["crackedPowerCoreAmount"].ToInt();
+  settings.sacrificing_pet = kSimSettings["sacrificePet"].IsString("yes");
+  if (kPetChoice.IsString("0")) {
+    settings.selected_pet = EmbindConstant::kImp;
+  } else if (kPetChoice.IsString("2")) {
+    settings.selected_pet = EmbindConstant::kSuccubus;
+  } else if (kPetChoice.IsString("3")) {
+    settings.selected_pet = EmbindConstant::kFelhunter;
+  } else if (kPetChoice.IsString("4")) {
+    settings.selected_pet = EmbindConstant::kFelguard;
+  }
+  settings.ferocious_inspiration_amount = kSimSettings["ferociousInspirationAmount"].ToInt();
+  settings.improved_curse_of_the_elements = kSimSettings["improvedCurseOfTheElements"].ToInt();
+  settings.using_custom_isb_uptime = kSimSettings["customIsbUptime"].IsString("yes");
+  settings.custom_isb_uptime_value = static_cast<int>(kSimSettings["customIsbUptimeValue"].ToDouble());
+  settings.improved_divine_spirit = kSimSettings["improvedDivineSpirit"].ToInt();
+  settings.improved_imp = kSimSettings["improvedImpSetting"].ToInt();
+  settings.shadow_priest_dps = kSimSettings["shadowPriestDps"].ToInt();
+  settings.warlock_atiesh_amount = kSimSettings["warlockAtieshAmount"].ToInt();
+  settings.improved_expose_armor = kSimSettings["improvedExposeArmor"].ToInt();
+  settings.fight_type = !kSimSettings["fightType"].IsTruthy() || kSimSettings["fightType"].IsString("singleTarget")
+                            ? EmbindConstant::kSingleTarget
+                            : EmbindConstant::kAoe;
+  settings.enemy_amount = kSimSettings["enemyAmount"].ToInt();
+  settings.race = EmbindConstantFromName(kSimSettings["race"].string);
+  settings.power_infusion_amount = kSimSettings["powerInfusionAmount"].ToInt();
+  settings.bloodlust_amount = kSimSettings["bloodlustAmount"].ToInt();
+  settings.innervate_amount = kSimSettings["innervateAmount"].ToInt();
+  settings.battle_squawk_amount = kSimSettings["battleSquawkAmount"].ToInt();
+  settings.enemy_armor = kSimSettings["enemyArmor"].ToInt();
+  settings.expose_weakness_uptime = static_cast<int>(kSimSettings["exposeWeaknessUptime"].ToDouble());
+  settings.improved_faerie_fire = kSimSettings["improvedFaerieFire"].IsString("yes");
+  settings.infinite_player_mana = kSimSettings["infinitePlayerMana"].IsString("yes");
+  settings.infinite_pet_mana = kSimSettings["infinitePetMana"].IsString("yes");
+  settings.lash_of_pain_usage =
+      kSimSettings["lashOfPainUsage"].IsString("onCooldown") ? EmbindConstant::kOnCooldown : EmbindConstant::kNoIsb;
+  settings.pet_mode = kSimSettings["petMode"].IsString("0") ? EmbindConstant::kPassive : EmbindConstant::kAggressive;
+  settings.prepop_black_book = kSimSettings["prepopBlackBook"].IsString("yes");
+  settings.randomize_values = kSimSettings["randomizeValues"].IsString("yes");
+  settings.rotation_option =
+      kSimSettings["rotationOption"].IsString("simChooses") ? EmbindConstant::kSimChooses : EmbindConstant::kUserChooses;
+  settings.exalted_with_shattrath_faction = kSimSettings["shattrathFactionReputation"].IsString("yes");
+  settings.survival_hunter_agility = kSimSettings["survivalHunterAgility"].ToInt();
+  settings.has_immolate = kRotation["dot"]["immolate"].IsTruthy();
+  settings.has_corruption = kRotation["dot"]["corruption"].IsTruthy();
+  settings.has_siphon_life = kRotation["dot"]["siphonLife"].IsTruthy();
+  settings.has_unstable_affliction = kRotation["dot"]["unstableAffliction"].IsTruthy();
+  settings.has_searing_pain = kRotation["filler"]["searingPain"].IsTruthy();
+  settings.has_shadow_bolt = kRotation["filler"]["shadowBolt"].IsTruthy();
+  settings.has_incinerate = kRotation["filler"]["incinerate"].IsTruthy();
+  settings.has_curse_of_recklessness = kRotation["curse"]["curseOfRecklessness"].IsTruthy();
+  settings.has_curse_of_the_elements = kRotation["curse"]["curseOfTheElements"].IsTruthy();
+  settings.has_curse_of_agony = kRotation["curse"]["curseOfAgony"].IsTruthy();
+  settings.has_curse_of_doom = kRotation["curse"]["curseOfDoom"].IsTruthy();
+  settings.has_death_coil = kRotation["finisher"]["deathCoil"].IsTruthy();
+  settings.has_shadow_burn = kRotation["finisher"]["shadowburn"].IsTruthy();
+  settings.has_conflagrate = kRotation["finisher"]["conflagrate"].IsTruthy();
+  settings.has_shadowfury = kRotation["other"]["shadowfury"].IsTruthy();
+  settings.has_amplify_curse = kRotation["other"]["amplifyCurse"].IsTruthy();
+  settings.has_dark_pact = kRotation["other"]["darkPact"].IsTruthy();
+  settings.has_elemental_shaman_t4_bonus = kSimSettings["improvedWrathOfAirTotem"].IsString("yes");
+}
+
+static SimulationSettings ReadSimulationSettings(const JsonValue& message) {
+  const auto& kSimulationData = message["simulationSettings"];
+  auto settings = SimulationSettings();
+
+  settings.iterations = kSimulationData["iterations"].ToInt();
+  settings.min_time = kSimulationData["minTime"].ToInt();
+  settings.max_time = kSimulationData["maxTime"].ToInt();
+  settings.simulation_type = static_cast<SimulationType>(message["simulationType"].ToInt());
+  // Unlike in the browser every core is used unless the settings say otherwise
+  settings.threads = kSimulationData["threads"].ToInt() > 0 ? kSimulationData["threads"].ToInt()
+                                                             : static_cast<int>(std::thread::hardware_concurrency());
+  settings.stat_weight_increase =
+      kSimulationData.Has("statWeightIncrease") ? kSimulationData["statWeightIncrease"].ToInt() : 100;
+  settings.approximate_median = kSimulationData["approximateMedian"].IsTruthy();
+  settings.target_standard_error = kSimulationData["targetStandardError"].ToDouble();
+  settings.relative_standard_error = kSimulationData["relativeStandardError"].IsTruthy();
+  settings.min_iterations = kSimulationData["minIterations"].ToInt();
+  settings.racing = kSimulationData["racing"].IsTruthy();
+  settings.antithetic_variates = kSimulationData["antitheticVariates"].IsTruthy();
+
+  if (settings.iterations <= 0) {
+    throw std::runtime_error("simulationSettings.iterations has to be a positive number");
+  }
+  if (settings.max_time < settings.min_time) {
+    throw std::runtime_error("simulationSettings.maxTime can't be less than minTime");
+  }
+
+  return settings;
+}
+
+static std::string ReadInput(const std::string& path) {
+  if (path.empty() || path == "-") {
+    return std::string(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+  }
+
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Couldn't open " + path);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+static int PrintUsage(const char* program, int exit_code) {
+  std::cerr << "Usage: " << program << " [--cache-dir <directory>] [--no-cache] [settings.json]" << std::endl
+            << "Reads the settings from stdin when no file is given and prints the results as JSON." << std::endl;
+  return exit_code;
+}
+
+int main(int argc, char* argv[]) {
+  std::string input_path;
+  std::string cache_directory = DefaultResultCacheDirectory();
+
+  for (int i = 1; i < argc; i++) {
+    const std::string kArgument = argv[i];
+
+    if (kArgument == "-h" || kArgument == "--help") {
+      return PrintUsage(argv[0], 0);
+    } else if (kArgument == "--cache-dir" && i + 1 < argc) {
+      cache_directory = argv[++i];
+    } else if (kArgument == "--no-cache") {
+      cache_directory.clear();
+    } else if (input_path.empty() && (kArgument == "-" || kArgument[0] != '-')) {
+      input_path = kArgument;
+    } else {
+      return PrintUsage(argv[0], 1);
+    }
+  }
+
+  std::vector<std::string> results;
+  std::vector<std::string> stat_weights;
+
+  native_callbacks.simulation_results = [&](double median_dps, double min_dps, double max_dps, int item_id,
+                                            int iteration_amount, int effective_iterations,
+                                            double confidence_interval, int total_fight_duration,
+                                            const char* custom_stat, long long simulation_duration) {
+    results.push_back("{\"itemId\": " + std::to_string(item_id) + ", \"customStat\": " + JsonString(custom_stat) +
+                      ", \"medianDps\": " + JsonNumber(median_dps) + ", \"minDps\": " + JsonNumber(min_dps) +
+                      ", \"maxDps\": " + JsonNumber(max_dps) + ", \"confidenceInterval\": " +
+                      JsonNumber(confidence_interval) + ", \"iterationAmount\": " + std::to_string(iteration_amount) +
+                      // Left out when it isn't known
+                      (effective_iterations > 0
+                           ? ", \"effectiveIterations\": " + std::to_string(effective_iterations)
+                           : std::string()) +
+                      ", \"totalDuration\": " + std::to_string(total_fight_duration) +
+                      ", \"simulationDuration\": " + JsonNumber(simulation_duration / 1000000.0) + "}");
+  };
+  native_callbacks.stat_weight_result = [&](const char* custom_stat, double dps_difference, double standard_error) {
+    stat_weights.push_back("{\"customStat\": " + JsonString(custom_stat) + ", \"dpsDifference\": " +
+                           JsonNumber(dps_difference) + ", \"standardError\": " + JsonNumber(standard_error) + "}");
+  };
+
+  try {
+    const auto kMessage = JsonValue::Parse(ReadInput(input_path));
+    const auto& kPlayerData = kMessage["playerSettings"];
+    const auto kSimulationSettings = ReadSimulationSettings(kMessage);
+
+    auto auras = AuraSelection();
+    for (const auto& kKey : kAuraKeys) {
+      auras.*kKey.second = kPlayerData["auras"][kKey.first].IsTruthy();
+    }
+
+    auto talents = Talents();
+    for (const auto& kKey : kTalentKeys) {
+      talents.*kKey.second = kPlayerData["talents"][kKey.first].ToInt();
+    }
+
+    auto sets = ReadSets(kPlayerData["sets"]);
+    auto stats = ReadStats(kPlayerData["stats"]);
+    auto items = ReadItems(kPlayerData["items"]);
+    auto player_settings = PlayerSettings(auras, talents, sets, stats, items);
+    ReadPlayerSettings(kMessage, player_settings);
+    player_settings.random_seed = static_cast<uint32_t>(kMessage["randomSeed"].ToDouble());
+
+    auto player = Player(player_settings);
+    auto simulation = Simulation(player, kSimulationSettings);
+    auto result_cache = DiskResultCache(cache_directory);
+    if (!cache_directory.empty()) {
+      simulation.result_cache = &result_cache;
+    }
+
+    if (kMessage["itemCandidates"].type == JsonValue::Type::kArray) {
+      std::vector<ItemCandidate> item_candidates;
+
+      for (const auto& kCandidateData : kMessage["itemCandidates"].array) {
+        auto candidate = ItemCandidate();
+        candidate.item_id = kCandidateData["itemId"].ToInt();
+        candidate.meta_gem_id = kCandidateData["metaGemId"].ToInt();
+        candidate.items = ReadItems(kCandidateData["items"]);
+        candidate.sets = ReadSets(kCandidateData["sets"]);
+        candidate.stats = ReadStats(kCandidateData["stats"]);
+        item_candidates.push_back(candidate);
+      }
+
+      simulation.StartAllItems(item_candidates);
+    } else {
+      simulation.Start();
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::cout << "{\"results\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    std::cout << (i > 0 ? ",\n  " : "\n  ") << results[i];
+  }
+  std::cout << "\n],\n\"statWeights\": [";
+  for (size_t i = 0; i < stat_weights.size(); i++) {
+    std::cout << (i > 0 ? ",\n  " : "\n  ") << stat_weights[i];
+  }
+  std::cout << "\n]}" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+// The auras, dots or spells of an entity that are currently active, so that the loops over them at the end of an
+// iteration don't have to go through every registered one and skip the idle ones. T needs an int active_list_index
+// member, which is -1 while it isn't in the list. Adding and removing are constant time, but removing moves the last
+// item into the removed one's place, so the list isn't in the order the items were added in.
+template <typename T>
+struct ActiveList {
+  std::vector<T*> items;
+
+  bool Contains(const T* item) const { return item->active_list_index != -1; }
+
+  void Add(T* item) {
+    if (Contains(item)) {
+      return;
+    }
+
+    item->active_list_index = static_cast<int>(items.size());
+    items.push_back(item);
+  }
+
+  void Remove(T* item) {
+    if (!Contains(item)) {
+      return;
+    }
+
+    T* last_item = items.back();
+    items[item->active_list_index] = last_item;
+    last_item->active_list_index = item->active_list_index;
+    items.pop_back();
+    item->active_list_index = -1;
+  }
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Owns the spells, auras, dots and pet of a Player. They're constructed one after the other in large blocks, so the
+// objects that are set up together also sit together in memory, and everything else refers to them with plain
+// pointers that stay valid until they're all destroyed at once by Reset() or the arena's destructor. Moving the arena
+// doesn't move the blocks, so the pointers survive that too.
+struct Arena {
+  Arena() = default;
+  Arena(const Arena&) = delete;
+  Arena(Arena&& other) = default;
+  Arena& operator=(const Arena&) = delete;
+  Arena& operator=(Arena&&) = delete;
+  ~Arena();
+
+  template <typename T, typename... Args>
+  T* Create(Args&&... args) {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types aren't supported");
+
+    auto object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    destructors.push_back({object, [](void* object) { static_cast<T*>(object)->~T(); }});
+
+    return object;
+  }
+
+  // Destroys the objects in the reverse order of their creation and frees the blocks
+  void Reset();
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> memory;
+    std::size_t size;
+    std::size_t used;
+  };
+
+  struct Destructor {
+    void* object;
+    void (*destroy)(void* object);
+  };
+
+  static constexpr std::size_t kBlockSize = 64 * 1024;
+  std::vector<Block> blocks;
+  std::vector<Destructor> destructors;
+
+  void* Allocate(std::size_t size, std::size_t alignment);
+};
@@ -5,22 +5,30 @@ struct Entity;
 #include <optional>
 #include <vector>
 
+#include "combat_log_policy.h"
+#include "common.h"
 #include "stat.h"
 
 struct Aura {
   Entity& entity;
   std::vector<Stat> stats;
   std::vector<Stat> stats_per_stack;
-  std::string name;
+  SpellId id = SpellId::kNoId;
+  std::string name;          // Only for the combat log and the breakdown, set from the id in Setup()
+  int breakdown_index = -1;  // In entity.combat_log_breakdown
   int duration = 0;
-  double duration_remaining = 0;
+  FightTime expires_at = 0;    // The fight time at which the aura fades
+  int timer = -1;              // In entity.aura_timers, runs out when the aura fades or ticks next
+  int timer_priority = 0;      // Out of the timers that run out at the same time, lower priorities are handled first
   bool active = false;
+  int active_list_index = -1;  // In entity.active_auras
   bool has_duration = true;
-  bool group_wide = false;  // true if it's an aura that applies to everyone in the group
-                            // (will apply to pets as well then)
-  // dots
-  int tick_timer_total = 0;
-  double tick_timer_remaining = 0;
+  bool group_wide = false;     // true if it's an aura that applies to everyone in the group
+                               // (will apply to pets as well then)
+  // Periodic auras (dots and mana over time). Their timer runs out at their ticks instead of when they would fade,
+  // since they fade after their last tick anyway.
+  int tick_timer_total = 0;    // Seconds between ticks, 0 if the aura doesn't tick
+  FightTime next_tick_at = 0;
   int ticks_remaining = 0;
   int ticks_total = 0;
   int stacks = 0;
@@ -32,18 +40,36 @@ struct Aura {
 
   Aura(Entity& entity);
   virtual void Setup();
-  virtual void Tick(double time);
-  virtual void Apply();
-  void Fade();
-  virtual void DecrementStacks();  // ISB
+  template <typename CombatLogPolicy>
+  void Tick(CombatLogPolicy combat_log);
+  // What a periodic aura does on each of its ticks
+  virtual void OnTick(NotWritingCombatLog combat_log);
+  virtual void OnTick(WritingCombatLog combat_log);
+  virtual void Apply(NotWritingCombatLog combat_log);
+  virtual void Apply(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Apply(CombatLogPolicy combat_log);
+  // (Re)starts the aura's duration, or its ticks if it's periodic
+  void StartTimer();
+  template <typename CombatLogPolicy>
+  void Fade(CombatLogPolicy combat_log);
+  // ISB
+  virtual void DecrementStacks(NotWritingCombatLog combat_log);
+  virtual void DecrementStacks(WritingCombatLog combat_log);
 };
 
 struct ImprovedShadowBoltAura : public Aura {
   double modifier;
 
   ImprovedShadowBoltAura(Entity& entity);
-  void Apply();
-  void DecrementStacks();
+  void Apply(NotWritingCombatLog combat_log);
+  void Apply(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Apply(CombatLogPolicy combat_log);
+  void DecrementStacks(NotWritingCombatLog combat_log);
+  void DecrementStacks(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void DecrementStacks(CombatLogPolicy combat_log);
 };
 
 struct CurseOfTheElementsAura : public Aura {
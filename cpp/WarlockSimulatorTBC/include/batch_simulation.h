@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "combat_log_breakdown.h"
+#include "player_settings.h"
+#include "result_cache.h"
+#include "simulation_settings.h"
+
+// Simulates several player configurations on the same random numbers. Iteration i of every configuration is seeded
+// with the same seed and index, so the dps of two configurations can be compared iteration by iteration (common random
+// numbers) which needs a lot fewer iterations than comparing two independent medians.
+struct BatchSimulation {
+  const SimulationSettings& settings;
+  std::vector<std::unique_ptr<PlayerSettings>> configs;
+  std::vector<std::vector<double>> dps;  // dps[config][iteration]
+  std::vector<double> total_fight_durations;
+  // The breakdown rows of each config's player followed by those of its pet, over the iterations Run() simulated. Only
+  // filled when the breakdown is recorded.
+  std::vector<std::vector<CombatLogBreakdown>> breakdowns;
+  std::vector<bool> active;  // Run() skips the configs that aren't active
+  // Run() takes the iterations a config has already been simulated for from here when set, and stores the ones it
+  // simulates
+  ResultCache* result_cache = NULL;
+  std::vector<int> known_iterations;   // The amount of iterations from the first one that each config has dps for
+  std::vector<int> stored_iterations;  // The amount of iterations in each config's result cache entry
+  bool loaded_cached_iterations = false;
+
+  BatchSimulation(const SimulationSettings& simulation_settings);
+  PlayerSettings& AddConfig(const PlayerSettings& player_settings);
+  void LoadCachedIterations();
+  void StoreCachedIterations(int config);
+  // Runs iterations [first_iteration, last_iteration) of every active config, split into (config, chunk of iterations)
+  // tasks that settings.threads workers take from their own queue and steal from each other's once theirs is empty.
+  // The callback is called on the calling thread for every finished chunk of iterations, after its dps values have
+  // been written to `dps`. Chunks whose iterations are all known from the result cache aren't simulated again.
+  void Run(int first_iteration, int last_iteration,
+           const std::function<void(int config, int first_iteration, int last_iteration)>& chunk_done = nullptr);
+};
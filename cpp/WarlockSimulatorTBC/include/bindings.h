@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 
 #include "aura.h"
 #include "auras.h"
@@ -24,17 +25,39 @@ AuraSelection AllocAuras();
 Talents AllocTalents();
 Sets AllocSets();
 CharacterStats AllocStats();
+ItemCandidate AllocItemCandidate();
+std::vector<ItemCandidate> AllocItemCandidates();
 SimulationSettings AllocSimSettings();
 Simulation AllocSim(Player& player, SimulationSettings& simulation_settings);
-std::vector<uint32_t> AllocRandomSeeds(int amount_of_seeds, uint32_t rand_seed = time(NULL));
+
+#ifndef EMSCRIPTEN
+// Lets native programs like the command-line runner handle the results themselves instead of having them printed
+struct NativeCallbacks {
+  std::function<void(double median_dps, double min_dps, double max_dps, int item_id, int iteration_amount,
+                     int effective_iterations, double confidence_interval, int total_fight_duration,
+                     const char* custom_stat, long long simulation_duration)>
+      simulation_results;
+  std::function<void(const char* custom_stat, double dps_difference, double standard_error)> stat_weight_result;
+};
+
+extern NativeCallbacks native_callbacks;
+#endif
 
 void DpsUpdate(double dps);
 void ErrorCallback(const char* error_msg);
-void PostCombatLogBreakdownVector(const char* name, double mana_gain, double damage);
+// The breakdown messages carry the item id and custom stat of the sim they're from, since every sim records one
+void PostCombatLogBreakdownVector(const char* name, double mana_gain, double damage, int item_id,
+                                  const char* custom_stat);
 void PostCombatLogBreakdown(const char* name, uint32_t casts, uint32_t crits, uint32_t misses, uint32_t count,
-                            double uptime, uint32_t dodges, uint32_t glancing_blows);
+                            double uptime, uint32_t dodges, uint32_t glancing_blows, int item_id,
+                            const char* custom_stat);
+// Posts every row of an entity's breakdown
+void SendCombatLogBreakdown(const std::vector<CombatLogBreakdown>& breakdown, int item_id, const char* custom_stat);
 void CombatLogUpdate(const char* combat_log_entry);
 void SimulationUpdate(int iteration, int iteration_amount, double median_dps, int item_id, const char* custom_stat);
+// effective_iterations is 0 when it isn't known
 void SendSimulationResults(double median_dps, double min_dps, double max_dps, int item_id, int iteration_amount,
-                           int total_fight_duration, const char* custom_stat, long long simulation_duration);
+                           int effective_iterations, double confidence_interval, int total_fight_duration,
+                           const char* custom_stat, long long simulation_duration);
+void SendStatWeightResult(const char* custom_stat, double dps_difference, double standard_error);
 std::string GetExceptionMessage(intptr_t exception_ptr);
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// A value that's derived from other stats, such as the spell power after talents and set bonuses, along with the
+// Entity::stats_version it was calculated at. It's only recalculated once the version has moved on.
+template <typename T>
+struct CachedValue {
+  uint64_t version = 0;
+  T value = T();
+
+  template <typename Calculate>
+  T Get(uint64_t stats_version, Calculate calculate) {
+    if (version != stats_version) {
+      value = calculate();
+      version = stats_version;
+    }
+
+    return value;
+  }
+};
+
+using CachedStat = CachedValue<double>;
@@ -17,4 +17,16 @@ struct CombatLogBreakdown {
   double uptime = 0;
 
   CombatLogBreakdown(std::string name) : name(name) {}
+  // Adds the totals of another row of the same spell, aura or mana source
+  void Add(const CombatLogBreakdown& other) {
+    casts += other.casts;
+    crits += other.crits;
+    misses += other.misses;
+    count += other.count;
+    dodge += other.dodge;
+    glancing_blows += other.glancing_blows;
+    iteration_damage += other.iteration_damage;
+    iteration_mana_gain += other.iteration_mana_gain;
+    uptime += other.uptime;
+  }
 };
\ No newline at end of file
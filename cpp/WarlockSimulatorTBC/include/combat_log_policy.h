@@ -0,0 +1,14 @@
+#pragma once
+
+// Whether a fight writes the combat log. Only the fight of the combat log iteration runs the WritingCombatLog
+// instantiations of the code it calls, every other fight runs the NotWritingCombatLog ones, which have the combat log
+// entries and the building of their strings compiled out.
+// The policy is passed along as an (empty) argument, which the templates deduce it from. The virtual functions can't be
+// templates, so they have an overload for each policy instead, which forward to a template with the same name.
+struct NotWritingCombatLog {
+  static constexpr bool kWriting = false;
+};
+
+struct WritingCombatLog {
+  static constexpr bool kWriting = true;
+};
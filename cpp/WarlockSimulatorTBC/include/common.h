@@ -1,7 +1,36 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "enums.h"
+
+// The clock of the event loop counts whole microseconds, so that fight times and timers add up and compare exactly.
+// Durations in seconds (cast times, cooldowns, aura durations) are rounded once, when the timer is set.
+using FightTime = int64_t;
+constexpr FightTime kFightTimePerSecond = 1000000;
+
+// Running mean and variance of a stream of values (Welford's algorithm)
+struct RunningStatistics {
+  int count = 0;
+  double mean = 0;
+  double sum_of_squares = 0;  // Of the differences to the mean
+
+  void Add(double value);
+  // Merges in the values of another one (Chan et al.), the same as adding them one by one up to rounding
+  void Add(const RunningStatistics& other);
+  double Variance() const;  // Of the values
+  double StandardError() const;
+  double ConfidenceInterval() const;
+  // Half the width of the confidence interval of the mean for a quantile of the standard normal distribution
+  double ConfidenceInterval(double z) const;
+};
+
+FightTime SecondsToFightTime(double seconds);
+double FightTimeToSeconds(FightTime fight_time);
+const std::string& SpellIdToName(SpellId id);
 double Median(std::vector<double> vec);
+// The value that the standard normal distribution is below with the given probability
+double StandardNormalQuantile(double probability);
 std::string DoubleToString(double num, int decimal_places = 0);
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+// The damage of a spell or dot tick before it's rolled for crits, along with what went into it for the combat log
+struct ConstantDamage {
+  double base_damage;
+  double damage;
+  double spell_power;
+  double modifier;
+  double partial_resist_multiplier;
+
+  ConstantDamage(double base_damage, double damage, double spell_power, double modifier,
+                 double partial_resist_multiplier)
+      : base_damage(base_damage),
+        damage(damage),
+        spell_power(spell_power),
+        modifier(modifier),
+        partial_resist_multiplier(partial_resist_multiplier) {}
+};
\ No newline at end of file
@@ -5,41 +5,48 @@ struct Spell;
 #include <iostream>
 
 #include "aura.h"
+#include "constant_damage.h"
 #include "enums.h"
+#include "rng.h"
 
-struct DamageOverTime {
+// A dot is a periodic aura on the enemy that snapshots the player's spell power when it's applied and deals damage
+// on its ticks, so it shares the aura's timer, ticks and active state and only adds the damage on top.
+struct DamageOverTime : public Aura {
   Player& player;
-  std::shared_ptr<Spell> parent_spell;
+  Spell* parent_spell = NULL;
   SpellSchool school = SpellSchool::kNoSchool;
-  int duration = 0;                 // Total duration of the dot
   int original_duration = 0;        // Used for T4 4pc since we're increasing the duration
                                     // by 3 seconds but need to know what the original
                                     // duration was
-  int tick_timer_total = 3;         // Total duration of each tick (default is 3 seconds
-                                    // between ticks)
-  double tick_timer_remaining = 0;  // Time until next tick
-  int ticks_remaining = 0;          // Amount of ticks remaining before the dot expires
-  int ticks_total = 0;
   double spell_power = 0;           // Spell Power amount when dot was applied
   double base_damage = 0;
   double coefficient = 0;
   double t5_bonus_modifier = 0;     // T5 4pc damage modifier
-  bool active = false;
   bool applied_with_amplify_curse = false;
   bool isb_is_active = false;       // Siphon Life
-  std::string name;
+  Rng nightfall_rng;                // Corruption's Nightfall rolls on its ticks
+  uint64_t nightfall_threshold = 0;
 
   DamageOverTime(Player& player);
   void Setup();
-  virtual void Apply();
-  void Fade();
-  void Tick(double time);
-  std::vector<double> GetConstantDamage();
+  void Apply(NotWritingCombatLog combat_log);
+  void Apply(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Apply(CombatLogPolicy combat_log);
+  void OnTick(NotWritingCombatLog combat_log);
+  void OnTick(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void OnTick(CombatLogPolicy combat_log);
+  double GetTickTimerRemaining();
+  ConstantDamage GetConstantDamage();
   double PredictDamage();
 };
 
 struct CorruptionDot : public DamageOverTime {
-  void Apply();
+  void Apply(NotWritingCombatLog combat_log);
+  void Apply(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Apply(CombatLogPolicy combat_log);
 
   CorruptionDot(Player& player);
 };
@@ -54,7 +61,10 @@ struct SiphonLifeDot : public DamageOverTime {
 
 struct ImmolateDot : public DamageOverTime {
   ImmolateDot(Player& player);
-  void Apply();
+  void Apply(NotWritingCombatLog combat_log);
+  void Apply(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Apply(CombatLogPolicy combat_log);
 };
 
 struct CurseOfAgonyDot : public DamageOverTime {
@@ -6,8 +6,11 @@ struct Simulation;
 
 #include <map>
 
+#include "active_list.h"
 #include "auras.h"
+#include "cached_stat.h"
 #include "character_stats.h"
+#include "combat_log_policy.h"
 #include "combat_log_breakdown.h"
 #include "enums.h"
 #include "on_crit_proc.h"
@@ -17,10 +20,9 @@ struct Simulation;
 #include "on_resist_proc.h"
 #include "player_settings.h"
 #include "spells.h"
+#include "timer_queue.h"
 
 struct Entity {
-  const int kFloatNumberMultiplier = 1000;  // Multiply doubles such as hit and crit chance with this since we need an
-                                            // integer when calling player.rng.range()
   const int kLevel = 70;
   const double kGcdValue = 1.5;
   const double kMinimumGcdValue = 1;
@@ -30,46 +32,60 @@ struct Entity {
   PlayerSettings& settings;
   Auras auras = Auras();
   Spells spells = Spells();
-  std::shared_ptr<Pet> pet;
+  Pet* pet = NULL;
   CharacterStats stats;
   EntityType entity_type;
   std::string name;
-  std::map<std::string, std::unique_ptr<CombatLogBreakdown>> combat_log_breakdown;
+  // One row per spell, aura or mana source, which hold the index of theirs. Only filled when recording the breakdown.
+  std::vector<CombatLogBreakdown> combat_log_breakdown;
   std::vector<Aura*> aura_list;
   std::vector<Spell*> spell_list;
-  std::vector<DamageOverTime*> dot_list;
   std::vector<OnHitProc*> on_hit_procs;
   std::vector<OnCritProc*> on_crit_procs;
   std::vector<OnDotTickProc*> on_dot_tick_procs;
   std::vector<OnDamageProc*> on_damage_procs;
   std::vector<OnResistProc*> on_resist_procs;
-  double cast_time_remaining = 0;
-  double gcd_remaining = 0;
-  double five_second_rule_timer_remaining = 5;
-  double mp5_timer_remaining = 5;
+  // The timers of the auras (dots included) and spell cooldowns, with the same ids as their index in the lists above
+  TimerQueue aura_timers;
+  TimerQueue spell_timers;
+  Spell* casting_spell = NULL;  // Cast when cast_time_remaining runs out
+  // The auras that are active, and the spells that have been cast or put on cooldown since the last Reset()
+  ActiveList<Aura> active_auras;
+  ActiveList<Spell> active_spells;
+  FightTime cast_time_remaining = 0;
+  FightTime gcd_remaining = 0;
+  FightTime five_second_rule_timer_remaining = 5 * kFightTimePerSecond;
+  FightTime mp5_timer_remaining = 5 * kFightTimePerSecond;
   bool recording_combat_log_breakdown;
   bool equipped_item_simulation;
   bool infinite_mana;
   int enemy_shadow_resist;  // TODO move these to an Enemy struct
   int enemy_fire_resist;
+  int enemy_armor;
   int enemy_level_difference_resistance;
+  // Bumped whenever something that the cached derived stats depend on changes, i.e. a stat, an aura or its stacks.
+  // The player's and the pet's derived stats depend on each other's stats, so it's bumped for both.
+  uint64_t stats_version = 1;
 
   Entity(Player* player, PlayerSettings& player_settings, EntityType entity_type);
   virtual double GetIntellect();
   virtual double GetStamina();
   virtual double GetHastePercent() = 0;
-  virtual double FindTimeUntilNextAction();
-  virtual void Tick(double time);
-  virtual void EndAuras();
+  virtual FightTime FindTimeUntilNextAction();
+  FightTime FindTimeUntilNextTimer(const TimerQueue& timer_queue);
+  virtual void Tick(NotWritingCombatLog combat_log, FightTime time);
+  virtual void Tick(WritingCombatLog combat_log, FightTime time);
+  template <typename CombatLogPolicy>
+  void Tick(CombatLogPolicy combat_log, FightTime time);
+  virtual void EndAuras(NotWritingCombatLog combat_log);
+  virtual void EndAuras(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void EndAuras(CombatLogPolicy combat_log);
   virtual void Reset();
   virtual void Initialize(Simulation* simulation);
   virtual double GetSpellPower(bool dealing_damage, SpellSchool spell_school) = 0;
   virtual double GetSpellCritChance(SpellType spell_type = SpellType::kNoSpellType) = 0;
   virtual double GetDamageModifier(Spell& spell, bool is_dot) = 0;
-  virtual bool IsSpellCrit(SpellType spell_type, double extra_crit = 0);
-  virtual bool IsMeleeCrit();
-  virtual bool IsSpellHit(SpellType spell_type);
-  virtual bool IsMeleeHit();
   double GetMultiplicativeDamageModifier(Spell& spell, bool is_dot);
   double GetPartialResistMultiplier(SpellSchool school);
   double GetSpirit();
@@ -78,8 +94,10 @@ struct Entity {
   double GetCustomImprovedShadowBoltDamageModifier();
   double GetGcdValue();
   double GetBaseSpellHitChance(int entity_level, int enemy_level);
-  void PostIterationDamageAndMana(const std::string& spell_name);
-  void SendCombatLogBreakdown();
+  void InvalidateDerivedStats();
+  // Returns the index of the breakdown row with that name, adding the row if there isn't one yet
+  int AddCombatLogBreakdownRow(const std::string& name);
+  // Moves the breakdown totals into `totals` and zeroes the rows
+  void TakeCombatLogBreakdown(std::vector<CombatLogBreakdown>& totals);
   void CombatLog(const std::string& entry);
-  bool ShouldWriteToCombatLog();
 };
\ No newline at end of file
@@ -18,6 +18,8 @@ enum class SimulationType { kNormal, kAllItems, kStatWeights };
 
 enum class CalculationType { kNoType, kAdditive, kMultiplicative };
 
+enum class StatAction { kAdd, kRemove };
+
 enum class EntityType { kNoType, kPlayer, kPet };
 
 namespace PetNameStr {
@@ -26,6 +28,79 @@ const std::string kSuccubus = "Succubus";
 const std::string kFelguard = "Felguard";
 }  // namespace PetNameStr
 
+// Identifies every spell, aura and dot, so that the simulation compares these instead of their names. The names
+// below are only looked up for the combat log and the breakdown, with SpellIdToName().
+enum class SpellId {
+  kNoId,
+  kShadowBolt,
+  kLifeTap,
+  kIncinerate,
+  kSearingPain,
+  kCorruption,
+  kImmolate,
+  kUnstableAffliction,
+  kSiphonLife,
+  kCurseOfDoom,
+  kCurseOfAgony,
+  kCurseOfTheElements,
+  kCurseOfRecklessness,
+  kSoulFire,
+  kShadowburn,
+  kDeathCoil,
+  kShadowfury,
+  kSeedOfCorruption,
+  kConflagrate,
+  kDestructionPotion,
+  kFlameCap,
+  kBloodFury,
+  kBloodlust,
+  kDrumsOfBattle,
+  kDrumsOfWar,
+  kDrumsOfRestoration,
+  kTimbalsFocusingCrystal,
+  kMarkOfDefiance,
+  kTheLightningCapacitor,
+  kBladeOfWizardry,
+  kShatteredSunPendantOfAcumenAldor,
+  kShatteredSunPendantOfAcumenScryers,
+  kRobeOfTheElderScribes,
+  kQuagmirransEye,
+  kShiffarsNexusHorn,
+  kSextantOfUnstableCurrents,
+  kBandOfTheEternalSage,
+  kMysticalSkyfireDiamond,
+  kInsightfulEarthstormDiamond,
+  kAmplifyCurse,
+  kPowerInfusion,
+  kInnervate,
+  kChippedPowerCore,
+  kCrackedPowerCore,
+  kNightfall,
+  kManaTideTotem,
+  kJudgementOfWisdom,
+  kFlameshadow,
+  kShadowflame,
+  kSpellstrike,
+  kManaEtched4Set,
+  kAshtongueTalismanOfShadows,
+  kWrathOfCenarius,
+  kDarkmoonCardCrusade,
+  kDarkPact,
+  kSuperManaPotion,
+  kDemonicRune,
+  kFirebolt,
+  kDemonicFrenzy,
+  kLashOfPain,
+  kMelee,
+  kCleave,
+  kBlackBook,
+  kBattleSquawk,
+  kImprovedShadowBolt,
+  kEyeOfMagtheridon,
+  kAirmansRibbonOfGallantry,
+  kFelEnergy
+};
+
 namespace SpellName {
 const std::string kShadowBolt = "Shadow Bolt";
 const std::string kLifeTap = "Life Tap";
@@ -113,6 +188,7 @@ const std::string kAttackPowerModifier = "Attack Power Modifier";
 
 namespace StatConstant {
 const double kHitRatingPerPercent = 12.62;
+const double kHitPercentCap = 16;
 const double kCritRatingPerPercent = 22.08;
 const double kHasteRatingPerPercent = 15.77;
 const double kManaPerIntellect = 15;
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "character_stats.h"
+#include "items.h"
+#include "sets.h"
+
+// The parts of the player's settings that change when an item is equipped, for simulating every item of a slot in
+// one batch. The stats are the player's stats with the item equipped, and the items, sets and meta gem also include
+// the item so that its special effects (trinkets, rings, meta gems, set bonuses) are simulated.
+struct ItemCandidate {
+  int item_id = 0;
+  int meta_gem_id = 0;
+  Items items;
+  Sets sets;
+  CharacterStats stats;
+};
@@ -8,7 +8,10 @@ struct LifeTap : public Spell {
 
   LifeTap(Entity& entity);
   double ManaGain();
-  void Cast();
+  void Cast(NotWritingCombatLog combat_log);
+  void Cast(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Cast(CombatLogPolicy combat_log);
 };
 
 struct DarkPact : public LifeTap {
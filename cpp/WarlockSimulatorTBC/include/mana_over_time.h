@@ -4,9 +4,10 @@
 
 struct ManaOverTime : public Aura {
   ManaOverTime(Entity& Entity);
-  void Apply();
-  void Tick(double time);
-  void Setup();
+  void OnTick(NotWritingCombatLog combat_log);
+  void OnTick(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void OnTick(CombatLogPolicy combat_log);
   virtual double GetManaGain() = 0;
 };
 
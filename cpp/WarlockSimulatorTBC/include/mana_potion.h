@@ -4,7 +4,10 @@
 
 struct ManaPotion : public Spell {
   ManaPotion(Player& player);
-  void Cast();
+  void Cast(NotWritingCombatLog combat_log);
+  void Cast(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Cast(CombatLogPolicy combat_log);
 };
 
 struct SuperManaPotion : public ManaPotion {
@@ -13,5 +16,8 @@ struct SuperManaPotion : public ManaPotion {
 
 struct DemonicRune : public ManaPotion {
   DemonicRune(Player& player);
-  void Cast();
+  void Cast(NotWritingCombatLog combat_log);
+  void Cast(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Cast(CombatLogPolicy combat_log);
 };
\ No newline at end of file
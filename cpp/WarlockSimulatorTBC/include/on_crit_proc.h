@@ -3,24 +3,27 @@
 #include "spell_proc.h"
 
 struct OnCritProc : public SpellProc {
-  OnCritProc(Player& player, std::shared_ptr<Aura> aura = nullptr);
+  OnCritProc(Player& player, Aura* aura = nullptr);
   void Setup();
 };
 
 struct ImprovedShadowBolt : public OnCritProc {
-  ImprovedShadowBolt(Player& player, std::shared_ptr<Aura> aura);
+  ImprovedShadowBolt(Player& player, Aura* aura);
   bool ShouldProc(Spell* spell);
 };
 
 struct TheLightningCapacitor : public OnCritProc {
   TheLightningCapacitor(Player& player);
-  void StartCast(double predicted_damage = 0);
+  void StartCast(NotWritingCombatLog combat_log, double predicted_damage = 0);
+  void StartCast(WritingCombatLog combat_log, double predicted_damage = 0);
+  template <typename CombatLogPolicy>
+  void StartCast(CombatLogPolicy combat_log);
 };
 
 struct ShiffarsNexusHorn : public OnCritProc {
-  ShiffarsNexusHorn(Player& player, std::shared_ptr<Aura> aura);
+  ShiffarsNexusHorn(Player& player, Aura* aura);
 };
 
 struct SextantOfUnstableCurrents : public OnCritProc {
-  SextantOfUnstableCurrents(Player& player, std::shared_ptr<Aura> aura);
+  SextantOfUnstableCurrents(Player& player, Aura* aura);
 };
\ No newline at end of file
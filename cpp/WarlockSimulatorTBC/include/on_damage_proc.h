@@ -3,12 +3,12 @@
 #include "spell_proc.h"
 
 struct OnDamageProc : public SpellProc {
-  OnDamageProc(Player& player, std::shared_ptr<Aura> aura = nullptr);
+  OnDamageProc(Player& player, Aura* aura = nullptr);
   void Setup();
 };
 
 struct ShatteredSunPendantOfAcumenAldor : public OnDamageProc {
-  ShatteredSunPendantOfAcumenAldor(Player& player, std::shared_ptr<Aura> aura);
+  ShatteredSunPendantOfAcumenAldor(Player& player, Aura* aura);
 };
 
 struct ShatteredSunPendantOfAcumenScryers : public OnDamageProc {
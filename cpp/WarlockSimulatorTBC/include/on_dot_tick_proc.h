@@ -3,13 +3,13 @@
 #include "spell_proc.h"
 
 struct OnDotTickProc : public SpellProc {
-  OnDotTickProc(Player& player, std::shared_ptr<Aura> aura = nullptr);
+  OnDotTickProc(Player& player, Aura* aura = nullptr);
   void Setup();
   virtual bool ShouldProc(DamageOverTime* spell);
 };
 
 struct AshtongueTalismanOfShadows : public OnDotTickProc {
-  AshtongueTalismanOfShadows(Player& player, std::shared_ptr<Aura> aura);
+  AshtongueTalismanOfShadows(Player& player, Aura* aura);
   bool ShouldProc(DamageOverTime* spell);
 };
 
@@ -3,7 +3,7 @@
 #include "spell_proc.h"
 
 struct OnHitProc : public SpellProc {
-  OnHitProc(Entity& entity, std::shared_ptr<Aura> aura = nullptr);
+  OnHitProc(Entity& entity, Aura* aura = nullptr);
   void Setup();
 };
 
@@ -12,7 +12,7 @@ struct MarkOfDefiance : public OnHitProc {
 };
 
 struct BladeOfWizardry : public OnHitProc {
-  BladeOfWizardry(Entity& entity, std::shared_ptr<Aura> aura);
+  BladeOfWizardry(Entity& entity, Aura* aura);
 };
 
 struct InsightfulEarthstormDiamond : public OnHitProc {
@@ -20,19 +20,19 @@ struct InsightfulEarthstormDiamond : public OnHitProc {
 };
 
 struct RobeOfTheElderScribes : public OnHitProc {
-  RobeOfTheElderScribes(Entity& entity, std::shared_ptr<Aura> aura);
+  RobeOfTheElderScribes(Entity& entity, Aura* aura);
 };
 
 struct QuagmirransEye : public OnHitProc {
-  QuagmirransEye(Entity& entity, std::shared_ptr<Aura> aura);
+  QuagmirransEye(Entity& entity, Aura* aura);
 };
 
 struct BandOfTheEternalSage : public OnHitProc {
-  BandOfTheEternalSage(Entity& entity, std::shared_ptr<Aura> aura);
+  BandOfTheEternalSage(Entity& entity, Aura* aura);
 };
 
 struct MysticalSkyfireDiamond : public OnHitProc {
-  MysticalSkyfireDiamond(Entity& entity, std::shared_ptr<Aura> aura);
+  MysticalSkyfireDiamond(Entity& entity, Aura* aura);
 };
 
 struct JudgementOfWisdom : public OnHitProc {
@@ -40,31 +40,31 @@ struct JudgementOfWisdom : public OnHitProc {
 };
 
 struct Flameshadow : public OnHitProc {
-  Flameshadow(Entity& entity, std::shared_ptr<Aura> aura);
+  Flameshadow(Entity& entity, Aura* aura);
   bool ShouldProc(Spell* spell);
 };
 
 struct Shadowflame : public OnHitProc {
-  Shadowflame(Entity& entity, std::shared_ptr<Aura> aura);
+  Shadowflame(Entity& entity, Aura* aura);
   bool ShouldProc(Spell* spell);
 };
 
 struct Spellstrike : public OnHitProc {
-  Spellstrike(Entity& entity, std::shared_ptr<Aura> aura);
+  Spellstrike(Entity& entity, Aura* aura);
 };
 
 struct ManaEtched4Set : public OnHitProc {
-  ManaEtched4Set(Entity& entity, std::shared_ptr<Aura> aura);
+  ManaEtched4Set(Entity& entity, Aura* aura);
 };
 
 struct WrathOfCenarius : public OnHitProc {
-  WrathOfCenarius(Entity& entity, std::shared_ptr<Aura> aura);
+  WrathOfCenarius(Entity& entity, Aura* aura);
 };
 
 struct DarkmoonCardCrusade : public OnHitProc {
-  DarkmoonCardCrusade(Entity& entity, std::shared_ptr<Aura> aura);
+  DarkmoonCardCrusade(Entity& entity, Aura* aura);
 };
 
 struct DemonicFrenzy : public OnHitProc {
-  DemonicFrenzy(Entity& entity, std::shared_ptr<Aura> aura);
+  DemonicFrenzy(Entity& entity, Aura* aura);
 };
\ No newline at end of file
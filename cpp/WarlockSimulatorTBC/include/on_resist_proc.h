@@ -3,10 +3,10 @@
 #include "spell_proc.h"
 
 struct OnResistProc : public SpellProc {
-  OnResistProc(Player& player, std::shared_ptr<Aura> aura = nullptr);
+  OnResistProc(Player& player, Aura* aura = nullptr);
   void Setup();
 };
 
 struct EyeOfMagtheridon : public OnResistProc {
-  EyeOfMagtheridon(Player& player, std::shared_ptr<Aura> aura);
+  EyeOfMagtheridon(Player& player, Aura* aura);
 };
\ No newline at end of file
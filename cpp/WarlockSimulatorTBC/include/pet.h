@@ -9,20 +9,26 @@ struct Player;
 #include "enums.h"
 #include "simulation.h"
 
-struct Pet : public Entity, std::enable_shared_from_this<Pet> {
+struct Pet : public Entity {
   const double kBaseMeleeSpeed = 2;
   PetName pet_name = PetName::kNoName;
   PetType pet_type = PetType::kNoPetType;
   double glancing_blow_multiplier;
   double glancing_blow_chance;
   double enemy_damage_reduction_from_armor = 0;
+  CachedStat cached_attack_power;
+  CachedStat cached_spell_power;
+  CachedStat cached_spell_crit_chance;
 
   Pet(Player& player, EmbindConstant selected_pet);
   void Initialize(Simulation* simulation);
   void CalculateStatsFromAuras();
   void Setup();
   void Reset();
-  void Tick(double t);
+  void Tick(NotWritingCombatLog combat_log, FightTime t);
+  void Tick(WritingCombatLog combat_log, FightTime t);
+  template <typename CombatLogPolicy>
+  void Tick(CombatLogPolicy combat_log, FightTime t);
   double GetAttackPower();
   double GetHastePercent();
   double GetSpellCritChance(SpellType spell_type = SpellType::kNoSpellType);
@@ -37,4 +43,7 @@ struct Pet : public Entity, std::enable_shared_from_this<Pet> {
   double GetDamageModifier(Spell& spell, bool is_dot);
   bool isMeleeCrit();
   bool IsHit(AttackType type);
+
+ private:
+  double CalculateAttackPower();
 };
\ No newline at end of file
@@ -2,8 +2,10 @@
 
 #include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
+#include "arena.h"
 #include "aura.h"
 #include "aura_selection.h"
 #include "character_stats.h"
@@ -24,37 +26,58 @@
 #include "trinket.h"
 
 struct Player : public Entity {
+  Arena arena;  // Owns the player's and the pet's spells, auras and dots, and the pet
   AuraSelection& selected_auras;
   Talents& talents;
   Sets& sets;
   Items& items;
   PlayerSettings& settings;
   std::vector<Trinket> trinkets;
-  std::shared_ptr<Spell> filler;
-  std::shared_ptr<Spell> curse_spell;
-  std::shared_ptr<Aura> curse_aura;
+  TimerQueue trinket_timers;
+  Spell* filler = NULL;
+  Spell* curse_spell = NULL;
+  Aura* curse_aura = NULL;
   std::vector<std::string> combat_log_entries;
   std::string custom_stat;
-  Rng rng;
+  Rng rng;                        // Only rolls the fight length
+  std::vector<Rng*> rng_streams;  // Of the player's and the pet's spells and dots
+  // How many streams there are of each entity type, spell id and roll type, which numbers the instances of a spell
+  std::map<std::tuple<EntityType, SpellId, RollType>, int> rng_stream_instances;
   double total_fight_duration;
   double iteration_damage;
   int power_infusions_ready;
+  int mp5_breakdown_index = -1;  // In combat_log_breakdown
+  CachedStat cached_haste_percent;
+  CachedStat cached_spell_power[2][3];  // By whether the player is dealing damage and by SpellSchool
+  CachedStat cached_spell_crit_chance;  // Before Devastation is taken off of non-destruction spells
 
   Player(PlayerSettings& settings);
   void Initialize(Simulation* simulation);
   void Reset();
-  void EndAuras();
+  void EndAuras(NotWritingCombatLog combat_log);
+  void EndAuras(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void EndAuras(CombatLogPolicy combat_log);
   void ThrowError(const std::string& error);
-  void CastLifeTapOrDarkPact();
-  void UseCooldowns(double fight_time_remaining);
+  template <typename CombatLogPolicy>
+  void CastLifeTapOrDarkPact(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void UseCooldowns(CombatLogPolicy combat_log, double fight_time_remaining);
   void SendCombatLogEntries();
   void SendPlayerInfoToCombatLog();
-  void Tick(double time);
+  void Tick(NotWritingCombatLog combat_log, FightTime time);
+  void Tick(WritingCombatLog combat_log, FightTime time);
+  template <typename CombatLogPolicy>
+  void Tick(CombatLogPolicy combat_log, FightTime time);
   double GetSpellPower(bool dealing_damage, SpellSchool school = SpellSchool::kNoSchool);
   double GetHastePercent();
   double GetSpellCritChance(SpellType spell_type);
-  double FindTimeUntilNextAction();
+  FightTime FindTimeUntilNextAction();
   double GetDamageModifier(Spell& spell, bool is_dot);
-  int GetRand();
-  bool RollRng(double chance);
+  void AddRngStream(Rng& rng, EntityType entity_type, SpellId spell_id, RollType roll_type);
+  void SeedRngStreams(int iteration, bool mirrored);
+
+ private:
+  double CalculateSpellPower(bool dealing_damage, SpellSchool school);
+  double CalculateHastePercent();
 };
\ No newline at end of file
@@ -1,18 +1,18 @@
 #pragma once
 
 #include "aura_selection.h"
+#include "character_stats.h"
 #include "embind_constant.h"
 #include "items.h"
 #include "sets.h"
 #include "talents.h"
-#include <vector>
 
 struct PlayerSettings {
   AuraSelection& auras;
   Talents& talents;
-  Sets& sets;
+  Sets sets;
   CharacterStats stats;
-  Items& items;
+  Items items;
   EmbindConstant custom_stat = EmbindConstant::kUnused;
   EmbindConstant shattrath_faction = EmbindConstant::kUnused;
   EmbindConstant selected_pet = EmbindConstant::kUnused;
@@ -21,7 +21,7 @@ struct PlayerSettings {
   EmbindConstant lash_of_pain_usage = EmbindConstant::kUnused;
   EmbindConstant pet_mode = EmbindConstant::kUnused;
   EmbindConstant rotation_option = EmbindConstant::kUnused;
-  std::vector<uint32_t> random_seeds;
+  uint32_t random_seed = 0;  // Seeds the rng of every iteration together with the iteration's index
   int item_id = 0;
   int meta_gem_id = 0;
   bool equipped_item_simulation = false;
@@ -0,0 +1,18 @@
+#pragma once
+
+// Estimates a quantile of a stream of values with the P² algorithm (Jain & Chlamtac) in constant time and memory per
+// value, by keeping five markers whose heights approximate the minimum, the quantile, the maximum and the two
+// quantiles halfway between them. Used for the median in the progress updates instead of sorting every dps value.
+struct QuantileEstimator {
+  double quantile;
+  int count = 0;
+  double heights[5];
+  double positions[5];
+  double desired_positions[5];
+  double desired_position_increments[5];
+
+  QuantileEstimator(double quantile = 0.5);
+  void Add(double value);
+  // Exact as long as there are five values or less
+  double Value() const;
+};
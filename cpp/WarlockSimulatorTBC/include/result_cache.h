@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "player_settings.h"
+#include "simulation_settings.h"
+
+// Bump this whenever a change to the simulation changes the dps it simulates, so that old cache entries aren't reused
+constexpr uint32_t kResultCacheVersion = 7;
+
+// The dps of the first iterations a configuration was simulated for
+struct CachedIterations {
+  std::vector<double> dps;
+};
+
+// Lets a sim reuse the iterations that an identical configuration has been simulated for before and only simulate the
+// ones it doesn't have yet. Where the entries are kept is up to the caller (the native runner keeps them on disk).
+// load returns false when there's no entry with that key.
+struct ResultCache {
+  std::function<bool(uint64_t key, CachedIterations& iterations)> load;
+  std::function<void(uint64_t key, const CachedIterations& iterations)> store;
+};
+
+// Hash of everything that changes the dps of an iteration: the player's settings, auras, talents, sets, items and
+// stats, the fight length range and the random seed. An iteration's random numbers only depend on the seed and the
+// iteration's index, so the iteration amount, thread amount and the settings that only decide when a sim stops are left
+// out and a cached run can be reused by a sim with more or fewer iterations. The item id and custom stat are only
+// labels and are left out too.
+uint64_t ConfigHash(const PlayerSettings& player_settings, const SimulationSettings& simulation_settings);
@@ -1,13 +1,53 @@
 #pragma once
 
-#include <random>
+#include <cstdint>
 
+#include "enums.h"
+
+// What the numbers of a stream are rolled for
+enum class RollType { kHit, kCrit, kAmount, kProc };
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"), a counter-based generator: the
+// numbers are a keyed hash of a counter instead of the next step of a large state. The key is the sim's random seed
+// and the counter holds the iteration and the stream, so the stream of any iteration starts directly from those,
+// without a seed per iteration and without generating the numbers of the iterations before it.
+//
+// Every spell and dot rolls each RollType on a stream of its own, so a roll that one configuration makes and another
+// doesn't (a trinket's proc, a spell that's only cast in one of them) doesn't shift the numbers of any other roll and
+// the iterations of two configurations stay paired roll by roll.
 struct Rng {
-  void seed(uint32_t s);
-  double next();
+  // Makes this the stream of the rolls of that type of a spell or dot, which is identified by its entity's type, its
+  // id and which instance with that id it is (e.g. the second Bloodlust), not by its display name that several of
+  // them can share. Stream 0, which is used until then, is the fight length's.
+  void SetStream(EntityType entity_type, SpellId spell_id, int instance, RollType roll_type);
+  // Starts the stream of the iteration. The mirrored stream has every number n of the normal one turned into
+  // 2^32 - 1 - n, the antithetic twin of the iteration: a roll that succeeds on one of them is as likely to fail on the
+  // other as the chance allows, and range() picks from the opposite end of the range.
+  void seed(uint32_t random_seed, uint32_t iteration, bool mirrored = false);
   int range(int min, int max);
 
+  // The threshold that Roll() compares against for a roll that succeeds with the chance in percent. A chance of 0 or
+  // less never succeeds and one of 100 or more always does.
+  static uint64_t ChanceThreshold(double chance);
+  // A chance roll as a single integer compare, with the threshold calculated once for as long as the chance stays the
+  // same instead of turning every number into a double
+  bool Roll(uint64_t threshold) { return NextUint32() < threshold; }
+
+  uint32_t NextUint32() {
+    if (block_index == 4) {
+      GenerateBlock();
+    }
+
+    return block[block_index++] ^ mirror_mask;
+  }
+
  private:
-  std::mt19937 _random_engine;
-  std::uniform_real_distribution<double> _random{0, 1};
-};
\ No newline at end of file
+  uint32_t stream = 0;
+  uint32_t key[2] = {0, 0};
+  uint32_t counter[4] = {0, 0, 0, 0};  // The number of the next block, the iteration and the stream
+  uint32_t block[4] = {0, 0, 0, 0};
+  int block_index = 4;      // Of the next number in the block, 4 when it's used up
+  uint32_t mirror_mask = 0;  // All ones on a mirrored stream
+
+  void GenerateBlock();
+};
@@ -1,30 +1,74 @@
 #pragma once
 
+#include "common.h"
+#include "item_candidate.h"
 #include "player.h"
+#include "quantile_estimator.h"
+#include "result_cache.h"
+#include "rng.h"
 #include "simulation_settings.h"
 
 struct Simulation {
+  const int kCombatLogIteration = 10;  // The iteration that the combat log is written for
   Player& player;
   const SimulationSettings& settings;
   std::vector<double> dps_vector;
+  QuantileEstimator median_estimator;  // Of the dps values so far, for the progress updates
+  RunningStatistics dps_statistics;
+  // Of half the difference between the dps of an iteration's fight and of its antithetic twin's, which together with
+  // dps_statistics gives the variance of a single fight. Empty when the twins aren't simulated, and the iterations
+  // from the result cache aren't in it since only their dps is cached.
+  RunningStatistics twin_differences;
   int iteration = 0;
-  double current_fight_time = 0;
-  double min_dps = 0;
+  FightTime current_fight_time = 0;
+  double min_dps = 0;  // Of the iterations, so of the pair averages in antithetic mode
   double max_dps = 0;
+  bool sending_progress_updates = true;
+  bool keeping_dps_values = true;
+  ResultCache* result_cache = NULL;  // Reuses and stores the dps of the iterations when set
+  // The spells that CastGcdSpells() picks the best one out of, with their predicted damage. Kept between GCDs so that
+  // it doesn't allocate every time.
+  std::vector<std::pair<Spell*, double>> predicted_damage_of_spells;
 
   Simulation(Player& player, const SimulationSettings& sim_settings);
   void Start();
-  void IterationReset(double fight_length);
-  void CastNonPlayerCooldowns(double fight_time_remaining);
-  void CastNonGcdSpells();
-  void CastGcdSpells(double fight_time_remaining);
-  void CastPetSpells();
-  void IterationEnd(double fight_length, double dps);
+  void RunIterations(int first_iteration, int last_iteration);
+  void RunIteration(RunningStatistics& block_twin_differences);
+  template <typename CombatLogPolicy>
+  int RunFight(CombatLogPolicy combat_log, bool mirrored);
+  void SetRecordingCombatLogBreakdown(bool recording_combat_log_breakdown);
+  void RunIterationsUntilConverged(int first_iteration);
+  bool HasConverged() const;
+  void RunIterationsInParallel(int first_iteration);
+  int LoadCachedIterations(int& stored_iterations);
+  void StoreCachedIterations(int stored_iterations);
+  void StartStatWeights();
+  void StartAllItems(const std::vector<ItemCandidate>& item_candidates);
+  template <typename CombatLogPolicy>
+  void IterationReset(CombatLogPolicy combat_log, double fight_length);
+  template <typename CombatLogPolicy>
+  void CastNonPlayerCooldowns(CombatLogPolicy combat_log, double fight_time_remaining);
+  template <typename CombatLogPolicy>
+  void CastNonGcdSpells(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void CastGcdSpells(CombatLogPolicy combat_log, double fight_time_remaining);
+  template <typename CombatLogPolicy>
+  void CastPetSpells(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void IterationEnd(CombatLogPolicy combat_log);
+  void AddIterationResult(double fight_length, double dps);
+  double EffectiveIterations() const;
   void SimulationEnd(long long simulation_duration);
-  double PassTime();
-  void Tick(double time);
-  void SelectedSpellHandler(const std::shared_ptr<Spell>& spell,
-                            std::map<std::shared_ptr<Spell>, double>& predicted_damage_of_spells,
-                            double fight_time_remaining);
-  void CastSelectedSpell(const std::shared_ptr<Spell>& spell, double fight_time_remaining, double predicted_damage = 0);
+  template <typename CombatLogPolicy>
+  FightTime PassTime(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void Tick(CombatLogPolicy combat_log, FightTime time);
+  template <typename CombatLogPolicy>
+  void SelectedSpellHandler(CombatLogPolicy combat_log, Spell* spell, double fight_time_remaining);
+  bool IsDamagePredicted(Spell* spell) const;
+  template <typename CombatLogPolicy>
+  void CastSelectedSpell(CombatLogPolicy combat_log, Spell* spell, double fight_time_remaining,
+                         double predicted_damage = 0);
+  static int RollFightLength(Rng& rng, uint32_t random_seed, int iteration, const SimulationSettings& settings,
+                             bool mirrored = false);
 };
\ No newline at end of file
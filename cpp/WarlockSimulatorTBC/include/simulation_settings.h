@@ -9,4 +9,20 @@ struct SimulationSettings {
   int min_time;
   int max_time;
   SimulationType simulation_type;
+  int threads;  // Native parallel mode when > 1, otherwise the iterations run serially on the calling thread
+  int stat_weight_increase;  // How much of each stat is added to the player in stat weight sims
+  // Serial normal sims don't keep every iteration's dps and report the streaming median estimate instead of the exact
+  // median, so that memory doesn't grow with the iteration amount
+  bool approximate_median;
+  // Adaptive mode when > 0: the sim stops once the standard error of the mean dps is at most this (in dps, or as a
+  // fraction of the mean dps if relative_standard_error is set) and at least min_iterations have been simulated.
+  // `iterations` is then the maximum amount of iterations.
+  double target_standard_error;
+  bool relative_standard_error;
+  int min_iterations;
+  bool racing;  // All-items sims stop simulating the items that are clearly worse than the best one
+  // Every iteration is simulated a second time on the mirrored random numbers (antithetic variates) and counts as the
+  // average of the two fights. The min and max dps and the dps histogram are then of these pair averages, not of single
+  // fights.
+  bool antithetic_variates;
 };
\ No newline at end of file
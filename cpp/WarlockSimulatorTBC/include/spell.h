@@ -3,30 +3,37 @@
 struct Entity;
 
 #include "aura.h"
+#include "cached_stat.h"
+#include "combat_log_policy.h"
+#include "constant_damage.h"
 #include "damage_over_time.h"
 #include "enums.h"
+#include "rng.h"
 #include "spell_cast_result.h"
 
 struct Spell {
   Entity& entity;
-  std::shared_ptr<Aura> aura_effect;
-  std::shared_ptr<DamageOverTime> dot_effect;
-  std::vector<std::string> shared_cooldown_spells;
+  Aura* aura_effect = NULL;
+  DamageOverTime* dot_effect = NULL;
+  std::vector<SpellId> shared_cooldown_spells;
   SpellSchool spell_school = SpellSchool::kNoSchool;
   AttackType attack_type = AttackType::kNoAttackType;
   SpellType spell_type = SpellType::kNoSpellType;
-  std::string name;
+  SpellId id = SpellId::kNoId;
+  std::string name;          // Only for the combat log and the breakdown, set from the id in Setup()
+  int breakdown_index = -1;  // In entity.combat_log_breakdown
   int min_dmg = 0;
   int max_dmg = 0;
   double base_damage = 0;
-  bool casting = false;
   bool can_crit = false;
   bool on_gcd = true;
   bool is_proc = false;
   bool limited_amount_of_casts = false;
   bool is_non_warlock_ability = false;
   double coefficient = 0;
-  double cooldown_remaining = 0;
+  FightTime ready_at = 0;      // The fight time at which the cooldown runs out
+  int cooldown_timer = -1;     // In entity.spell_timers
+  int active_list_index = -1;  // In entity.active_spells
   double cast_time = 0;
   double cooldown = 0;
   double mana_cost = 0;
@@ -55,42 +62,76 @@ struct Spell {
   bool on_damage_procs_enabled = true;
   bool procs_on_resist = false;
   bool on_resist_procs_enabled = true;
-
-  Spell(Entity& entity, std::shared_ptr<Aura> aura = nullptr, std::shared_ptr<DamageOverTime> dot = nullptr);
+  Rng hit_rng;     // The hit rolls, and the attack table rolls of physical spells
+  Rng crit_rng;    // The crit rolls of magical spells
+  Rng amount_rng;  // The damage and mana gain rolls within their range
+  Rng proc_rng;    // The proc chance rolls when the spell is a proc
+  CachedValue<uint64_t> hit_threshold;   // Of the spell hit chance, at entity.stats_version
+  CachedValue<uint64_t> crit_threshold;  // Of the spell crit chance with bonus_crit_chance, at entity.stats_version
+  uint64_t proc_threshold = 0;           // Of proc_chance
+
+  Spell(Entity& entity, Aura* aura = nullptr, DamageOverTime* dot = nullptr);
   virtual void Setup();
-  virtual void Cast();
+  virtual void Cast(NotWritingCombatLog combat_log);
+  virtual void Cast(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Cast(CombatLogPolicy combat_log);
   virtual bool CanCast();
   virtual double GetBaseDamage();
   virtual void Reset();
   virtual double GetCastTime();
   virtual bool Ready();
-  virtual void StartCast(double predicted_damage = 0);
-  void OnCritProcs();
-  void OnResistProcs();
-  void OnDamageProcs();
-  void OnHitProcs();
-  void Tick(double time);
+  virtual void StartCast(NotWritingCombatLog combat_log, double predicted_damage = 0);
+  virtual void StartCast(WritingCombatLog combat_log, double predicted_damage = 0);
+  template <typename CombatLogPolicy>
+  void StartCast(CombatLogPolicy combat_log, double predicted_damage = 0);
+  bool RollHit();
+  bool RollCrit();
+  template <typename CombatLogPolicy>
+  void OnCritProcs(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void OnResistProcs(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void OnDamageProcs(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void OnHitProcs(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void OffCooldown(CombatLogPolicy combat_log);
+  void StartCooldown(double cooldown_duration);
+  double GetCooldownRemaining();
   double GetCritMultiplier(double entity_crit_multiplier);
   double PredictDamage();
   bool HasEnoughMana();
 
  private:
   virtual double GetCooldown();
-  virtual void Damage(bool is_crit = false, bool is_glancing = false);
+  virtual void Damage(NotWritingCombatLog combat_log, bool is_crit = false, bool is_glancing = false);
+  virtual void Damage(WritingCombatLog combat_log, bool is_crit = false, bool is_glancing = false);
+  template <typename CombatLogPolicy>
+  void Damage(CombatLogPolicy combat_log, bool is_crit, bool is_glancing);
   double GetManaCost();
-  std::vector<double> GetConstantDamage();
-  SpellCastResult MagicSpellCast();
-  SpellCastResult PhysicalSpellCast();
-  void OnSpellHit(SpellCastResult& spell_cast_result);
+  ConstantDamage GetConstantDamage();
+  template <typename CombatLogPolicy>
+  SpellCastResult MagicSpellCast(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  SpellCastResult PhysicalSpellCast(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void OnSpellHit(CombatLogPolicy combat_log, SpellCastResult& spell_cast_result);
+  // The entry of StartCast(), without the entries of the cast itself
+  std::string StartCastCombatLogMessage(double predicted_damage);
   void CombatLogDamage(bool is_crit, bool is_glancing, double total_damage, double spell_base_damage,
                        double spell_power, double crit_multiplier, double damage_modifier,
                        double partial_resist_multiplier);
-  void ManaGainOnCast();
+  template <typename CombatLogPolicy>
+  void ManaGainOnCast(CombatLogPolicy combat_log);
 };
 
 struct ShadowBolt : public Spell {
   ShadowBolt(Entity& entity);
-  void StartCast(double predicted_damage);
+  void StartCast(NotWritingCombatLog combat_log, double predicted_damage);
+  void StartCast(WritingCombatLog combat_log, double predicted_damage);
+  template <typename CombatLogPolicy>
+  void StartCast(CombatLogPolicy combat_log);
   double CalculateCastTime();
 };
 
@@ -121,97 +162,103 @@ struct Shadowfury : public Spell {
 struct SeedOfCorruption : public Spell {
   double aoe_cap;
   SeedOfCorruption(Entity& entity);
-  void Damage(bool is_crit = false, bool is_glancing = false);
+  void Damage(NotWritingCombatLog combat_log, bool is_crit, bool is_glancing);
+  void Damage(WritingCombatLog combat_log, bool is_crit, bool is_glancing);
+  template <typename CombatLogPolicy>
+  void Damage(CombatLogPolicy combat_log);
 };
 
 struct Corruption : public Spell {
-  Corruption(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  Corruption(Entity& entity, Aura* aura, DamageOverTime* dot);
 };
 
 struct UnstableAffliction : public Spell {
-  UnstableAffliction(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  UnstableAffliction(Entity& entity, Aura* aura, DamageOverTime* dot);
 };
 
 struct SiphonLife : public Spell {
-  SiphonLife(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  SiphonLife(Entity& entity, Aura* aura, DamageOverTime* dot);
 };
 
 struct Immolate : public Spell {
-  Immolate(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  Immolate(Entity& entity, Aura* aura, DamageOverTime* dot);
 };
 
 struct CurseOfAgony : public Spell {
-  CurseOfAgony(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  CurseOfAgony(Entity& entity, Aura* aura, DamageOverTime* dot);
 };
 
 struct CurseOfTheElements : public Spell {
-  CurseOfTheElements(Entity& entity, std::shared_ptr<Aura> aura);
+  CurseOfTheElements(Entity& entity, Aura* aura);
 };
 
 struct CurseOfRecklessness : public Spell {
-  CurseOfRecklessness(Entity& entity, std::shared_ptr<Aura> aura);
+  CurseOfRecklessness(Entity& entity, Aura* aura);
 };
 
 struct CurseOfDoom : public Spell {
-  CurseOfDoom(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  CurseOfDoom(Entity& entity, Aura* aura, DamageOverTime* dot);
 };
 
 struct Conflagrate : public Spell {
   Conflagrate(Entity& entity);
-  void Cast();
+  void Cast(NotWritingCombatLog combat_log);
+  void Cast(WritingCombatLog combat_log);
+  template <typename CombatLogPolicy>
+  void Cast(CombatLogPolicy combat_log);
   bool CanCast();
 };
 
 struct DestructionPotion : public Spell {
-  DestructionPotion(Entity& entity, std::shared_ptr<Aura> aura);
+  DestructionPotion(Entity& entity, Aura* aura);
 };
 
 struct FlameCap : public Spell {
-  FlameCap(Entity& entity, std::shared_ptr<Aura> aura);
+  FlameCap(Entity& entity, Aura* aura);
 };
 
 struct BloodFury : public Spell {
-  BloodFury(Entity& entity, std::shared_ptr<Aura> aura);
+  BloodFury(Entity& entity, Aura* aura);
 };
 
 struct Bloodlust : public Spell {
-  Bloodlust(Entity& entity, std::shared_ptr<Aura> aura);
+  Bloodlust(Entity& entity, Aura* aura);
 };
 
 struct DrumsOfBattle : public Spell {
-  DrumsOfBattle(Entity& entity, std::shared_ptr<Aura> aura);
+  DrumsOfBattle(Entity& entity, Aura* aura);
 };
 
 struct DrumsOfWar : public Spell {
-  DrumsOfWar(Entity& entity, std::shared_ptr<Aura> aura);
+  DrumsOfWar(Entity& entity, Aura* aura);
 };
 
 struct DrumsOfRestoration : public Spell {
-  DrumsOfRestoration(Entity& entity, std::shared_ptr<Aura> aura);
+  DrumsOfRestoration(Entity& entity, Aura* aura);
 };
 
 struct AmplifyCurse : public Spell {
-  AmplifyCurse(Entity& entity, std::shared_ptr<Aura> aura);
+  AmplifyCurse(Entity& entity, Aura* aura);
 };
 
 struct PowerInfusion : public Spell {
-  PowerInfusion(Entity& entity, std::shared_ptr<Aura> aura);
+  PowerInfusion(Entity& entity, Aura* aura);
 };
 
 struct Innervate : public Spell {
-  Innervate(Entity& entity, std::shared_ptr<Aura> aura);
+  Innervate(Entity& entity, Aura* aura);
 };
 
 struct ChippedPowerCore : public Spell {
-  ChippedPowerCore(Entity& entity, std::shared_ptr<Aura> aura);
+  ChippedPowerCore(Entity& entity, Aura* aura);
 };
 
 struct CrackedPowerCore : public Spell {
-  CrackedPowerCore(Entity& entity, std::shared_ptr<Aura> aura);
+  CrackedPowerCore(Entity& entity, Aura* aura);
 };
 
 struct ManaTideTotem : public Spell {
-  ManaTideTotem(Entity& entity, std::shared_ptr<Aura> aura);
+  ManaTideTotem(Entity& entity, Aura* aura);
 };
 
 struct PetMelee : public Spell {
@@ -3,6 +3,6 @@
 #include "spell.h"
 
 struct SpellProc : public Spell {
-  SpellProc(Entity& entity, std::shared_ptr<Aura> aura = nullptr);
+  SpellProc(Entity& entity, Aura* aura = nullptr);
   virtual bool ShouldProc(Spell* spell);
 };
\ No newline at end of file
@@ -5,65 +5,65 @@
 #include "spell.h"
 
 struct Spells {
-  std::shared_ptr<Spell> life_tap;
-  std::shared_ptr<Spell> seed_of_corruption;
-  std::shared_ptr<Spell> shadow_bolt;
-  std::shared_ptr<Spell> incinerate;
-  std::shared_ptr<Spell> searing_pain;
-  std::shared_ptr<Spell> corruption;
-  std::shared_ptr<Spell> unstable_affliction;
-  std::shared_ptr<Spell> siphon_life;
-  std::shared_ptr<Spell> immolate;
-  std::shared_ptr<Spell> curse_of_agony;
-  std::shared_ptr<Spell> curse_of_the_elements;
-  std::shared_ptr<Spell> curse_of_recklessness;
-  std::shared_ptr<Spell> curse_of_doom;
-  std::shared_ptr<Spell> conflagrate;
-  std::shared_ptr<Spell> shadowburn;
-  std::shared_ptr<Spell> death_coil;
-  std::shared_ptr<Spell> shadowfury;
-  std::shared_ptr<Spell> amplify_curse;
-  std::shared_ptr<Spell> dark_pact;
-  std::shared_ptr<Spell> destruction_potion;
-  std::shared_ptr<Spell> super_mana_potion;
-  std::shared_ptr<Spell> demonic_rune;
-  std::shared_ptr<Spell> flame_cap;
-  std::shared_ptr<Spell> blood_fury;
-  std::shared_ptr<Spell> drums_of_battle;
-  std::shared_ptr<Spell> drums_of_war;
-  std::shared_ptr<Spell> drums_of_restoration;
-  std::shared_ptr<Spell> blade_of_wizardry;
-  std::shared_ptr<Spell> shattered_sun_pendant_of_acumen_aldor;
-  std::shared_ptr<Spell> shattered_sun_pendant_of_acumen_scryers;
-  std::shared_ptr<Spell> robe_of_the_elder_scribes;
-  std::shared_ptr<Spell> mystical_skyfire_diamond;
-  std::shared_ptr<Spell> insightful_earthstorm_diamond;
-  std::shared_ptr<Spell> timbals_focusing_crystal;
-  std::shared_ptr<Spell> mark_of_defiance;
-  std::shared_ptr<Spell> the_lightning_capacitor;
-  std::shared_ptr<Spell> quagmirrans_eye;
-  std::shared_ptr<Spell> shiffars_nexus_horn;
-  std::shared_ptr<Spell> sextant_of_unstable_currents;
-  std::shared_ptr<Spell> band_of_the_eternal_sage;
-  std::shared_ptr<Spell> chipped_power_core;
-  std::shared_ptr<Spell> cracked_power_core;
-  std::shared_ptr<Spell> mana_tide_totem;
-  std::shared_ptr<Spell> judgement_of_wisdom;
-  std::shared_ptr<Spell> flameshadow;
-  std::shared_ptr<Spell> shadowflame;
-  std::shared_ptr<Spell> spellstrike;
-  std::shared_ptr<Spell> mana_etched_4_set;
-  std::shared_ptr<Spell> ashtongue_talisman_of_shadows;
-  std::shared_ptr<Spell> wrath_of_cenarius;
-  std::shared_ptr<Spell> darkmoon_card_crusade;
-  std::shared_ptr<Spell> eye_of_magtheridon;
-  std::shared_ptr<Spell> improved_shadow_bolt;
-  std::shared_ptr<Spell> melee;
-  std::shared_ptr<Spell> firebolt;
-  std::shared_ptr<Spell> lash_of_pain;
-  std::shared_ptr<Spell> cleave;
-  std::shared_ptr<Spell> demonic_frenzy;
-  std::vector<std::shared_ptr<Spell>> power_infusion;
-  std::vector<std::shared_ptr<Spell>> bloodlust;
-  std::vector<std::shared_ptr<Spell>> innervate;
+  Spell* life_tap = NULL;
+  Spell* seed_of_corruption = NULL;
+  Spell* shadow_bolt = NULL;
+  Spell* incinerate = NULL;
+  Spell* searing_pain = NULL;
+  Spell* corruption = NULL;
+  Spell* unstable_affliction = NULL;
+  Spell* siphon_life = NULL;
+  Spell* immolate = NULL;
+  Spell* curse_of_agony = NULL;
+  Spell* curse_of_the_elements = NULL;
+  Spell* curse_of_recklessness = NULL;
+  Spell* curse_of_doom = NULL;
+  Spell* conflagrate = NULL;
+  Spell* shadowburn = NULL;
+  Spell* death_coil = NULL;
+  Spell* shadowfury = NULL;
+  Spell* amplify_curse = NULL;
+  Spell* dark_pact = NULL;
+  Spell* destruction_potion = NULL;
+  Spell* super_mana_potion = NULL;
+  Spell* demonic_rune = NULL;
+  Spell* flame_cap = NULL;
+  Spell* blood_fury = NULL;
+  Spell* drums_of_battle = NULL;
+  Spell* drums_of_war = NULL;
+  Spell* drums_of_restoration = NULL;
+  Spell* blade_of_wizardry = NULL;
+  Spell* shattered_sun_pendant_of_acumen_aldor = NULL;
+  Spell* shattered_sun_pendant_of_acumen_scryers = NULL;
+  Spell* robe_of_the_elder_scribes = NULL;
+  Spell* mystical_skyfire_diamond = NULL;
+  Spell* insightful_earthstorm_diamond = NULL;
+  Spell* timbals_focusing_crystal = NULL;
+  Spell* mark_of_defiance = NULL;
+  Spell* the_lightning_capacitor = NULL;
+  Spell* quagmirrans_eye = NULL;
+  Spell* shiffars_nexus_horn = NULL;
+  Spell* sextant_of_unstable_currents = NULL;
+  Spell* band_of_the_eternal_sage = NULL;
+  Spell* chipped_power_core = NULL;
+  Spell* cracked_power_core = NULL;
+  Spell* mana_tide_totem = NULL;
+  Spell* judgement_of_wisdom = NULL;
+  Spell* flameshadow = NULL;
+  Spell* shadowflame = NULL;
+  Spell* spellstrike = NULL;
+  Spell* mana_etched_4_set = NULL;
+  Spell* ashtongue_talisman_of_shadows = NULL;
+  Spell* wrath_of_cenarius = NULL;
+  Spell* darkmoon_card_crusade = NULL;
+  Spell* eye_of_magtheridon = NULL;
+  Spell* improved_shadow_bolt = NULL;
+  Spell* melee = NULL;
+  Spell* firebolt = NULL;
+  Spell* lash_of_pain = NULL;
+  Spell* cleave = NULL;
+  Spell* demonic_frenzy = NULL;
+  std::vector<Spell*> power_infusion;
+  std::vector<Spell*> bloodlust;
+  std::vector<Spell*> innervate;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@ struct Entity;
 #include <map>
 #include <string>
 
+#include "combat_log_policy.h"
 #include "enums.h"
 
 struct Stat {
@@ -16,11 +17,14 @@ struct Stat {
   int combat_log_decimal_places = 0;
 
   Stat(Entity& entity, double& character_stat, double value);
-  void AddStat();
-  void RemoveStat(int stacks = 1);
+  template <typename CombatLogPolicy>
+  void AddStat(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void RemoveStat(CombatLogPolicy combat_log, int stacks = 1);
 
  private:
-  void ModifyStat(std::string action, int stacks = 1);
+  template <typename CombatLogPolicy>
+  void ModifyStat(CombatLogPolicy combat_log, StatAction action, int stacks = 1);
 };
 
 struct SpellPower : public Stat {
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "common.h"
+
+// Timers that run out at an absolute fight time (a spell coming off cooldown, an aura fading, a dot ticking), in a
+// binary min-heap ordered by that time. Nothing counts down between events: the owner schedules a timer when it sets
+// it, and only the timers whose time has come are popped off and handled. Timers that run out at the same time are
+// popped in the order of their priority, and then in the order they were added in.
+struct TimerQueue {
+  struct Timer {
+    FightTime time = 0;
+    int priority = 0;
+    int heap_index = -1;  // -1 while the timer isn't scheduled
+  };
+
+  std::vector<Timer> timers;
+  std::vector<int> heap;
+
+  // Returns the id of the new timer, starting at 0 and counting up
+  int Add(int priority = 0);
+  // Moves the timer if it's already scheduled
+  void Schedule(int timer, FightTime time);
+  void Cancel(int timer);
+  bool IsScheduled(int timer) const;
+  // The time of the timer that runs out first, or the largest FightTime when none are scheduled
+  FightTime NextTime() const;
+  // Unschedules and returns the timer that runs out first if it runs out at or before the time, otherwise -1
+  int PopDue(FightTime time);
+
+ private:
+  bool IsBefore(int heap_index, int other_heap_index) const;
+  void Swap(int heap_index, int other_heap_index);
+  void SiftUp(int heap_index);
+  void SiftDown(int heap_index);
+};
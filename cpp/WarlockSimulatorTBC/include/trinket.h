@@ -5,26 +5,34 @@ struct Player;
 #include <optional>
 #include <vector>
 
+#include "combat_log_policy.h"
+#include "common.h"
 #include "stat.h"
 
 struct Trinket {
   Player& player;
   std::vector<Stat> stats;
   int duration = 0;
-  double duration_remaining = 0;
+  FightTime expires_at = 0;  // The fight time at which the trinket fades
+  int duration_timer = -1;  // In player.trinket_timers
   int cooldown = 0;
-  double cooldown_remaining = 0;
+  FightTime ready_at = 0;  // The fight time at which the cooldown runs out
+  int cooldown_timer = -1;
   bool active = false;
   bool shares_cooldown = true;
   std::string name;
+  int breakdown_index = -1;  // In player.combat_log_breakdown
 
   Trinket(Player& player);
   bool Ready();
   void Reset();
   void Setup();
-  void Use();
-  void Fade();
-  void Tick(double time);
+  template <typename CombatLogPolicy>
+  void Use(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void Fade(CombatLogPolicy combat_log);
+  template <typename CombatLogPolicy>
+  void OffCooldown(CombatLogPolicy combat_log);
 };
 
 struct RestrainedEssenceOfSapphiron : public Trinket {
@@ -0,0 +1,32 @@
+#include "../include/arena.h"
+
+#include <algorithm>
+
+Arena::~Arena() { Reset(); }
+
+void Arena::Reset() {
+  while (!destructors.empty()) {
+    destructors.back().destroy(destructors.back().object);
+    destructors.pop_back();
+  }
+
+  blocks.clear();
+}
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+  if (!blocks.empty()) {
+    auto& block = blocks.back();
+    const std::size_t kOffset = (block.used + alignment - 1) / alignment * alignment;
+
+    if (kOffset + size <= block.size) {
+      block.used = kOffset + size;
+      return block.memory.get() + kOffset;
+    }
+  }
+
+  // Objects that don't fit in a block get one of their own
+  const std::size_t kSize = std::max(size, kBlockSize);
+  blocks.push_back({std::make_unique<char[]>(kSize), kSize, size});
+
+  return blocks.back().memory.get();
+}
@@ -1,5 +1,6 @@
 #include "../include/aura.h"
 
+#include <cmath>
 #include <iostream>
 
 #include "../include/common.h"
@@ -9,154 +10,219 @@
 Aura::Aura(Entity& entity) : entity(entity) {}
 
 void Aura::Setup() {
-  if (entity.recording_combat_log_breakdown && entity.combat_log_breakdown.count(name) == 0) {
-    entity.combat_log_breakdown.insert({name, std::make_unique<CombatLogBreakdown>(name)});
+  name = SpellIdToName(id);
+
+  if (tick_timer_total > 0) {
+    ticks_total = duration / tick_timer_total;
+  }
+
+  if (entity.recording_combat_log_breakdown) {
+    breakdown_index = entity.AddCombatLogBreakdownRow(name);
   }
 
   entity.aura_list.push_back(this);
+  timer = entity.aura_timers.Add(timer_priority);
 }
 
-void Aura::Tick(double t) {
-  if (has_duration) {
-    duration_remaining -= t;
-    if (duration_remaining <= 0) {
-      Fade();
-    }
+template <typename CombatLogPolicy>
+void Aura::Tick(CombatLogPolicy combat_log) {
+  if (tick_timer_total == 0) {
+    Fade(combat_log);
+    return;
+  }
+
+  ticks_remaining--;
+  next_tick_at += tick_timer_total * kFightTimePerSecond;
+  entity.aura_timers.Schedule(timer, next_tick_at);
+  OnTick(combat_log);
+
+  if (ticks_remaining <= 0) {
+    Fade(combat_log);
   }
 }
 
-void Aura::Apply() {
-  if (active && entity.ShouldWriteToCombatLog() && (stacks == max_stacks)) {
-    entity.CombatLog(name + " refreshed");
+void Aura::OnTick(NotWritingCombatLog) {}
+
+void Aura::OnTick(WritingCombatLog) {}
+
+void Aura::Apply(NotWritingCombatLog combat_log) { Apply<>(combat_log); }
+
+void Aura::Apply(WritingCombatLog combat_log) { Apply<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void Aura::Apply(CombatLogPolicy combat_log) {
+  if (active && stacks == max_stacks) {
+    if constexpr (CombatLogPolicy::kWriting) {
+      entity.CombatLog(name + " refreshed");
+    }
   } else if (!active) {
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->applied_at = entity.simulation->current_fight_time;
+      entity.combat_log_breakdown[breakdown_index].applied_at =
+          FightTimeToSeconds(entity.simulation->current_fight_time);
     }
 
     for (auto& stat : stats) {
-      stat.AddStat();
+      stat.AddStat(combat_log);
     }
 
-    if (entity.ShouldWriteToCombatLog()) {
+    if constexpr (CombatLogPolicy::kWriting) {
       entity.CombatLog(name + " applied");
     }
 
     active = true;
+    entity.active_auras.Add(this);
+    entity.InvalidateDerivedStats();
   }
 
   if (stacks < max_stacks) {
     stacks++;
+    entity.InvalidateDerivedStats();
 
-    if (entity.ShouldWriteToCombatLog()) {
+    if constexpr (CombatLogPolicy::kWriting) {
       entity.CombatLog(name + " (" + std::to_string(stacks) + ")");
     }
 
     for (auto& stat : stats_per_stack) {
-      stat.AddStat();
+      stat.AddStat(combat_log);
     }
   }
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->count++;
+    entity.combat_log_breakdown[breakdown_index].count++;
   }
 
-  duration_remaining = duration;
+  StartTimer();
+}
+
+void Aura::StartTimer() {
+  if (has_duration) {
+    expires_at = entity.simulation->current_fight_time + duration * kFightTimePerSecond;
+  }
+  if (tick_timer_total > 0) {
+    next_tick_at = entity.simulation->current_fight_time + tick_timer_total * kFightTimePerSecond;
+    ticks_remaining = ticks_total;
+    entity.aura_timers.Schedule(timer, next_tick_at);
+  } else if (has_duration) {
+    entity.aura_timers.Schedule(timer, expires_at);
+  }
 }
 
-void Aura::Fade() {
+template <typename CombatLogPolicy>
+void Aura::Fade(CombatLogPolicy combat_log) {
   if (!active) {
     entity.player->ThrowError("Attempting to fade " + name + " when it isn't active");
   }
 
   for (auto& stat : stats) {
-    stat.RemoveStat();
+    stat.RemoveStat(combat_log);
   }
 
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     entity.CombatLog(name + " faded");
   }
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->uptime +=
-        entity.simulation->current_fight_time - entity.combat_log_breakdown.at(name)->applied_at;
+    auto& breakdown = entity.combat_log_breakdown[breakdown_index];
+    breakdown.uptime += FightTimeToSeconds(entity.simulation->current_fight_time) - breakdown.applied_at;
   }
 
   if (stacks > 0) {
     for (auto& stat : stats_per_stack) {
-      stat.RemoveStat(stacks);
+      stat.RemoveStat(combat_log, stacks);
     }
   }
 
   active = false;
+  entity.active_auras.Remove(this);
+  entity.InvalidateDerivedStats();
   stacks = 0;
+  ticks_remaining = 0;
+  entity.aura_timers.Cancel(timer);
 }
 
-void Aura::DecrementStacks() {}
+template void Aura::Tick(NotWritingCombatLog);
+template void Aura::Tick(WritingCombatLog);
+template void Aura::Fade(NotWritingCombatLog);
+template void Aura::Fade(WritingCombatLog);
+
+void Aura::DecrementStacks(NotWritingCombatLog) {}
+
+void Aura::DecrementStacks(WritingCombatLog) {}
 
 ImprovedShadowBoltAura::ImprovedShadowBoltAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kImprovedShadowBolt;
+  id = SpellId::kImprovedShadowBolt;
   duration = 12;
   max_stacks = 4;
   Aura::modifier = 1 + entity.player->talents.improved_shadow_bolt * 0.04;
   Setup();
 }
 
-void ImprovedShadowBoltAura::Apply() {
-  Aura::Apply();
+void ImprovedShadowBoltAura::Apply(NotWritingCombatLog combat_log) { Apply<>(combat_log); }
+
+void ImprovedShadowBoltAura::Apply(WritingCombatLog combat_log) { Apply<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void ImprovedShadowBoltAura::Apply(CombatLogPolicy combat_log) {
+  Aura::Apply(combat_log);
   stacks = max_stacks;
 }
 
-void ImprovedShadowBoltAura::DecrementStacks() {
+void ImprovedShadowBoltAura::DecrementStacks(NotWritingCombatLog combat_log) { DecrementStacks<>(combat_log); }
+
+void ImprovedShadowBoltAura::DecrementStacks(WritingCombatLog combat_log) { DecrementStacks<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void ImprovedShadowBoltAura::DecrementStacks(CombatLogPolicy combat_log) {
   stacks--;
 
   if (stacks <= 0) {
-    Fade();
-  } else if (entity.ShouldWriteToCombatLog()) {
+    Fade(combat_log);
+  } else if constexpr (CombatLogPolicy::kWriting) {
     entity.CombatLog(name + " (" + std::to_string(stacks) + ")");
   }
 }
 
 CurseOfTheElementsAura::CurseOfTheElementsAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kCurseOfTheElements;
+  id = SpellId::kCurseOfTheElements;
   duration = 300;
   Setup();
 }
 
 CurseOfRecklessnessAura::CurseOfRecklessnessAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kCurseOfRecklessness;
+  id = SpellId::kCurseOfRecklessness;
   duration = 120;
   Setup();
 }
 
 ShadowTranceAura::ShadowTranceAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kNightfall;
+  id = SpellId::kNightfall;
   duration = 10;
   Setup();
 }
 
 FlameshadowAura::FlameshadowAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kFlameshadow;
+  id = SpellId::kFlameshadow;
   duration = 15;
   stats.push_back(ShadowPower(entity, 135));
   Setup();
 }
 
 ShadowflameAura::ShadowflameAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kShadowflame;
+  id = SpellId::kShadowflame;
   duration = 15;
   stats.push_back(FirePower(entity, 135));
   Setup();
 }
 
 SpellstrikeAura::SpellstrikeAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kSpellstrike;
+  id = SpellId::kSpellstrike;
   duration = 10;
   stats.push_back(SpellPower(entity, 92));
   Setup();
 }
 
 PowerInfusionAura::PowerInfusionAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kPowerInfusion;
+  id = SpellId::kPowerInfusion;
   duration = 15;
   stats.push_back(SpellHastePercent(entity, 1.2));
   stats.push_back(ManaCostModifier(entity, 0.8));
@@ -164,42 +230,42 @@ PowerInfusionAura::PowerInfusionAura(Entity& entity) : Aura(entity) {
 }
 
 EyeOfMagtheridonAura::EyeOfMagtheridonAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kEyeOfMagtheridon;
+  id = SpellId::kEyeOfMagtheridon;
   duration = 10;
   stats.push_back(SpellPower(entity, 170));
   Setup();
 }
 
 SextantOfUnstableCurrentsAura::SextantOfUnstableCurrentsAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kSextantOfUnstableCurrents;
+  id = SpellId::kSextantOfUnstableCurrents;
   duration = 15;
   stats.push_back(SpellPower(entity, 190));
   Setup();
 }
 
 QuagmirransEyeAura::QuagmirransEyeAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kQuagmirransEye;
+  id = SpellId::kQuagmirransEye;
   duration = 6;
   stats.push_back(SpellHasteRating(entity, 320));
   Setup();
 }
 
 ShiffarsNexusHornAura::ShiffarsNexusHornAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kShiffarsNexusHorn;
+  id = SpellId::kShiffarsNexusHorn;
   duration = 10;
   stats.push_back(SpellPower(entity, 225));
   Setup();
 }
 
 ManaEtched4SetAura::ManaEtched4SetAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kManaEtched4Set;
+  id = SpellId::kManaEtched4Set;
   duration = 15;
   stats.push_back(SpellPower(entity, 110));
   Setup();
 }
 
 DestructionPotionAura::DestructionPotionAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kDestructionPotion;
+  id = SpellId::kDestructionPotion;
   duration = 15;
   stats.push_back(SpellPower(entity, 120));
   stats.push_back(SpellCritChance(entity, 2));
@@ -207,33 +273,33 @@ DestructionPotionAura::DestructionPotionAura(Entity& entity) : Aura(entity) {
 }
 
 FlameCapAura::FlameCapAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kFlameCap;
+  id = SpellId::kFlameCap;
   duration = 60;
   stats.push_back(FirePower(entity, 80));
   Setup();
 }
 
 BloodFuryAura::BloodFuryAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kBloodFury;
+  id = SpellId::kBloodFury;
   duration = 15;
   stats.push_back(SpellPower(entity, 140));
   Setup();
 }
 
 BloodlustAura::BloodlustAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kBloodlust;
+  id = SpellId::kBloodlust;
   duration = 40;
   group_wide = true;
   stats.push_back(SpellHastePercent(entity, 1.3));
   if (entity.pet != NULL) {
-    stats.push_back(SpellHastePercent(*entity.pet.get(), 1.3));
-    stats.push_back(MeleeHastePercent(*entity.pet.get(), 1.3));
+    stats.push_back(SpellHastePercent(*entity.pet, 1.3));
+    stats.push_back(MeleeHastePercent(*entity.pet, 1.3));
   }
   Setup();
 }
 
 DrumsOfBattleAura::DrumsOfBattleAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kDrumsOfBattle;
+  id = SpellId::kDrumsOfBattle;
   duration = 30;
   group_wide = true;
   stats.push_back(SpellHasteRating(entity, 80));
@@ -241,7 +307,7 @@ DrumsOfBattleAura::DrumsOfBattleAura(Entity& entity) : Aura(entity) {
 }
 
 DrumsOfWarAura::DrumsOfWarAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kDrumsOfWar;
+  id = SpellId::kDrumsOfWar;
   duration = 30;
   group_wide = true;
   stats.push_back(SpellPower(entity, 30));
@@ -249,14 +315,14 @@ DrumsOfWarAura::DrumsOfWarAura(Entity& entity) : Aura(entity) {
 }
 
 AshtongueTalismanOfShadowsAura::AshtongueTalismanOfShadowsAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kAshtongueTalismanOfShadows;
+  id = SpellId::kAshtongueTalismanOfShadows;
   duration = 5;
   stats.push_back(SpellPower(entity, 220));
   Setup();
 }
 
 DarkmoonCardCrusadeAura::DarkmoonCardCrusadeAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kDarkmoonCardCrusade;
+  id = SpellId::kDarkmoonCardCrusade;
   duration = 10;
   max_stacks = 10;
   stats_per_stack.push_back(SpellPower(entity, 8));
@@ -264,96 +330,96 @@ DarkmoonCardCrusadeAura::DarkmoonCardCrusadeAura(Entity& entity) : Aura(entity)
 }
 
 TheLightningCapacitorAura::TheLightningCapacitorAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kTheLightningCapacitor;
+  id = SpellId::kTheLightningCapacitor;
   has_duration = false;
   max_stacks = 3;
   Setup();
 }
 
 BandOfTheEternalSageAura::BandOfTheEternalSageAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kBandOfTheEternalSage;
+  id = SpellId::kBandOfTheEternalSage;
   duration = 10;
   stats.push_back(SpellPower(entity, 95));
   Setup();
 }
 
 BladeOfWizardryAura::BladeOfWizardryAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kBladeOfWizardry;
+  id = SpellId::kBladeOfWizardry;
   duration = 6;
   stats.push_back(SpellHasteRating(entity, 280));
   Setup();
 }
 
 ShatteredSunPendantOfAcumenAldorAura::ShatteredSunPendantOfAcumenAldorAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kShatteredSunPendantOfAcumenAldor;
+  id = SpellId::kShatteredSunPendantOfAcumenAldor;
   duration = 10;
   stats.push_back(SpellPower(entity, 120));
   Setup();
 }
 
 RobeOfTheElderScribesAura::RobeOfTheElderScribesAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kRobeOfTheElderScribes;
+  id = SpellId::kRobeOfTheElderScribes;
   duration = 10;
   stats.push_back(SpellPower(entity, 130));
   Setup();
 }
 
 MysticalSkyfireDiamondAura::MysticalSkyfireDiamondAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kMysticalSkyfireDiamond;
+  id = SpellId::kMysticalSkyfireDiamond;
   duration = 4;
   stats.push_back(SpellHasteRating(entity, 320));
   Setup();
 }
 
 AmplifyCurseAura::AmplifyCurseAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kAmplifyCurse;
+  id = SpellId::kAmplifyCurse;
   duration = 30;
   Setup();
 };
 
 WrathOfCenariusAura::WrathOfCenariusAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kWrathOfCenarius;
+  id = SpellId::kWrathOfCenarius;
   duration = 10;
   stats.push_back(SpellPower(entity, 132));
   Setup();
 }
 
 InnervateAura::InnervateAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kInnervate;
+  id = SpellId::kInnervate;
   duration = 20;
   Setup();
 }
 
 ChippedPowerCoreAura::ChippedPowerCoreAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kChippedPowerCore;
+  id = SpellId::kChippedPowerCore;
   duration = 30;
   stats.push_back(SpellPower(entity, 25));
   Setup();
 }
 
 CrackedPowerCoreAura::CrackedPowerCoreAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kCrackedPowerCore;
+  id = SpellId::kCrackedPowerCore;
   duration = 30;
   stats.push_back(SpellPower(entity, 15));
   Setup();
 }
 
 AirmansRibbonOfGallantryAura::AirmansRibbonOfGallantryAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kAirmansRibbonOfGallantry;
+  id = SpellId::kAirmansRibbonOfGallantry;
   duration = 30;  // should maybe lower this to 25 or so for more realism
   stats.push_back(SpellPower(entity, 80));
   Setup();
 }
 
 DemonicFrenzyAura::DemonicFrenzyAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kDemonicFrenzy;
+  id = SpellId::kDemonicFrenzy;
   duration = 10;
   max_stacks = 10;
   Setup();
 }
 
 BlackBookAura::BlackBookAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kBlackBook;
+  id = SpellId::kBlackBook;
   duration = 30;
   stats.push_back(SpellPower(entity, 200));
   stats.push_back(AttackPower(entity, 325));
@@ -361,7 +427,7 @@ BlackBookAura::BlackBookAura(Entity& entity) : Aura(entity) {
 }
 
 BattleSquawkAura::BattleSquawkAura(Entity& entity) : Aura(entity) {
-  name = SpellName::kBattleSquawk;
+  id = SpellId::kBattleSquawk;
   duration = 300;
   stats.push_back(MeleeHastePercent(entity, std::pow(1.05, entity.player->settings.battle_squawk_amount)));
   Setup();
@@ -0,0 +1,309 @@
+#include "../include/batch_simulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "../include/player.h"
+#include "../include/rng.h"
+#include "../include/simulation.h"
+
+// A Player with its own Simulation so that it can run any iteration of its config
+struct ConfigRunner {
+  Player player;
+  Simulation simulation;
+
+  ConfigRunner(PlayerSettings& player_settings, const SimulationSettings& simulation_settings)
+      : player(player_settings), simulation(player, simulation_settings) {
+    simulation.sending_progress_updates = false;
+    simulation.min_dps = std::numeric_limits<double>::max();
+    player.total_fight_duration = 0;
+    player.Initialize(&simulation);
+  }
+};
+
+BatchSimulation::BatchSimulation(const SimulationSettings& simulation_settings) : settings(simulation_settings) {}
+
+PlayerSettings& BatchSimulation::AddConfig(const PlayerSettings& player_settings) {
+  configs.push_back(std::make_unique<PlayerSettings>(player_settings));
+  // The combat log is only written by normal sims
+  configs.back()->equipped_item_simulation = false;
+  dps.emplace_back();
+  total_fight_durations.push_back(0);
+  breakdowns.emplace_back();
+  active.push_back(true);
+  known_iterations.push_back(0);
+  stored_iterations.push_back(0);
+
+  return *configs.back();
+}
+
+void BatchSimulation::LoadCachedIterations() {
+  for (size_t config = 0; config < configs.size(); config++) {
+    CachedIterations cached_iterations;
+
+    if (result_cache->load(ConfigHash(*configs[config], settings), cached_iterations)) {
+      const int kCachedIterations = static_cast<int>(cached_iterations.dps.size());
+
+      if (static_cast<int>(dps[config].size()) < kCachedIterations) {
+        dps[config].resize(kCachedIterations);
+      }
+      std::copy(cached_iterations.dps.begin(), cached_iterations.dps.begin() + kCachedIterations,
+                dps[config].begin());
+      known_iterations[config] = kCachedIterations;
+      stored_iterations[config] = static_cast<int>(cached_iterations.dps.size());
+    }
+  }
+
+  loaded_cached_iterations = true;
+}
+
+// Stores the config's dps in the result cache if it has more iterations than its entry
+void BatchSimulation::StoreCachedIterations(int config) {
+  if (known_iterations[config] <= stored_iterations[config]) {
+    return;
+  }
+
+  CachedIterations cached_iterations;
+  cached_iterations.dps.assign(dps[config].begin(), dps[config].begin() + known_iterations[config]);
+  result_cache->store(ConfigHash(*configs[config], settings), cached_iterations);
+  stored_iterations[config] = known_iterations[config];
+}
+
+// A worker's share of the tasks. The worker takes its tasks from the front, and other workers that have run out of
+// tasks steal from the back.
+struct TaskQueue {
+  std::mutex mutex;
+  std::deque<int> tasks;
+};
+
+void BatchSimulation::Run(int first_iteration, int last_iteration,
+                          const std::function<void(int config, int first_iteration, int last_iteration)>& chunk_done) {
+  std::vector<int> active_configs;
+  for (int config = 0; config < static_cast<int>(configs.size()); config++) {
+    if (active[config]) {
+      active_configs.push_back(config);
+    }
+  }
+
+  const int kConfigAmount = static_cast<int>(active_configs.size());
+  if (kConfigAmount == 0 || last_iteration <= first_iteration) {
+    return;
+  }
+
+  if (result_cache != NULL && !loaded_cached_iterations) {
+    LoadCachedIterations();
+  }
+
+  const int kChunkSize = std::max(1, static_cast<int>(std::floor((last_iteration - first_iteration) / 100.0)));
+  const int kChunksPerConfig = (last_iteration - first_iteration + kChunkSize - 1) / kChunkSize;
+  const int kTaskAmount = kChunksPerConfig * kConfigAmount;
+  std::vector<int> tasks;
+  std::vector<std::vector<CombatLogBreakdown>> task_breakdowns(kTaskAmount);
+  std::vector<std::pair<int, int>> known_chunks;  // (config, first iteration) of the chunks that aren't simulated again
+
+  for (const auto& kConfig : active_configs) {
+    if (static_cast<int>(dps[kConfig].size()) < last_iteration) {
+      dps[kConfig].resize(last_iteration);
+    }
+  }
+
+  // Task t is chunk t / kConfigAmount of the config at t % kConfigAmount, so going through the tasks in order
+  // progresses every config at the same rate
+  Rng rng;
+  for (int task = 0; task < kTaskAmount; task++) {
+    const int kConfig = active_configs[task % kConfigAmount];
+    const int kFirstIteration = first_iteration + (task / kConfigAmount) * kChunkSize;
+    const int kLastIteration = std::min(kFirstIteration + kChunkSize, last_iteration);
+
+    // The iterations that are already known still count towards the total fight duration
+    for (int i = kFirstIteration; i < std::min(kLastIteration, known_iterations[kConfig]); i++) {
+      total_fight_durations[kConfig] += Simulation::RollFightLength(rng, configs[kConfig]->random_seed, i, settings);
+    }
+
+    if (kLastIteration <= known_iterations[kConfig]) {
+      known_chunks.push_back({kConfig, kFirstIteration});
+    } else {
+      tasks.push_back(task);
+    }
+  }
+
+#if defined(EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+  const int kThreadAmount = 1;
+#else
+  const int kThreadAmount = std::max(1, std::min(settings.threads, static_cast<int>(tasks.size())));
+#endif
+  std::vector<TaskQueue> queues(kThreadAmount);
+  std::atomic<bool> stopping = false;
+  int finished_threads = 0;
+  std::deque<std::pair<int, int>> finished_chunks;  // (config, first iteration) of chunks not passed to chunk_done yet
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable progress;
+
+  // When there are enough configs each worker gets every chunk of its configs, so that it doesn't have to initialize a
+  // player for every config, otherwise the chunks are dealt out
+  for (const auto& task : tasks) {
+    const int kOwner = kConfigAmount >= kThreadAmount ? task % kConfigAmount % kThreadAmount : task % kThreadAmount;
+    queues[kOwner].tasks.push_back(task);
+  }
+
+  auto take_task = [&](int thread, int& task) {
+    {
+      std::lock_guard<std::mutex> lock(queues[thread].mutex);
+      if (!queues[thread].tasks.empty()) {
+        task = queues[thread].tasks.front();
+        queues[thread].tasks.pop_front();
+        return true;
+      }
+    }
+
+    // No tasks are added after the start, so once every queue is empty there's nothing left to do
+    for (int i = 1; i < kThreadAmount; i++) {
+      auto& victim = queues[(thread + i) % kThreadAmount];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+
+      if (!victim.tasks.empty()) {
+        task = victim.tasks.back();
+        victim.tasks.pop_back();
+        return true;
+      }
+    }
+
+    return false;
+  };
+
+  auto run_tasks = [&](int thread) {
+    std::map<int, std::unique_ptr<ConfigRunner>> runners;
+
+    try {
+      for (int task; !stopping && take_task(thread, task);) {
+        const int kConfig = active_configs[task % kConfigAmount];
+        const int kFirstIteration = first_iteration + (task / kConfigAmount) * kChunkSize;
+        const int kLastIteration = std::min(kFirstIteration + kChunkSize, last_iteration);
+        // Only the iterations that aren't known yet are simulated
+        const int kFirstSimulatedIteration = std::max(kFirstIteration, known_iterations[kConfig]);
+        auto& runner = runners[kConfig];
+
+        if (runner == NULL) {
+          runner = std::make_unique<ConfigRunner>(*configs[kConfig], settings);
+        }
+
+        runner->simulation.dps_vector.clear();
+        runner->player.total_fight_duration = 0;
+        runner->simulation.RunIterations(kFirstSimulatedIteration, kLastIteration);
+
+        // Every task has its own rows, so they don't need the lock
+        if (runner->player.recording_combat_log_breakdown) {
+          runner->player.TakeCombatLogBreakdown(task_breakdowns[task]);
+          if (runner->player.pet != NULL) {
+            runner->player.pet->TakeCombatLogBreakdown(task_breakdowns[task]);
+          }
+        }
+
+        if (kThreadAmount == 1) {
+          std::copy(runner->simulation.dps_vector.begin(), runner->simulation.dps_vector.end(),
+                    dps[kConfig].begin() + kFirstSimulatedIteration);
+          total_fight_durations[kConfig] += runner->player.total_fight_duration;
+          if (chunk_done) {
+            chunk_done(kConfig, kFirstIteration, kLastIteration);
+          }
+          continue;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          std::copy(runner->simulation.dps_vector.begin(), runner->simulation.dps_vector.end(),
+                    dps[kConfig].begin() + kFirstSimulatedIteration);
+          total_fight_durations[kConfig] += runner->player.total_fight_duration;
+          finished_chunks.push_back({kConfig, kFirstIteration});
+        }
+        progress.notify_one();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      stopping = true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished_threads++;
+    }
+    progress.notify_one();
+  };
+
+  if (chunk_done) {
+    for (const auto& kChunk : known_chunks) {
+      chunk_done(kChunk.first, kChunk.second, std::min(kChunk.second + kChunkSize, last_iteration));
+    }
+  }
+
+  std::vector<std::thread> threads;
+  if (kThreadAmount > 1) {
+    for (int i = 0; i < kThreadAmount; i++) {
+      threads.emplace_back(run_tasks, i);
+    }
+  } else {
+    run_tasks(0);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (finished_threads < kThreadAmount || !finished_chunks.empty()) {
+    progress.wait(lock, [&] { return !finished_chunks.empty() || finished_threads == kThreadAmount; });
+
+    while (!finished_chunks.empty()) {
+      const auto kChunk = finished_chunks.front();
+      finished_chunks.pop_front();
+
+      if (chunk_done && !error) {
+        lock.unlock();
+        chunk_done(kChunk.first, kChunk.second, std::min(kChunk.second + kChunkSize, last_iteration));
+        lock.lock();
+      }
+    }
+  }
+  lock.unlock();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  // Added in task order so that the totals don't depend on the thread count
+  for (int task = 0; task < kTaskAmount; task++) {
+    auto& breakdown = breakdowns[active_configs[task % kConfigAmount]];
+    const auto& kTaskBreakdown = task_breakdowns[task];
+
+    if (breakdown.empty()) {
+      breakdown = kTaskBreakdown;
+      continue;
+    }
+    for (size_t row = 0; row < kTaskBreakdown.size(); row++) {
+      breakdown[row].Add(kTaskBreakdown[row]);
+    }
+  }
+
+  for (const auto& kConfig : active_configs) {
+    if (first_iteration <= known_iterations[kConfig]) {
+      known_iterations[kConfig] = std::max(known_iterations[kConfig], last_iteration);
+    }
+
+    if (result_cache != NULL) {
+      StoreCachedIterations(kConfig);
+    }
+  }
+}
@@ -1,54 +1,86 @@
 #include "../include/bindings.h"
 
+#include <cmath>
+
 #include "../include/common.h"
 #include "../include/embind_constant.h"
 #include "../include/simulation.h"
 
 #pragma warning(disable : 4100)
+#ifndef EMSCRIPTEN
+NativeCallbacks native_callbacks;
+#endif
+
 void DpsUpdate(double dps) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({event : "dpsUpdate", data : {dps : $0}})}, dps);
+  MAIN_THREAD_EM_ASM({postMessage({event : "dpsUpdate", data : {dps : $0}})}, dps);
 #endif
 }
 
 void ErrorCallback(const char* error_msg) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({event : "errorCallback", data : {errorMsg : UTF8ToString($0)}})}, error_msg);
+  MAIN_THREAD_EM_ASM({postMessage({event : "errorCallback", data : {errorMsg : UTF8ToString($0)}})}, error_msg);
 #endif
 }
 
-void PostCombatLogBreakdownVector(const char* name, double mana_gain, double damage) {
+void PostCombatLogBreakdownVector(const char* name, double mana_gain, double damage, int item_id,
+                                  const char* custom_stat) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({event : "combatLogVector", data : {name : UTF8ToString($0), manaGain : $1, damage : $2}})}, name,
-         mana_gain, damage);
+  MAIN_THREAD_EM_ASM({postMessage({
+                       event : "combatLogVector",
+                       data : {
+                         name : UTF8ToString($0),
+                         manaGain : $1,
+                         damage : $2,
+                         itemId : $3,
+                         customStat : UTF8ToString($4)
+                       }
+                     })},
+                     name, mana_gain, damage, item_id, custom_stat);
 #endif
 }
 
 void PostCombatLogBreakdown(const char* name, uint32_t casts, uint32_t crits, uint32_t misses, uint32_t count,
-                            double uptime, uint32_t dodges, uint32_t glancing_blows) {
+                            double uptime, uint32_t dodges, uint32_t glancing_blows, int item_id,
+                            const char* custom_stat) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({
-           event : "combatLogBreakdown",
-           data : {
-             name : UTF8ToString($0),
-             casts : $1,
-             crits : $2,
-             misses : $3,
-             count : $4,
-             uptime : $5,
-             dodges : $6,
-             glancingBlows : $7,
-             damage : 0,
-             manaGain : 0
-           }
-         })},
-         name, casts, crits, misses, count, uptime, dodges, glancing_blows);
+  MAIN_THREAD_EM_ASM({postMessage({
+                       event : "combatLogBreakdown",
+                       data : {
+                         name : UTF8ToString($0),
+                         casts : $1,
+                         crits : $2,
+                         misses : $3,
+                         count : $4,
+                         uptime : $5,
+                         dodges : $6,
+                         glancingBlows : $7,
+                         damage : 0,
+                         manaGain : 0,
+                         itemId : $8,
+                         customStat : UTF8ToString($9)
+                       }
+                     })},
+                     name, casts, crits, misses, count, uptime, dodges, glancing_blows, item_id, custom_stat);
 #endif
 }
 
+void SendCombatLogBreakdown(const std::vector<CombatLogBreakdown>& breakdown, int item_id, const char* custom_stat) {
+  for (const auto& kRow : breakdown) {
+    if (kRow.iteration_damage > 0 || kRow.iteration_mana_gain > 0) {
+      PostCombatLogBreakdownVector(kRow.name.c_str(), kRow.iteration_mana_gain, kRow.iteration_damage, item_id,
+                                   custom_stat);
+    }
+
+    PostCombatLogBreakdown(kRow.name.c_str(), kRow.casts, kRow.crits, kRow.misses, kRow.count, kRow.uptime,
+                           kRow.dodge, kRow.glancing_blows, item_id, custom_stat);
+  }
+}
+
 void CombatLogUpdate(const char* combat_log_entry) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({event : "combatLogUpdate", data : {combatLogEntry : UTF8ToString($0)}})}, combat_log_entry);
+  MAIN_THREAD_EM_ASM({postMessage({event : "combatLogUpdate", data : {combatLogEntry : UTF8ToString($0)}})},
+                     combat_log_entry);
 #else
   std::cout << combat_log_entry << std::endl;
 #endif
@@ -56,11 +88,17 @@ void CombatLogUpdate(const char* combat_log_entry) {
 
 void SimulationUpdate(int iteration, int iteration_amount, double median_dps, int item_id, const char* custom_stat) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({
-           event : "update",
-           data : {medianDps : $0, iteration : $1, iterationAmount : $2, itemId : $3, customStat : UTF8ToString($4)}
-         })},
-         median_dps, iteration, iteration_amount, item_id, custom_stat);
+  MAIN_THREAD_EM_ASM({postMessage({
+                       event : "update",
+                       data : {
+                         medianDps : $0,
+                         iteration : $1,
+                         iterationAmount : $2,
+                         itemId : $3,
+                         customStat : UTF8ToString($4)
+                       }
+                     })},
+                     median_dps, iteration, iteration_amount, item_id, custom_stat);
 #else
   /*std::cout << "Iteration: " << std::to_string(iteration) << "/" << std::to_string(iteration_amount)
             << ". Median DPS: " << std::to_string(median_dps) << std::endl;*/
@@ -68,38 +106,60 @@ void SimulationUpdate(int iteration, int iteration_amount, double median_dps, in
 }
 
 void SendSimulationResults(double median_dps, double min_dps, double max_dps, int item_id, int iteration_amount,
-                           int total_fight_duration, const char* custom_stat, long long simulation_duration) {
+                           int effective_iterations, double confidence_interval, int total_fight_duration,
+                           const char* custom_stat, long long simulation_duration) {
 #ifdef EMSCRIPTEN
-  EM_ASM({postMessage({
-           event : "end",
-           data : {
-             medianDps : $0,
-             minDps : $1,
-             maxDps : $2,
-             itemId : $3,
-             iterationAmount : $4,
-             totalDuration : $5,
-             customStat : UTF8ToString($6)
-           }
-         })},
-         median_dps, min_dps, max_dps, item_id, iteration_amount, total_fight_duration, custom_stat);
+  MAIN_THREAD_EM_ASM({postMessage({
+                       event : "end",
+                       data : {
+                         medianDps : $0,
+                         minDps : $1,
+                         maxDps : $2,
+                         itemId : $3,
+                         iterationAmount : $4,
+                         confidenceInterval : $5,
+                         totalDuration : $6,
+                         customStat : UTF8ToString($7),
+                         effectiveIterations : $8
+                       }
+                     })},
+                     median_dps, min_dps, max_dps, item_id, iteration_amount, confidence_interval,
+                     total_fight_duration, custom_stat, effective_iterations);
 #else
+  if (native_callbacks.simulation_results) {
+    native_callbacks.simulation_results(median_dps, min_dps, max_dps, item_id, iteration_amount, effective_iterations,
+                                        confidence_interval, total_fight_duration, custom_stat, simulation_duration);
+    return;
+  }
+
   std::cout << "Median DPS: " << std::to_string(median_dps) << ". Min DPS: " << std::to_string(min_dps)
-            << ". Max DPS: " << std::to_string(max_dps) << std::endl;
+            << ". Max DPS: " << std::to_string(max_dps) << ". Mean DPS 95% confidence interval: +/- "
+            << std::to_string(confidence_interval) << std::endl;
   std::cout << std::to_string(iteration_amount) << " iterations in "
             << DoubleToString(round(simulation_duration / 1000) / 1000, 3) << " seconds" << std::endl;
+  if (effective_iterations > 0 && effective_iterations != iteration_amount) {
+    std::cout << "The standard error is that of " << std::to_string(effective_iterations) << " independent iterations"
+              << std::endl;
+  }
 #endif
 }
 
-std::vector<uint32_t> AllocRandomSeeds(int amount_of_seeds, uint32_t rand_seed) {
-  srand(rand_seed);
-  std::vector<uint32_t> seeds(amount_of_seeds);
-
-  for (int i = 0; i < amount_of_seeds; i++) {
-    seeds[i] = rand();
+void SendStatWeightResult(const char* custom_stat, double dps_difference, double standard_error) {
+#ifdef EMSCRIPTEN
+  MAIN_THREAD_EM_ASM({postMessage({
+                       event : "statWeight",
+                       data : {customStat : UTF8ToString($0), dpsDifference : $1, standardError : $2}
+                     })},
+                     custom_stat, dps_difference, standard_error);
+#else
+  if (native_callbacks.stat_weight_result) {
+    native_callbacks.stat_weight_result(custom_stat, dps_difference, standard_error);
+    return;
   }
 
-  return seeds;
+  std::cout << custom_stat << ": " << std::to_string(dps_difference) << " +/- " << std::to_string(standard_error)
+            << " dps" << std::endl;
+#endif
 }
 
 Items AllocItems() { return Items(); }
@@ -112,6 +172,10 @@ Sets AllocSets() { return Sets(); }
 
 CharacterStats AllocStats() { return CharacterStats(); }
 
+ItemCandidate AllocItemCandidate() { return ItemCandidate(); }
+
+std::vector<ItemCandidate> AllocItemCandidates() { return std::vector<ItemCandidate>(); }
+
 PlayerSettings AllocPlayerSettings(AuraSelection& auras, Talents& talents, Sets& sets, CharacterStats& stats,
                                    Items& items) {
   return PlayerSettings(auras, talents, sets, stats, items);
@@ -135,7 +199,15 @@ EMSCRIPTEN_BINDINGS(module) {
 
   emscripten::class_<Simulation>("Simulation")
       .constructor<Player&, SimulationSettings&>()
-      .function("start", &Simulation::Start);
+      .function("start", &Simulation::Start)
+      .function("startAllItems", &Simulation::StartAllItems);
+
+  emscripten::class_<ItemCandidate>("ItemCandidate")
+      .property("itemId", &ItemCandidate::item_id)
+      .property("metaGemId", &ItemCandidate::meta_gem_id)
+      .property("items", &ItemCandidate::items)
+      .property("sets", &ItemCandidate::sets)
+      .property("stats", &ItemCandidate::stats);
 
   emscripten::class_<Items>("Items")
       .property("head", &Items::head)
@@ -307,7 +379,7 @@ EMSCRIPTEN_BINDINGS(module) {
 
   emscripten::class_<PlayerSettings>("PlayerSettings")
       .constructor<AuraSelection&, Talents&, Sets&, CharacterStats&, Items&>()
-      .property("randomSeeds", &PlayerSettings::random_seeds)
+      .property("randomSeed", &PlayerSettings::random_seed)
       .property("itemId", &PlayerSettings::item_id)
       .property("metaGemId", &PlayerSettings::meta_gem_id)
       .property("equippedItemSimulation", &PlayerSettings::equipped_item_simulation)
@@ -375,7 +447,15 @@ EMSCRIPTEN_BINDINGS(module) {
       .property("iterations", &SimulationSettings::iterations)
       .property("minTime", &SimulationSettings::min_time)
       .property("maxTime", &SimulationSettings::max_time)
-      .property("simulationType", &SimulationSettings::simulation_type);
+      .property("simulationType", &SimulationSettings::simulation_type)
+      .property("threads", &SimulationSettings::threads)
+      .property("statWeightIncrease", &SimulationSettings::stat_weight_increase)
+      .property("approximateMedian", &SimulationSettings::approximate_median)
+      .property("targetStandardError", &SimulationSettings::target_standard_error)
+      .property("relativeStandardError", &SimulationSettings::relative_standard_error)
+      .property("minIterations", &SimulationSettings::min_iterations)
+      .property("racing", &SimulationSettings::racing)
+      .property("antitheticVariates", &SimulationSettings::antithetic_variates);
 
   emscripten::enum_<SimulationType>("SimulationType")
       .value("normal", SimulationType::kNormal)
@@ -414,12 +494,13 @@ EMSCRIPTEN_BINDINGS(module) {
       .value("passive", EmbindConstant::kPassive)
       .value("aggressive", EmbindConstant::kAggressive);
 
-  emscripten::function("allocRandomSeeds", &AllocRandomSeeds);
   emscripten::function("allocItems", &AllocItems);
   emscripten::function("allocAuras", &AllocAuras);
   emscripten::function("allocTalents", &AllocTalents);
   emscripten::function("allocSets", &AllocSets);
   emscripten::function("allocStats", &AllocStats);
+  emscripten::function("allocItemCandidate", &AllocItemCandidate);
+  emscripten::function("allocItemCandidates", &AllocItemCandidates);
   emscripten::function("allocPlayerSettings", &AllocPlayerSettings);
   emscripten::function("allocPlayer", &AllocPlayer);
   emscripten::function("allocSimSettings", &AllocSimSettings);
@@ -427,6 +508,7 @@ EMSCRIPTEN_BINDINGS(module) {
   emscripten::function("getExceptionMessage", &GetExceptionMessage);
 
   emscripten::register_vector<uint32_t>("vector<uint32_t>");
+  emscripten::register_vector<ItemCandidate>("vector<ItemCandidate>");
 }
 #endif
 
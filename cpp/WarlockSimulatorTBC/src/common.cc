@@ -3,10 +3,193 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
 
+void RunningStatistics::Add(double value) {
+  const double kDelta = value - mean;
+
+  count++;
+  mean += kDelta / count;
+  sum_of_squares += kDelta * (value - mean);
+}
+
+void RunningStatistics::Add(const RunningStatistics& other) {
+  if (other.count == 0) {
+    return;
+  }
+  if (count == 0) {
+    *this = other;
+    return;
+  }
+
+  const double kDelta = other.mean - mean;
+  const int kCount = count + other.count;
+
+  mean += kDelta * other.count / kCount;
+  sum_of_squares += other.sum_of_squares + kDelta * kDelta * count * other.count / kCount;
+  count = kCount;
+}
+
+double RunningStatistics::Variance() const { return count > 1 ? sum_of_squares / (count - 1) : 0; }
+
+// Of the mean
+double RunningStatistics::StandardError() const { return count > 1 ? std::sqrt(Variance() / count) : 0; }
+
+// Half the width of the 95% confidence interval of the mean
+double RunningStatistics::ConfidenceInterval() const { return ConfidenceInterval(1.96); }
+
+double RunningStatistics::ConfidenceInterval(double z) const { return z * StandardError(); }
+
+FightTime SecondsToFightTime(double seconds) { return std::llround(seconds * kFightTimePerSecond); }
+
+double FightTimeToSeconds(FightTime fight_time) { return static_cast<double>(fight_time) / kFightTimePerSecond; }
+
+const std::string& SpellIdToName(SpellId id) {
+  static const std::string kNoName;
+
+  switch (id) {
+    case SpellId::kShadowBolt:
+      return SpellName::kShadowBolt;
+    case SpellId::kLifeTap:
+      return SpellName::kLifeTap;
+    case SpellId::kIncinerate:
+      return SpellName::kIncinerate;
+    case SpellId::kSearingPain:
+      return SpellName::kSearingPain;
+    case SpellId::kCorruption:
+      return SpellName::kCorruption;
+    case SpellId::kImmolate:
+      return SpellName::kImmolate;
+    case SpellId::kUnstableAffliction:
+      return SpellName::kUnstableAffliction;
+    case SpellId::kSiphonLife:
+      return SpellName::kSiphonLife;
+    case SpellId::kCurseOfDoom:
+      return SpellName::kCurseOfDoom;
+    case SpellId::kCurseOfAgony:
+      return SpellName::kCurseOfAgony;
+    case SpellId::kCurseOfTheElements:
+      return SpellName::kCurseOfTheElements;
+    case SpellId::kCurseOfRecklessness:
+      return SpellName::kCurseOfRecklessness;
+    case SpellId::kSoulFire:
+      return SpellName::kSoulFire;
+    case SpellId::kShadowburn:
+      return SpellName::kShadowburn;
+    case SpellId::kDeathCoil:
+      return SpellName::kDeathCoil;
+    case SpellId::kShadowfury:
+      return SpellName::kShadowfury;
+    case SpellId::kSeedOfCorruption:
+      return SpellName::kSeedOfCorruption;
+    case SpellId::kConflagrate:
+      return SpellName::kConflagrate;
+    case SpellId::kDestructionPotion:
+      return SpellName::kDestructionPotion;
+    case SpellId::kFlameCap:
+      return SpellName::kFlameCap;
+    case SpellId::kBloodFury:
+      return SpellName::kBloodFury;
+    case SpellId::kBloodlust:
+      return SpellName::kBloodlust;
+    case SpellId::kDrumsOfBattle:
+      return SpellName::kDrumsOfBattle;
+    case SpellId::kDrumsOfWar:
+      return SpellName::kDrumsOfWar;
+    case SpellId::kDrumsOfRestoration:
+      return SpellName::kDrumsOfRestoration;
+    case SpellId::kTimbalsFocusingCrystal:
+      return SpellName::kTimbalsFocusingCrystal;
+    case SpellId::kMarkOfDefiance:
+      return SpellName::kMarkOfDefiance;
+    case SpellId::kTheLightningCapacitor:
+      return SpellName::kTheLightningCapacitor;
+    case SpellId::kBladeOfWizardry:
+      return SpellName::kBladeOfWizardry;
+    case SpellId::kShatteredSunPendantOfAcumenAldor:
+      return SpellName::kShatteredSunPendantOfAcumenAldor;
+    case SpellId::kShatteredSunPendantOfAcumenScryers:
+      return SpellName::kShatteredSunPendantOfAcumenScryers;
+    case SpellId::kRobeOfTheElderScribes:
+      return SpellName::kRobeOfTheElderScribes;
+    case SpellId::kQuagmirransEye:
+      return SpellName::kQuagmirransEye;
+    case SpellId::kShiffarsNexusHorn:
+      return SpellName::kShiffarsNexusHorn;
+    case SpellId::kSextantOfUnstableCurrents:
+      return SpellName::kSextantOfUnstableCurrents;
+    case SpellId::kBandOfTheEternalSage:
+      return SpellName::kBandOfTheEternalSage;
+    case SpellId::kMysticalSkyfireDiamond:
+      return SpellName::kMysticalSkyfireDiamond;
+    case SpellId::kInsightfulEarthstormDiamond:
+      return SpellName::kInsightfulEarthstormDiamond;
+    case SpellId::kAmplifyCurse:
+      return SpellName::kAmplifyCurse;
+    case SpellId::kPowerInfusion:
+      return SpellName::kPowerInfusion;
+    case SpellId::kInnervate:
+      return SpellName::kInnervate;
+    case SpellId::kChippedPowerCore:
+      return SpellName::kChippedPowerCore;
+    case SpellId::kCrackedPowerCore:
+      return SpellName::kCrackedPowerCore;
+    case SpellId::kNightfall:
+      return SpellName::kNightfall;
+    case SpellId::kManaTideTotem:
+      return SpellName::kManaTideTotem;
+    case SpellId::kJudgementOfWisdom:
+      return SpellName::kJudgementOfWisdom;
+    case SpellId::kFlameshadow:
+      return SpellName::kFlameshadow;
+    case SpellId::kShadowflame:
+      return SpellName::kShadowflame;
+    case SpellId::kSpellstrike:
+      return SpellName::kSpellstrike;
+    case SpellId::kManaEtched4Set:
+      return SpellName::kManaEtched4Set;
+    case SpellId::kAshtongueTalismanOfShadows:
+      return SpellName::kAshtongueTalismanOfShadows;
+    case SpellId::kWrathOfCenarius:
+      return SpellName::kWrathOfCenarius;
+    case SpellId::kDarkmoonCardCrusade:
+      return SpellName::kDarkmoonCardCrusade;
+    case SpellId::kDarkPact:
+      return SpellName::kDarkPact;
+    case SpellId::kSuperManaPotion:
+      return SpellName::kSuperManaPotion;
+    case SpellId::kDemonicRune:
+      return SpellName::kDemonicRune;
+    case SpellId::kFirebolt:
+      return SpellName::kFirebolt;
+    case SpellId::kDemonicFrenzy:
+      return SpellName::kDemonicFrenzy;
+    case SpellId::kLashOfPain:
+      return SpellName::kLashOfPain;
+    case SpellId::kMelee:
+      return SpellName::kMelee;
+    case SpellId::kCleave:
+      return SpellName::kCleave;
+    case SpellId::kBlackBook:
+      return SpellName::kBlackBook;
+    case SpellId::kBattleSquawk:
+      return SpellName::kBattleSquawk;
+    case SpellId::kImprovedShadowBolt:
+      return SpellName::kImprovedShadowBolt;
+    case SpellId::kEyeOfMagtheridon:
+      return SpellName::kEyeOfMagtheridon;
+    case SpellId::kAirmansRibbonOfGallantry:
+      return SpellName::kAirmansRibbonOfGallantry;
+    case SpellId::kFelEnergy:
+      return SpellName::kFelEnergy;
+    default:
+      return kNoName;
+  }
+}
+
 double Median(std::vector<double> vec) {
   size_t size = vec.size();
 
@@ -22,6 +205,24 @@ double Median(std::vector<double> vec) {
   }
 }
 
+// Bisects the cumulative distribution function, which is 0.5 * erfc(-x / sqrt(2))
+double StandardNormalQuantile(double probability) {
+  auto lower = -40.0;
+  auto upper = 40.0;
+
+  for (int i = 0; i < 100; i++) {
+    const double kMiddle = (lower + upper) / 2;
+
+    if (0.5 * std::erfc(-kMiddle / std::sqrt(2.0)) < probability) {
+      lower = kMiddle;
+    } else {
+      upper = kMiddle;
+    }
+  }
+
+  return (lower + upper) / 2;
+}
+
 std::string DoubleToString(double num, int decimal_places) {
   auto str = std::to_string(num);
   return str.substr(0, str.find(".") + (decimal_places > 0 ? decimal_places + 1 : 0));
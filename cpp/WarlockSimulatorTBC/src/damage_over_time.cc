@@ -1,44 +1,51 @@
 #include "../include/damage_over_time.h"
 
+#include <cmath>
+
 #include "../include/common.h"
 #include "../include/player.h"
 
-DamageOverTime::DamageOverTime(Player& player) : player(player) {}
+// Dots tick after the other auras that run out at the same time have faded, so a buff that fades on the same
+// microsecond as a tick doesn't count for it
+DamageOverTime::DamageOverTime(Player& player) : Aura(player), player(player) { timer_priority = 1; }
 
 void DamageOverTime::Setup() {
   original_duration = duration;
 
   // T4 4pc
-  if ((name == SpellName::kCorruption || name == SpellName::kImmolate) && player.sets.t4 >= 4) {
+  if ((id == SpellId::kCorruption || id == SpellId::kImmolate) && player.sets.t4 >= 4) {
     duration += 3;
   }
 
-  ticks_total = duration / tick_timer_total;
+  Aura::Setup();
 
-  if (player.recording_combat_log_breakdown && player.combat_log_breakdown.count(name) == 0) {
-    player.combat_log_breakdown.insert({name, std::make_unique<CombatLogBreakdown>(name)});
+  if (id == SpellId::kCorruption) {
+    // Keyed on Nightfall so that it doesn't share the stream of Corruption's own proc rolls
+    player.AddRngStream(nightfall_rng, EntityType::kPlayer, SpellId::kNightfall, RollType::kProc);
+    nightfall_threshold = Rng::ChanceThreshold(player.talents.nightfall * 2);
   }
-
-  player.dot_list.push_back(this);
 }
 
-void DamageOverTime::Apply() {
-  if (active && player.ShouldWriteToCombatLog()) {
-    auto msg = name + " refreshed before letting it expire";
-  } else if (!active && player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->applied_at = player.simulation->current_fight_time;
+void DamageOverTime::Apply(NotWritingCombatLog combat_log) { Apply<>(combat_log); }
+
+void DamageOverTime::Apply(WritingCombatLog combat_log) { Apply<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void DamageOverTime::Apply(CombatLogPolicy combat_log) {
+  if (!active && player.recording_combat_log_breakdown) {
+    player.combat_log_breakdown[breakdown_index].applied_at = FightTimeToSeconds(player.simulation->current_fight_time);
   }
   const bool kIsAlreadyActive = active;
   spell_power = player.GetSpellPower(true, school);
 
   active = true;
-  tick_timer_remaining = tick_timer_total;
-  ticks_remaining = ticks_total;
+  player.active_auras.Add(this);
+  StartTimer();
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->count++;
+    player.combat_log_breakdown[breakdown_index].count++;
   }
-  if (player.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     auto msg = name + " ";
 
     if (kIsAlreadyActive) {
@@ -54,36 +61,21 @@ void DamageOverTime::Apply() {
   // Siphon Life snapshots the presence of ISB. So if ISB isn't up when it's
   // Cast, it doesn't get the benefit even if it comes up later during the
   // duration.
-  if (name == SpellName::kSiphonLife) {
+  if (id == SpellId::kSiphonLife) {
     isb_is_active = !player.settings.using_custom_isb_uptime && player.auras.improved_shadow_bolt != NULL &&
                     player.auras.improved_shadow_bolt->active;
   }
   // Amplify Curse
-  if ((name == SpellName::kCurseOfAgony || name == SpellName::kCurseOfDoom) && player.auras.amplify_curse != NULL &&
+  if ((id == SpellId::kCurseOfAgony || id == SpellId::kCurseOfDoom) && player.auras.amplify_curse != NULL &&
       player.auras.amplify_curse->active) {
     applied_with_amplify_curse = true;
-    player.auras.amplify_curse->Fade();
+    player.auras.amplify_curse->Fade(combat_log);
   } else {
     applied_with_amplify_curse = false;
   }
 }
 
-void DamageOverTime::Fade() {
-  active = false;
-  tick_timer_remaining = 0;
-  ticks_remaining = 0;
-
-  if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->uptime +=
-        player.simulation->current_fight_time - player.combat_log_breakdown.at(name)->applied_at;
-  }
-
-  if (player.ShouldWriteToCombatLog()) {
-    player.CombatLog(name + " faded");
-  }
-}
-
-std::vector<double> DamageOverTime::GetConstantDamage() {
+ConstantDamage DamageOverTime::GetConstantDamage() {
   auto current_spell_power = active ? spell_power : player.GetSpellPower(true, school);
   auto modifier = player.GetDamageModifier(*parent_spell, true);
   auto partial_resist_multiplier = player.GetPartialResistMultiplier(school);
@@ -93,7 +85,7 @@ std::vector<double> DamageOverTime::GetConstantDamage() {
     dmg *= 1.5;
   }
   // Add the t5 4pc bonus modifier to the base damage
-  if ((name == SpellName::kCorruption || name == SpellName::kImmolate) && player.sets.t5 >= 4) {
+  if ((id == SpellId::kCorruption || id == SpellId::kImmolate) && player.sets.t5 >= 4) {
     dmg *= t5_bonus_modifier;
   }
 
@@ -101,17 +93,17 @@ std::vector<double> DamageOverTime::GetConstantDamage() {
   total_damage += current_spell_power * coefficient;
   total_damage *= modifier * partial_resist_multiplier;
 
-  return std::vector<double>{dmg, total_damage, current_spell_power, modifier, partial_resist_multiplier};
+  return ConstantDamage(dmg, total_damage, current_spell_power, modifier, partial_resist_multiplier);
 }
 
 double DamageOverTime::PredictDamage() {
-  auto damage = GetConstantDamage()[1];
+  auto damage = GetConstantDamage().damage;
   // If it's Corruption or Immolate then divide by the original duration (18s
   // and 15s) and multiply by the durationTotal property This is just for the t4
   // 4pc bonus since their durationTotal property is increased by 3 seconds to
   // include another tick but the damage they do stays the same which assumes
   // the normal duration without the bonus
-  if (name == SpellName::kCorruption || name == SpellName::kImmolate) {
+  if (id == SpellId::kCorruption || id == SpellId::kImmolate) {
     damage /= original_duration;
     damage *= duration;
   }
@@ -119,59 +111,58 @@ double DamageOverTime::PredictDamage() {
   return damage;
 }
 
-void DamageOverTime::Tick(double t) {
-  tick_timer_remaining -= t;
-
-  if (tick_timer_remaining <= 0) {
-    std::vector<double> constant_damage = GetConstantDamage();
-    const double kBaseDamage = constant_damage[0];
-    const double kDamage = constant_damage[1] / (original_duration / tick_timer_total);
-    const double kSpellPower = constant_damage[2];
-    const double kModifier = constant_damage[3];
-    const double kPartialResistMultiplier = constant_damage[4];
-
-    // Check for Nightfall proc
-    if (name == SpellName::kCorruption && player.talents.nightfall > 0) {
-      if (player.RollRng(player.talents.nightfall * 2)) {
-        player.auras.shadow_trance->Apply();
-      }
-    }
+void DamageOverTime::OnTick(NotWritingCombatLog combat_log) { OnTick<>(combat_log); }
 
-    player.iteration_damage += kDamage;
-    ticks_remaining--;
-    tick_timer_remaining = tick_timer_total;
+void DamageOverTime::OnTick(WritingCombatLog combat_log) { OnTick<>(combat_log); }
 
-    if (player.recording_combat_log_breakdown) {
-      player.combat_log_breakdown.at(name)->iteration_damage += kDamage;
-    }
+template <typename CombatLogPolicy>
+void DamageOverTime::OnTick(CombatLogPolicy combat_log) {
+  const ConstantDamage kConstantDamage = GetConstantDamage();
+  const double kBaseDamage = kConstantDamage.base_damage;
+  const double kDamage = kConstantDamage.damage / (original_duration / tick_timer_total);
+  const double kSpellPower = kConstantDamage.spell_power;
+  const double kModifier = kConstantDamage.modifier;
+  const double kPartialResistMultiplier = kConstantDamage.partial_resist_multiplier;
 
-    if (player.ShouldWriteToCombatLog()) {
-      auto msg = name + " Tick " + DoubleToString(round(kDamage)) + " (" + DoubleToString(kBaseDamage) +
-                 " Base Damage - " + DoubleToString(kSpellPower) + " Spell Power - " + DoubleToString(coefficient, 3) +
-                 " Coefficient - " + DoubleToString(round(kModifier * 10000) / 100, 3) + "% Damage Modifier - " +
-                 DoubleToString(round(kPartialResistMultiplier * 1000) / 10) + "% Partial Resist Multiplier";
-      if (t5_bonus_modifier > 1) {
-        msg += " - " + DoubleToString(round(t5_bonus_modifier * 10000) / 100, 3) + "% Base Dmg Modifier (T5 4pc bonus)";
-      }
-      msg += ")";
-
-      player.CombatLog(msg);
+  // Check for Nightfall proc
+  if (id == SpellId::kCorruption && player.talents.nightfall > 0) {
+    if (nightfall_rng.Roll(nightfall_threshold)) {
+      player.auras.shadow_trance->Apply(combat_log);
     }
+  }
 
-    for (auto& proc : player.on_dot_tick_procs) {
-      if (proc->Ready() && proc->ShouldProc(this) && player.RollRng(proc->proc_chance)) {
-        proc->StartCast();
-      }
+  player.iteration_damage += kDamage;
+
+  if (player.recording_combat_log_breakdown) {
+    player.combat_log_breakdown[breakdown_index].iteration_damage += kDamage;
+  }
+
+  if constexpr (CombatLogPolicy::kWriting) {
+    auto msg = name + " Tick " + DoubleToString(round(kDamage)) + " (" + DoubleToString(kBaseDamage) +
+               " Base Damage - " + DoubleToString(kSpellPower) + " Spell Power - " + DoubleToString(coefficient, 3) +
+               " Coefficient - " + DoubleToString(round(kModifier * 10000) / 100, 3) + "% Damage Modifier - " +
+               DoubleToString(round(kPartialResistMultiplier * 1000) / 10) + "% Partial Resist Multiplier";
+    if (t5_bonus_modifier > 1) {
+      msg += " - " + DoubleToString(round(t5_bonus_modifier * 10000) / 100, 3) + "% Base Dmg Modifier (T5 4pc bonus)";
     }
+    msg += ")";
+
+    player.CombatLog(msg);
+  }
 
-    if (ticks_remaining <= 0) {
-      Fade();
+  for (auto& proc : player.on_dot_tick_procs) {
+    if (proc->Ready() && proc->ShouldProc(this) && proc->proc_rng.Roll(proc->proc_threshold)) {
+      proc->StartCast(combat_log);
     }
   }
 }
 
+double DamageOverTime::GetTickTimerRemaining() {
+  return FightTimeToSeconds(next_tick_at - player.simulation->current_fight_time);
+}
+
 CorruptionDot::CorruptionDot(Player& player) : DamageOverTime(player) {
-  name = SpellName::kCorruption;
+  id = SpellId::kCorruption;
   duration = 18;
   tick_timer_total = 3;
   base_damage = 900;
@@ -181,13 +172,18 @@ CorruptionDot::CorruptionDot(Player& player) : DamageOverTime(player) {
   Setup();
 }
 
-void CorruptionDot::Apply() {
+void CorruptionDot::Apply(NotWritingCombatLog combat_log) { Apply<>(combat_log); }
+
+void CorruptionDot::Apply(WritingCombatLog combat_log) { Apply<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void CorruptionDot::Apply(CombatLogPolicy combat_log) {
   t5_bonus_modifier = 1;
-  DamageOverTime::Apply();
+  DamageOverTime::Apply(combat_log);
 }
 
 UnstableAfflictionDot::UnstableAfflictionDot(Player& player) : DamageOverTime(player) {
-  name = SpellName::kUnstableAffliction;
+  id = SpellId::kUnstableAffliction;
   duration = 18;
   tick_timer_total = 3;
   base_damage = 1050;
@@ -197,7 +193,7 @@ UnstableAfflictionDot::UnstableAfflictionDot(Player& player) : DamageOverTime(pl
 }
 
 SiphonLifeDot::SiphonLifeDot(Player& player) : DamageOverTime(player) {
-  name = SpellName::kSiphonLife;
+  id = SpellId::kSiphonLife;
   duration = 30;
   tick_timer_total = 3;
   base_damage = 630;
@@ -207,7 +203,7 @@ SiphonLifeDot::SiphonLifeDot(Player& player) : DamageOverTime(player) {
 }
 
 ImmolateDot::ImmolateDot(Player& player) : DamageOverTime(player) {
-  name = SpellName::kImmolate;
+  id = SpellId::kImmolate;
   duration = 15;
   tick_timer_total = 3;
   base_damage = 615;
@@ -217,13 +213,18 @@ ImmolateDot::ImmolateDot(Player& player) : DamageOverTime(player) {
   Setup();
 }
 
-void ImmolateDot::Apply() {
+void ImmolateDot::Apply(NotWritingCombatLog combat_log) { Apply<>(combat_log); }
+
+void ImmolateDot::Apply(WritingCombatLog combat_log) { Apply<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void ImmolateDot::Apply(CombatLogPolicy combat_log) {
   t5_bonus_modifier = 1;
-  DamageOverTime::Apply();
+  DamageOverTime::Apply(combat_log);
 }
 
 CurseOfAgonyDot::CurseOfAgonyDot(Player& player) : DamageOverTime(player) {
-  name = SpellName::kCurseOfAgony;
+  id = SpellId::kCurseOfAgony;
   duration = 24;
   tick_timer_total = 3;
   base_damage = 1356;
@@ -233,7 +234,7 @@ CurseOfAgonyDot::CurseOfAgonyDot(Player& player) : DamageOverTime(player) {
 }
 
 CurseOfDoomDot::CurseOfDoomDot(Player& player) : DamageOverTime(player) {
-  name = SpellName::kCurseOfDoom;
+  id = SpellId::kCurseOfDoom;
   duration = 60;
   tick_timer_total = 60;
   base_damage = 4200;
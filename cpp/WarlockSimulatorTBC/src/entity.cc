@@ -1,5 +1,7 @@
 #include "../include/entity.h"
 
+#include <cmath>
+
 #include "../include/bindings.h"
 #include "../include/common.h"
 #include "../include/sets.h"
@@ -10,11 +12,11 @@ Entity::Entity(Player* player, PlayerSettings& player_settings, EntityType entit
       entity_type(entity_type),
       stats(entity_type == EntityType::kPlayer ? player_settings.stats : CharacterStats()),
       settings(player_settings),
-      recording_combat_log_breakdown(player_settings.recording_combat_log_breakdown &&
-                                     player_settings.equipped_item_simulation),
+      recording_combat_log_breakdown(player_settings.recording_combat_log_breakdown),
       equipped_item_simulation(player_settings.equipped_item_simulation),
       enemy_shadow_resist(player_settings.enemy_shadow_resist),
       enemy_fire_resist(player_settings.enemy_fire_resist),
+      enemy_armor(player_settings.enemy_armor),
       // I don't know if this formula only works for bosses or not, so for the
       // moment I'm only using it for targets 3+ levels above.
       enemy_level_difference_resistance(player_settings.enemy_level >= (kLevel + 3) ? (6 * kLevel * 5) / 75 : 0) {
@@ -111,56 +113,59 @@ Entity::Entity(Player* player, PlayerSettings& player_settings, EntityType entit
   }
 }
 
-void Entity::PostIterationDamageAndMana(const std::string& spell_name) {
-  PostCombatLogBreakdownVector(spell_name.c_str(), combat_log_breakdown.at(spell_name)->iteration_mana_gain,
-                               combat_log_breakdown.at(spell_name)->iteration_damage);
-  combat_log_breakdown.at(spell_name)->iteration_damage = 0;
-  combat_log_breakdown.at(spell_name)->iteration_mana_gain = 0;
+int Entity::AddCombatLogBreakdownRow(const std::string& breakdown_name) {
+  for (int i = 0; i < static_cast<int>(combat_log_breakdown.size()); i++) {
+    if (combat_log_breakdown[i].name == breakdown_name) {
+      return i;
+    }
+  }
+
+  combat_log_breakdown.push_back(CombatLogBreakdown(breakdown_name));
+  return static_cast<int>(combat_log_breakdown.size()) - 1;
 }
 
-void Entity::EndAuras() {
-  for (auto& aura : aura_list) {
-    if (aura->active) {
-      aura->Fade();
-    }
+void Entity::TakeCombatLogBreakdown(std::vector<CombatLogBreakdown>& totals) {
+  for (auto& breakdown : combat_log_breakdown) {
+    totals.push_back(breakdown);
+    breakdown = CombatLogBreakdown(breakdown.name);
+  }
+}
+
+void Entity::EndAuras(NotWritingCombatLog combat_log) { EndAuras<>(combat_log); }
+
+void Entity::EndAuras(WritingCombatLog combat_log) { EndAuras<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void Entity::EndAuras(CombatLogPolicy combat_log) {
+  while (!active_auras.items.empty()) {
+    active_auras.items.back()->Fade(combat_log);
   }
 }
 
 void Entity::Reset() {
   cast_time_remaining = 0;
   gcd_remaining = 0;
-  mp5_timer_remaining = 5;
-  five_second_rule_timer_remaining = 5;
+  mp5_timer_remaining = 5 * kFightTimePerSecond;
+  five_second_rule_timer_remaining = 5 * kFightTimePerSecond;
+  casting_spell = NULL;
+  InvalidateDerivedStats();
 
-  for (auto& spell : spell_list) {
-    spell->Reset();
+  while (!active_spells.items.empty()) {
+    active_spells.items.back()->Reset();
   }
 }
 
 void Entity::Initialize(Simulation* simulationPtr) { simulation = simulationPtr; }
 
-void Entity::SendCombatLogBreakdown() {
-  for (auto& breakdown : combat_log_breakdown) {
-    if (breakdown.second->iteration_damage > 0 || breakdown.second->iteration_mana_gain > 0) {
-      PostIterationDamageAndMana(breakdown.first);
-    }
-
-    PostCombatLogBreakdown(breakdown.second->name.c_str(), breakdown.second->casts, breakdown.second->crits,
-                           breakdown.second->misses, breakdown.second->count, breakdown.second->uptime,
-                           breakdown.second->dodge, breakdown.second->glancing_blows);
-  }
-}
-
 double Entity::GetStamina() { return stats.stamina * stats.stamina_modifier; }
 
 double Entity::GetIntellect() { return stats.intellect * stats.intellect_modifier; }
 
 double Entity::GetSpirit() { return stats.spirit * stats.spirit_modifier; }
 
-bool Entity::ShouldWriteToCombatLog() { return simulation->iteration == 10 && equipped_item_simulation; }
-
 void Entity::CombatLog(const std::string& entry) {
-  player->combat_log_entries.push_back("|" + DoubleToString(simulation->current_fight_time, 4) + "| " + entry);
+  player->combat_log_entries.push_back("|" + DoubleToString(FightTimeToSeconds(simulation->current_fight_time), 4) +
+                                       "| " + entry);
 }
 
 double Entity::GetMultiplicativeDamageModifier(Spell& spell, bool) {
@@ -179,7 +184,7 @@ double Entity::GetMultiplicativeDamageModifier(Spell& spell, bool) {
   return damage_modifier;
 }
 
-double Entity::FindTimeUntilNextAction() {
+FightTime Entity::FindTimeUntilNextAction() {
   auto time = cast_time_remaining;
 
   if (time <= 0) {
@@ -194,34 +199,22 @@ double Entity::FindTimeUntilNextAction() {
     time = five_second_rule_timer_remaining;
   }
 
-  for (auto& spell : spell_list) {
-    if (spell->cooldown_remaining < time && spell->cooldown_remaining > 0) {
-      time = spell->cooldown_remaining;
-    }
-  }
-
-  for (auto& aura : aura_list) {
-    if (aura->active && aura->has_duration) {
-      if (aura->duration_remaining < time) {
-        time = aura->duration_remaining;
-      }
+  // Aura durations, aura and dot ticks and spell cooldowns
+  for (const auto& kTimerQueue : {&aura_timers, &spell_timers}) {
+    const FightTime kTimeUntilNextTimer = FindTimeUntilNextTimer(*kTimerQueue);
 
-      if (aura->tick_timer_remaining > 0 && aura->tick_timer_remaining < time) {
-        time = aura->tick_timer_remaining;
-      }
-    }
-  }
-
-  // TODO make DamageOverTime inherit from Aura and combine dot_list and aura_list
-  for (auto& dot : dot_list) {
-    if (dot->active && dot->tick_timer_remaining < time) {
-      time = dot->tick_timer_remaining;
+    if (kTimeUntilNextTimer < time) {
+      time = kTimeUntilNextTimer;
     }
   }
 
   return time;
 }
 
+FightTime Entity::FindTimeUntilNextTimer(const TimerQueue& timer_queue) {
+  return timer_queue.NextTime() - simulation->current_fight_time;
+}
+
 double Entity::GetPartialResistMultiplier(SpellSchool school) {
   auto enemy_resist = 0;
 
@@ -267,15 +260,16 @@ double Entity::GetBaseSpellHitChance(int entity_level, int enemy_level) {
   }
 }
 
-bool Entity::IsSpellCrit(SpellType spell_type, double extra_crit) {
-  return player->RollRng(GetSpellCritChance(spell_type) + extra_crit);
-}
-
-bool Entity::IsMeleeCrit() { return player->RollRng(GetMeleeCritChance()); }
+void Entity::InvalidateDerivedStats() {
+  stats_version++;
 
-bool Entity::IsMeleeHit() { return player->RollRng(stats.melee_hit_chance); }
-
-bool Entity::IsSpellHit(SpellType spell_type) { return player->RollRng(GetSpellHitChance(spell_type)); }
+  if (pet != NULL) {
+    pet->stats_version++;
+  }
+  if (player != NULL) {
+    player->stats_version++;
+  }
+}
 
 double Entity::GetMeleeCritChance() {
   return pet->GetAgility() * 0.04 + 0.65 + stats.melee_crit_chance - StatConstant::kMeleeCritChanceSuppression;
@@ -285,38 +279,33 @@ double Entity::GetCustomImprovedShadowBoltDamageModifier() {
   return 1 + 0.2 * (settings.custom_isb_uptime_value / 100.0);
 }
 
-void Entity::Tick(double time) {
+void Entity::Tick(NotWritingCombatLog combat_log, FightTime time) { Tick<>(combat_log, time); }
+
+void Entity::Tick(WritingCombatLog combat_log, FightTime time) { Tick<>(combat_log, time); }
+
+template <typename CombatLogPolicy>
+void Entity::Tick(CombatLogPolicy combat_log, FightTime time) {
   cast_time_remaining -= time;
   gcd_remaining -= time;
   five_second_rule_timer_remaining -= time;
   mp5_timer_remaining -= time;
 
+  const FightTime kCurrentFightTime = simulation->current_fight_time;
+  int timer;
+
   // Auras need to tick before Spells because otherwise you'll, for example,
   // finish casting Corruption and then immediately afterwards, in the same
   // millisecond, immediately tick down the aura This was also causing buffs like
   // e.g. the t4 4pc buffs to expire sooner than they should.
-  for (auto& aura : aura_list) {
-    if (aura->active && aura->duration_remaining > 0) {
-      aura->Tick(time);
-    }
+  while ((timer = aura_timers.PopDue(kCurrentFightTime)) != -1) {
+    aura_list[timer]->Tick(combat_log);
   }
 
-  for (auto& dot : dot_list) {
-    if (dot->active && dot->tick_timer_remaining > 0) {
-      dot->Tick(time);
-    }
+  while ((timer = spell_timers.PopDue(kCurrentFightTime)) != -1) {
+    spell_list[timer]->OffCooldown(combat_log);
   }
 
-  // TLC needs to tick before other spells because otherwise a spell might proc TLC and then later in the same loop,
-  // during the same millisecond of the fight, tick down TLC's cooldown
-  // TODO find a better solution for this since this might occur for other spells as well.
-  if (spells.the_lightning_capacitor != NULL && spells.the_lightning_capacitor->cooldown_remaining > 0) {
-    spells.the_lightning_capacitor->Tick(time);
-  }
-
-  for (auto& spell : spell_list) {
-    if (spell->name != SpellName::kTheLightningCapacitor && (spell->cooldown_remaining > 0 || spell->casting)) {
-      spell->Tick(time);
-    }
+  if (casting_spell != NULL && cast_time_remaining <= 0) {
+    casting_spell->Cast(combat_log);
   }
 }
\ No newline at end of file
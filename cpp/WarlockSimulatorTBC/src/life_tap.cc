@@ -4,7 +4,7 @@
 #include "../include/player.h"
 
 LifeTap::LifeTap(Entity& entity) : Spell(entity) {
-  name = SpellName::kLifeTap;
+  id = SpellId::kLifeTap;
   mana_return = 582;
   coefficient = 0.8;
   modifier = 1 * (1 + 0.1 * entity.player->talents.improved_life_tap);
@@ -16,7 +16,12 @@ double LifeTap::ManaGain() {
   return (mana_return + ((entity.GetSpellPower(false, spell_school)) * coefficient)) * modifier;
 }
 
-void LifeTap::Cast() {
+void LifeTap::Cast(NotWritingCombatLog combat_log) { Cast<>(combat_log); }
+
+void LifeTap::Cast(WritingCombatLog combat_log) { Cast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void LifeTap::Cast(CombatLogPolicy) {
   const double kCurrentPlayerMana = entity.stats.mana;
   const double kManaGain = this->ManaGain();
 
@@ -24,10 +29,10 @@ void LifeTap::Cast() {
   const double kManaGained = entity.stats.mana - kCurrentPlayerMana;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->casts++;
-    entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
+    entity.combat_log_breakdown[breakdown_index].casts++;
+    entity.combat_log_breakdown[breakdown_index].iteration_mana_gain += kManaGained;
   }
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     entity.CombatLog(name + " " + DoubleToString(kManaGained) + " (" +
                      DoubleToString(entity.GetSpellPower(false, spell_school)) + " Spell Power - " +
                      DoubleToString(coefficient, 3) + " Coefficient - " + DoubleToString(modifier * 100, 2) +
@@ -44,19 +49,19 @@ void LifeTap::Cast() {
     entity.pet->stats.mana = std::min(kCurrentPetMana + (kManaGain * (entity.player->talents.mana_feed / 3.0)),
                                       entity.pet->CalculateMaxMana());
 
-    if (entity.ShouldWriteToCombatLog()) {
+    if constexpr (CombatLogPolicy::kWriting) {
       entity.CombatLog(entity.pet->name + " gains " + (DoubleToString(entity.pet->stats.mana - kCurrentPetMana)) +
                        " mana from Mana Feed");
     }
   }
 
-  if (name == SpellName::kDarkPact) {
+  if (id == SpellId::kDarkPact) {
     entity.pet->stats.mana = std::max(0.0, entity.pet->stats.mana - kManaGain);
   }
 }
 
 DarkPact::DarkPact(Entity& entity) : LifeTap(entity) {
-  name = SpellName::kDarkPact;
+  id = SpellId::kDarkPact;
   mana_return = 700;
   coefficient = 0.96;
   modifier = 1;
@@ -6,48 +6,31 @@
 
 ManaOverTime::ManaOverTime(Entity& entity) : Aura(entity) {}
 
-void ManaOverTime::Setup() {
-  ticks_total = duration / tick_timer_total;
-  Aura::Setup();
-}
-
-void ManaOverTime::Apply() {
-  Aura::Apply();
-  tick_timer_remaining = tick_timer_total;
-  ticks_remaining = ticks_total;
-}
+void ManaOverTime::OnTick(NotWritingCombatLog combat_log) { OnTick<>(combat_log); }
 
-void ManaOverTime::Tick(double t) {
-  tick_timer_remaining -= t;
+void ManaOverTime::OnTick(WritingCombatLog combat_log) { OnTick<>(combat_log); }
 
-  if (tick_timer_remaining <= 0) {
-    const double kCurrentMana = entity.stats.mana;
+template <typename CombatLogPolicy>
+void ManaOverTime::OnTick(CombatLogPolicy) {
+  const double kCurrentMana = entity.stats.mana;
 
-    entity.stats.mana = std::min(entity.stats.max_mana, entity.stats.mana + GetManaGain());
-    const double kManaGained = entity.stats.mana - kCurrentMana;
+  entity.stats.mana = std::min(entity.stats.max_mana, entity.stats.mana + GetManaGain());
+  const double kManaGained = entity.stats.mana - kCurrentMana;
 
-    if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(entity.name + " gains " + DoubleToString(kManaGained) + " mana from " + name + " (" +
-                       DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana) + ")" + ")");
-    }
-
-    if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->casts++;
-      entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
-    }
-    // todo pet
-
-    ticks_remaining--;
-    tick_timer_remaining = tick_timer_total;
+  if constexpr (CombatLogPolicy::kWriting) {
+    entity.CombatLog(entity.name + " gains " + DoubleToString(kManaGained) + " mana from " + name + " (" +
+                     DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana) + ")" + ")");
+  }
 
-    if (ticks_remaining <= 0) {
-      Aura::Fade();
-    }
+  if (entity.recording_combat_log_breakdown) {
+    entity.combat_log_breakdown[breakdown_index].casts++;
+    entity.combat_log_breakdown[breakdown_index].iteration_mana_gain += kManaGained;
   }
+  // todo pet
 }
 
 DrumsOfRestorationAura::DrumsOfRestorationAura(Entity& entity) : ManaOverTime(entity) {
-  name = SpellName::kDrumsOfRestoration;
+  id = SpellId::kDrumsOfRestoration;
   duration = 15;
   tick_timer_total = 3;
   group_wide = true;
@@ -57,7 +40,7 @@ DrumsOfRestorationAura::DrumsOfRestorationAura(Entity& entity) : ManaOverTime(en
 double DrumsOfRestorationAura::GetManaGain() { return 600.0 / ticks_total; }
 
 ManaTideTotemAura::ManaTideTotemAura(Entity& entity) : ManaOverTime(entity) {
-  name = SpellName::kManaTideTotem;
+  id = SpellId::kManaTideTotem;
   duration = 12;
   tick_timer_total = 3;
   group_wide = true;
@@ -67,7 +50,7 @@ ManaTideTotemAura::ManaTideTotemAura(Entity& entity) : ManaOverTime(entity) {
 double ManaTideTotemAura::GetManaGain() { return entity.stats.max_mana * 0.06; }
 
 FelEnergyAura::FelEnergyAura(Entity& entity) : ManaOverTime(entity) {
-  name = SpellName::kFelEnergy;
+  id = SpellId::kFelEnergy;
   duration = 9999;
   tick_timer_total = 4;
   Setup();
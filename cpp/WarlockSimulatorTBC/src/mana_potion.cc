@@ -1,5 +1,7 @@
 #include "../include/mana_potion.h"
 
+#include <cmath>
+
 #include "../include/common.h"
 #include "../include/player.h"
 
@@ -9,21 +11,26 @@ ManaPotion::ManaPotion(Player& player) : Spell(player) {
   on_gcd = false;
 }
 
-void ManaPotion::Cast() {
-  Spell::Cast();
+void ManaPotion::Cast(NotWritingCombatLog combat_log) { Cast<>(combat_log); }
+
+void ManaPotion::Cast(WritingCombatLog combat_log) { Cast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void ManaPotion::Cast(CombatLogPolicy combat_log) {
+  Spell::Cast(combat_log);
   const double kCurrentPlayerMana = entity.stats.mana;
   const double kManaGain = entity.player->settings.randomize_values && min_mana_gain > 0 && max_mana_gain > 0
-                               ? entity.player->rng.range(min_mana_gain, max_mana_gain)
+                               ? amount_rng.range(min_mana_gain, max_mana_gain)
                                : mana_gain;
 
   entity.stats.mana = std::min(entity.stats.max_mana, kCurrentPlayerMana + kManaGain);
   const double kManaGained = entity.stats.mana - kCurrentPlayerMana;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
+    entity.combat_log_breakdown[breakdown_index].iteration_mana_gain += kManaGained;
   }
 
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     entity.CombatLog("Player gains " + DoubleToString(kManaGained) + " mana from " + name + " (" +
                      DoubleToString(round(kCurrentPlayerMana)) + " -> " + DoubleToString(round(entity.stats.mana)) +
                      ")");
@@ -31,25 +38,30 @@ void ManaPotion::Cast() {
 }
 
 SuperManaPotion::SuperManaPotion(Player& player) : ManaPotion(player) {
-  name = SpellName::kSuperManaPotion;
+  id = SpellId::kSuperManaPotion;
   min_mana_gain = 1800;
   max_mana_gain = 3000;
   Setup();
 }
 
 DemonicRune::DemonicRune(Player& player) : ManaPotion(player) {
-  name = SpellName::kDemonicRune;
+  id = SpellId::kDemonicRune;
   min_mana_gain = 900;
   max_mana_gain = 1500;
   Setup();
 }
 
-void DemonicRune::Cast() {
-  ManaPotion::Cast();
+void DemonicRune::Cast(NotWritingCombatLog combat_log) { Cast<>(combat_log); }
+
+void DemonicRune::Cast(WritingCombatLog combat_log) { Cast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void DemonicRune::Cast(CombatLogPolicy combat_log) {
+  ManaPotion::Cast(combat_log);
   if (entity.player->spells.chipped_power_core != NULL) {
-    entity.player->spells.chipped_power_core->cooldown_remaining = cooldown;
+    entity.player->spells.chipped_power_core->StartCooldown(cooldown);
   }
   if (entity.player->spells.cracked_power_core != NULL) {
-    entity.player->spells.cracked_power_core->cooldown_remaining = cooldown;
+    entity.player->spells.cracked_power_core->StartCooldown(cooldown);
   }
 }
\ No newline at end of file
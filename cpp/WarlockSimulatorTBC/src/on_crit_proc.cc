@@ -2,7 +2,7 @@
 
 #include "../include/player.h"
 
-OnCritProc::OnCritProc(Player& player, std::shared_ptr<Aura> aura) : SpellProc(player, aura) { procs_on_crit = true; }
+OnCritProc::OnCritProc(Player& player, Aura* aura) : SpellProc(player, aura) { procs_on_crit = true; }
 
 void OnCritProc::Setup() {
   SpellProc::Setup();
@@ -12,17 +12,17 @@ void OnCritProc::Setup() {
   }
 }
 
-ImprovedShadowBolt::ImprovedShadowBolt(Player& player, std::shared_ptr<Aura> aura) : OnCritProc(player, aura) {
-  name = SpellName::kImprovedShadowBolt;
+ImprovedShadowBolt::ImprovedShadowBolt(Player& player, Aura* aura) : OnCritProc(player, aura) {
+  id = SpellId::kImprovedShadowBolt;
   proc_chance = 100;
   on_crit_procs_enabled = !player.settings.using_custom_isb_uptime && player.talents.improved_shadow_bolt > 0;
   Setup();
 }
 
-bool ImprovedShadowBolt::ShouldProc(Spell* spell) { return spell->name == SpellName::kShadowBolt; }
+bool ImprovedShadowBolt::ShouldProc(Spell* spell) { return spell->id == SpellId::kShadowBolt; }
 
 TheLightningCapacitor::TheLightningCapacitor(Player& player) : OnCritProc(player) {
-  name = SpellName::kTheLightningCapacitor;
+  id = SpellId::kTheLightningCapacitor;
   cooldown = 2.5;
   min_dmg = 694;
   max_dmg = 806;
@@ -33,28 +33,33 @@ TheLightningCapacitor::TheLightningCapacitor(Player& player) : OnCritProc(player
   Setup();
 }
 
-void TheLightningCapacitor::StartCast(double) {
-  if (cooldown_remaining <= 0) {
-    entity.player->auras.the_lightning_capacitor->Apply();
+void TheLightningCapacitor::StartCast(NotWritingCombatLog combat_log, double) { StartCast<>(combat_log); }
+
+void TheLightningCapacitor::StartCast(WritingCombatLog combat_log, double) { StartCast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void TheLightningCapacitor::StartCast(CombatLogPolicy combat_log) {
+  if (GetCooldownRemaining() <= 0) {
+    entity.player->auras.the_lightning_capacitor->Apply(combat_log);
     if (entity.player->auras.the_lightning_capacitor->stacks ==
         entity.player->auras.the_lightning_capacitor->max_stacks) {
-      Spell::StartCast();
-      entity.player->auras.the_lightning_capacitor->Fade();
+      Spell::StartCast(combat_log);
+      entity.player->auras.the_lightning_capacitor->Fade(combat_log);
     }
   }
 }
 
-ShiffarsNexusHorn::ShiffarsNexusHorn(Player& player, std::shared_ptr<Aura> aura) : OnCritProc(player, aura) {
-  name = SpellName::kShiffarsNexusHorn;
+ShiffarsNexusHorn::ShiffarsNexusHorn(Player& player, Aura* aura) : OnCritProc(player, aura) {
+  id = SpellId::kShiffarsNexusHorn;
   cooldown = 45;
   proc_chance = 20;
   is_item = true;
   Setup();
 }
 
-SextantOfUnstableCurrents::SextantOfUnstableCurrents(Player& player, std::shared_ptr<Aura> aura)
+SextantOfUnstableCurrents::SextantOfUnstableCurrents(Player& player, Aura* aura)
     : OnCritProc(player, aura) {
-  name = SpellName::kSextantOfUnstableCurrents;
+  id = SpellId::kSextantOfUnstableCurrents;
   cooldown = 45;
   proc_chance = 20;
   is_item = true;
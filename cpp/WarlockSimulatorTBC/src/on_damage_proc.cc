@@ -2,7 +2,7 @@
 
 #include "../include/player.h"
 
-OnDamageProc::OnDamageProc(Player& player, std::shared_ptr<Aura> aura) : SpellProc(player, aura) {
+OnDamageProc::OnDamageProc(Player& player, Aura* aura) : SpellProc(player, aura) {
   procs_on_damage = true;
 }
 
@@ -14,9 +14,9 @@ void OnDamageProc::Setup() {
   }
 }
 
-ShatteredSunPendantOfAcumenAldor::ShatteredSunPendantOfAcumenAldor(Player& player, std::shared_ptr<Aura> aura)
+ShatteredSunPendantOfAcumenAldor::ShatteredSunPendantOfAcumenAldor(Player& player, Aura* aura)
     : OnDamageProc(player, aura) {
-  name = SpellName::kShatteredSunPendantOfAcumenAldor;
+  id = SpellId::kShatteredSunPendantOfAcumenAldor;
   cooldown = 45;
   proc_chance = 15;
   is_item = true;
@@ -25,7 +25,7 @@ ShatteredSunPendantOfAcumenAldor::ShatteredSunPendantOfAcumenAldor(Player& playe
 }
 
 ShatteredSunPendantOfAcumenScryers::ShatteredSunPendantOfAcumenScryers(Player& player) : OnDamageProc(player) {
-  name = SpellName::kShatteredSunPendantOfAcumenScryers;
+  id = SpellId::kShatteredSunPendantOfAcumenScryers;
   cooldown = 45;
   proc_chance = 15;
   min_dmg = 333;
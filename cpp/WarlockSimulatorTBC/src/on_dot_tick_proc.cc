@@ -2,7 +2,7 @@
 
 #include "../include/player.h"
 
-OnDotTickProc::OnDotTickProc(Player& player, std::shared_ptr<Aura> aura) : SpellProc(player, aura) {
+OnDotTickProc::OnDotTickProc(Player& player, Aura* aura) : SpellProc(player, aura) {
   procs_on_dot_ticks = true;
 }
 
@@ -16,17 +16,17 @@ void OnDotTickProc::Setup() {
   }
 }
 
-AshtongueTalismanOfShadows::AshtongueTalismanOfShadows(Player& player, std::shared_ptr<Aura> aura)
+AshtongueTalismanOfShadows::AshtongueTalismanOfShadows(Player& player, Aura* aura)
     : OnDotTickProc(player, aura) {
-  name = SpellName::kAshtongueTalismanOfShadows;
+  id = SpellId::kAshtongueTalismanOfShadows;
   proc_chance = 20;
   Setup();
 }
 
-bool AshtongueTalismanOfShadows::ShouldProc(DamageOverTime* spell) { return spell->name == SpellName::kCorruption; }
+bool AshtongueTalismanOfShadows::ShouldProc(DamageOverTime* spell) { return spell->id == SpellId::kCorruption; }
 
 TimbalsFocusingCrystal::TimbalsFocusingCrystal(Player& player) : OnDotTickProc(player) {
-  name = SpellName::kTimbalsFocusingCrystal;
+  id = SpellId::kTimbalsFocusingCrystal;
   cooldown = 15;
   proc_chance = 10;
   min_dmg = 285;
@@ -2,7 +2,7 @@
 
 #include "../include/player.h"
 
-OnHitProc::OnHitProc(Entity& entity, std::shared_ptr<Aura> aura) : SpellProc(entity, aura) { procs_on_hit = true; }
+OnHitProc::OnHitProc(Entity& entity, Aura* aura) : SpellProc(entity, aura) { procs_on_hit = true; }
 
 void OnHitProc::Setup() {
   SpellProc::Setup();
@@ -13,7 +13,7 @@ void OnHitProc::Setup() {
 }
 
 MarkOfDefiance::MarkOfDefiance(Entity& entity) : OnHitProc(entity) {
-  name = SpellName::kMarkOfDefiance;
+  id = SpellId::kMarkOfDefiance;
   cooldown = 17;
   proc_chance = 15;
   is_item = true;
@@ -24,7 +24,7 @@ MarkOfDefiance::MarkOfDefiance(Entity& entity) : OnHitProc(entity) {
 }
 
 InsightfulEarthstormDiamond::InsightfulEarthstormDiamond(Entity& entity) : OnHitProc(entity) {
-  name = SpellName::kInsightfulEarthstormDiamond;
+  id = SpellId::kInsightfulEarthstormDiamond;
   cooldown = 15;
   proc_chance = 5;
   is_item = true;
@@ -33,40 +33,40 @@ InsightfulEarthstormDiamond::InsightfulEarthstormDiamond(Entity& entity) : OnHit
   Setup();
 }
 
-BladeOfWizardry::BladeOfWizardry(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kBladeOfWizardry;
+BladeOfWizardry::BladeOfWizardry(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kBladeOfWizardry;
   cooldown = 50;
   proc_chance = 15;
   is_item = true;
   Setup();
 }
 
-RobeOfTheElderScribes::RobeOfTheElderScribes(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kRobeOfTheElderScribes;
+RobeOfTheElderScribes::RobeOfTheElderScribes(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kRobeOfTheElderScribes;
   cooldown = 50;
   proc_chance = 20;
   is_item = true;
   Setup();
 }
 
-QuagmirransEye::QuagmirransEye(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kQuagmirransEye;
+QuagmirransEye::QuagmirransEye(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kQuagmirransEye;
   cooldown = 45;
   proc_chance = 10;
   is_item = true;
   Setup();
 }
 
-BandOfTheEternalSage::BandOfTheEternalSage(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kBandOfTheEternalSage;
+BandOfTheEternalSage::BandOfTheEternalSage(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kBandOfTheEternalSage;
   cooldown = 60;
   proc_chance = 10;
   is_item = true;
   Setup();
 }
 
-MysticalSkyfireDiamond::MysticalSkyfireDiamond(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kMysticalSkyfireDiamond;
+MysticalSkyfireDiamond::MysticalSkyfireDiamond(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kMysticalSkyfireDiamond;
   cooldown = 35;
   proc_chance = 15;
   is_item = true;
@@ -74,15 +74,15 @@ MysticalSkyfireDiamond::MysticalSkyfireDiamond(Entity& entity, std::shared_ptr<A
 }
 
 JudgementOfWisdom::JudgementOfWisdom(Entity& entity) : OnHitProc(entity) {
-  name = SpellName::kJudgementOfWisdom;
+  id = SpellId::kJudgementOfWisdom;
   mana_gain = 74;
   gain_mana_on_cast = true;
   proc_chance = 50;
   Setup();
 }
 
-Flameshadow::Flameshadow(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kFlameshadow;
+Flameshadow::Flameshadow(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kFlameshadow;
   proc_chance = 5;
   on_hit_procs_enabled = entity.player->sets.t4 >= 2;
   Setup();
@@ -90,8 +90,8 @@ Flameshadow::Flameshadow(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc
 
 bool Flameshadow::ShouldProc(Spell* spell) { return spell->spell_school == SpellSchool::kShadow; }
 
-Shadowflame::Shadowflame(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kShadowflame;
+Shadowflame::Shadowflame(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kShadowflame;
   proc_chance = 5;
   on_hit_procs_enabled = entity.player->sets.t4 >= 2;
   Setup();
@@ -99,34 +99,34 @@ Shadowflame::Shadowflame(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc
 
 bool Shadowflame::ShouldProc(Spell* spell) { return spell->spell_school == SpellSchool::kFire; }
 
-Spellstrike::Spellstrike(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kSpellstrike;
+Spellstrike::Spellstrike(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kSpellstrike;
   proc_chance = 5;
   on_hit_procs_enabled = entity.player->sets.spellstrike == 2;
   Setup();
 }
 
-ManaEtched4Set::ManaEtched4Set(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kManaEtched4Set;
+ManaEtched4Set::ManaEtched4Set(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kManaEtched4Set;
   proc_chance = 2;
   on_hit_procs_enabled = entity.player->sets.mana_etched >= 4;
   Setup();
 }
 
-WrathOfCenarius::WrathOfCenarius(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kWrathOfCenarius;
+WrathOfCenarius::WrathOfCenarius(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kWrathOfCenarius;
   proc_chance = 5;
   Setup();
 }
 
-DarkmoonCardCrusade::DarkmoonCardCrusade(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kDarkmoonCardCrusade;
+DarkmoonCardCrusade::DarkmoonCardCrusade(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kDarkmoonCardCrusade;
   proc_chance = 100;
   Setup();
 }
 
-DemonicFrenzy::DemonicFrenzy(Entity& entity, std::shared_ptr<Aura> aura) : OnHitProc(entity, aura) {
-  name = SpellName::kDemonicFrenzy;
+DemonicFrenzy::DemonicFrenzy(Entity& entity, Aura* aura) : OnHitProc(entity, aura) {
+  id = SpellId::kDemonicFrenzy;
   proc_chance = 100;
   Setup();
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include "../include/player.h"
 
-OnResistProc::OnResistProc(Player& player, std::shared_ptr<Aura> aura) : SpellProc(player, aura) {
+OnResistProc::OnResistProc(Player& player, Aura* aura) : SpellProc(player, aura) {
   procs_on_resist = true;
 }
 
@@ -14,8 +14,8 @@ void OnResistProc::Setup() {
   }
 }
 
-EyeOfMagtheridon::EyeOfMagtheridon(Player& player, std::shared_ptr<Aura> aura) : OnResistProc(player, aura) {
-  name = SpellName::kEyeOfMagtheridon;
+EyeOfMagtheridon::EyeOfMagtheridon(Player& player, Aura* aura) : OnResistProc(player, aura) {
+  id = SpellId::kEyeOfMagtheridon;
   proc_chance = 100;
   is_item = true;
   Setup();
@@ -1,5 +1,7 @@
 #include "../include/pet.h"
 
+#include <cmath>
+
 #include "../include/bindings.h"
 #include "../include/common.h"
 #include "../include/player.h"
@@ -44,29 +46,29 @@ Pet::Pet(Player& player, EmbindConstant selected_pet)
 
 void Pet::Initialize(Simulation* simulationPtr) {
   Entity::Initialize(simulationPtr);
-  pet = shared_from_this();
+  pet = this;
   Setup();
 
   if (pet_name == PetName::kImp) {
-    spells.firebolt = std::make_shared<ImpFirebolt>(*this);
+    spells.firebolt = player->arena.Create<ImpFirebolt>(*this);
   } else {
-    spells.melee = std::make_shared<PetMelee>(*this);
+    spells.melee = player->arena.Create<PetMelee>(*this);
 
     if (pet_name == PetName::kSuccubus) {
-      spells.lash_of_pain = std::make_shared<SuccubusLashOfPain>(*this);
+      spells.lash_of_pain = player->arena.Create<SuccubusLashOfPain>(*this);
     } else if (pet_name == PetName::kFelguard) {
-      spells.cleave = std::make_shared<FelguardCleave>(*this);
-      auras.demonic_frenzy = std::make_shared<DemonicFrenzyAura>(*this);
-      spells.demonic_frenzy = std::make_shared<DemonicFrenzy>(*this, auras.demonic_frenzy);
+      spells.cleave = player->arena.Create<FelguardCleave>(*this);
+      auras.demonic_frenzy = player->arena.Create<DemonicFrenzyAura>(*this);
+      spells.demonic_frenzy = player->arena.Create<DemonicFrenzy>(*this, auras.demonic_frenzy);
     }
 
     if (player->selected_auras.pet_battle_squawk) {
-      auras.battle_squawk = std::make_shared<BattleSquawkAura>(*this);
+      auras.battle_squawk = player->arena.Create<BattleSquawkAura>(*this);
     }
   }
 
   if (player->settings.prepop_black_book) {
-    auras.black_book = std::make_shared<BlackBookAura>(*this);
+    auras.black_book = player->arena.Create<BlackBookAura>(*this);
   }
 }
 
@@ -214,11 +216,11 @@ void Pet::CalculateStatsFromAuras() {
     enemy_damage_reduction_from_armor = 1.0;
 
     if (player->settings.enemy_level >= 60) {
-      enemy_damage_reduction_from_armor = 1 - player->settings.enemy_armor / (player->settings.enemy_armor - 22167.5 +
-                                                                              467.5 * player->settings.enemy_level);
+      enemy_damage_reduction_from_armor =
+          1 - player->enemy_armor / (player->enemy_armor - 22167.5 + 467.5 * player->settings.enemy_level);
     } else {
       enemy_damage_reduction_from_armor =
-          1 - player->settings.enemy_armor / (player->settings.enemy_armor + 400.0 + 85 * player->settings.enemy_level);
+          1 - player->enemy_armor / (player->enemy_armor + 400.0 + 85 * player->settings.enemy_level);
     }
 
     enemy_damage_reduction_from_armor = std::max(0.25, enemy_damage_reduction_from_armor);
@@ -237,7 +239,9 @@ double Pet::GetStamina() { return (stats.stamina + 0.3 * player->GetStamina()) *
 
 double Pet::GetIntellect() { return (stats.intellect + 0.3 * player->GetIntellect()) * stats.intellect_modifier; }
 
-double Pet::GetSpellPower(bool, SpellSchool) { return stats.spell_power + GetPlayerSpellPower() * 0.15; }
+double Pet::GetSpellPower(bool, SpellSchool) {
+  return cached_spell_power.Get(stats_version, [this] { return stats.spell_power + GetPlayerSpellPower() * 0.15; });
+}
 
 double Pet::CalculateMaxMana() {
   auto max_mana = GetIntellect();
@@ -279,7 +283,10 @@ double Pet::GetDamageModifier(Spell& spell, bool is_dot) {
   return additive_modifier * multiplicative_modifier;
 }
 
-double Pet::GetSpellCritChance(SpellType) { return (0.0125 * GetIntellect()) + 0.91 + stats.spell_crit_chance; }
+double Pet::GetSpellCritChance(SpellType) {
+  return cached_spell_crit_chance.Get(stats_version,
+                                      [this] { return (0.0125 * GetIntellect()) + 0.91 + stats.spell_crit_chance; });
+}
 
 double Pet::GetHastePercent() {
   if (pet_type == PetType::kMelee) {
@@ -290,6 +297,10 @@ double Pet::GetHastePercent() {
 }
 
 double Pet::GetAttackPower() {
+  return cached_attack_power.Get(stats_version, [this] { return CalculateAttackPower(); });
+}
+
+double Pet::CalculateAttackPower() {
   // Remove AP from debuffs on the boss before multiplying by the AP multiplier
   // since it doesn't affect those debuffs
   auto attack_power_from_debuffs = GetDebuffAttackPower();
@@ -323,13 +334,18 @@ double Pet::GetStrength() { return stats.strength * stats.strength_modifier; }
 
 double Pet::GetAgility() { return stats.agility * stats.agility_modifier; }
 
-void Pet::Tick(double t) {
-  Entity::Tick(t);
+void Pet::Tick(NotWritingCombatLog combat_log, FightTime t) { Tick<>(combat_log, t); }
+
+void Pet::Tick(WritingCombatLog combat_log, FightTime t) { Tick<>(combat_log, t); }
+
+template <typename CombatLogPolicy>
+void Pet::Tick(CombatLogPolicy combat_log, FightTime t) {
+  Entity::Tick(combat_log, t);
 
   // MP5
   if (mp5_timer_remaining <= 0) {
     auto mana_gain = stats.mp5;
-    mp5_timer_remaining = 5;
+    mp5_timer_remaining = 5 * kFightTimePerSecond;
 
     // Formulas from Max on the warlock discord
     // https://discord.com/channels/253210018697052162/823476479550816266/836007015762886707
@@ -355,9 +371,11 @@ void Pet::Tick(double t) {
 
     auto current_mana = stats.mana;
     stats.mana = std::min(CalculateMaxMana(), stats.mana + static_cast<int>(mana_gain));
-    if (stats.mana > current_mana && ShouldWriteToCombatLog()) {
-      CombatLog(name + " gains " + DoubleToString(round(mana_gain)) + " mana from Mp5/Spirit regeneration (" +
-                DoubleToString(round(current_mana)) + " -> " + DoubleToString(stats.mana) + ")");
+    if constexpr (CombatLogPolicy::kWriting) {
+      if (stats.mana > current_mana) {
+        CombatLog(name + " gains " + DoubleToString(round(mana_gain)) + " mana from Mp5/Spirit regeneration (" +
+                  DoubleToString(round(current_mana)) + " -> " + DoubleToString(stats.mana) + ")");
+      }
     }
   }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 #include "../include/bindings.h"
 #include "../include/common.h"
 #include "../include/damage_over_time.h"
@@ -20,7 +22,7 @@ Player::Player(PlayerSettings& player_settings)
   infinite_mana = player_settings.infinite_player_mana;
 
   if (recording_combat_log_breakdown) {
-    combat_log_breakdown.insert({StatName::kMp5, std::make_unique<CombatLogBreakdown>(StatName::kMp5)});
+    mp5_breakdown_index = AddCombatLogBreakdownRow(StatName::kMp5);
   }
 
   if (settings.custom_stat == EmbindConstant::kStamina)
@@ -83,21 +85,21 @@ Player::Player(PlayerSettings& player_settings)
 
   // Enemy Armor Reduction
   if (selected_auras.faerie_fire) {
-    settings.enemy_armor -= 610;
+    enemy_armor -= 610;
   }
   if ((selected_auras.sunder_armor && selected_auras.expose_armor && settings.improved_expose_armor == 2) ||
       (selected_auras.expose_armor && !selected_auras.sunder_armor)) {
-    settings.enemy_armor -= static_cast<int>(2050 * (1 + 0.25 * settings.improved_expose_armor));
+    enemy_armor -= static_cast<int>(2050 * (1 + 0.25 * settings.improved_expose_armor));
   } else if (selected_auras.sunder_armor) {
-    settings.enemy_armor -= 520 * 5;
+    enemy_armor -= 520 * 5;
   }
   if (selected_auras.curse_of_recklessness) {
-    settings.enemy_armor -= 800;
+    enemy_armor -= 800;
   }
   if (selected_auras.annihilator) {
-    settings.enemy_armor -= 600;
+    enemy_armor -= 600;
   }
-  settings.enemy_armor = std::max(0, settings.enemy_armor);
+  enemy_armor = std::max(0, enemy_armor);
 
   // Health & Mana
   stats.health = (stats.health + GetStamina() * StatConstant::kHealthPerStamina) *
@@ -111,11 +113,11 @@ void Player::Initialize(Simulation* simulationPtr) {
   player = this;
 
   if (!settings.sacrificing_pet || talents.demonic_sacrifice == 0) {
-    pet = std::make_shared<Pet>(*this, settings.selected_pet);
+    pet = arena.Create<Pet>(*this, settings.selected_pet);
     pet->Initialize(simulationPtr);
   } else if (talents.demonic_sacrifice == 1 && settings.sacrificing_pet &&
              settings.selected_pet == EmbindConstant::kFelhunter) {
-    auras.fel_energy = std::make_shared<FelEnergyAura>(*this);
+    auras.fel_energy = arena.Create<FelEnergyAura>(*this);
   }
 
   std::vector<int> equipped_trinket_ids{items.trinket_1, items.trinket_2};
@@ -169,223 +171,224 @@ void Player::Initialize(Simulation* simulationPtr) {
       equipped_trinket_ids.end())
     trinkets.push_back(HazzarahsCharmOfDestruction(*this));
 
+  for (auto& trinket : trinkets) {
+    trinket.duration_timer = trinket_timers.Add();
+    trinket.cooldown_timer = trinket_timers.Add();
+  }
+
   // Auras
   if (settings.fight_type == EmbindConstant::kSingleTarget) {
-    if (talents.improved_shadow_bolt > 0) auras.improved_shadow_bolt = std::make_shared<ImprovedShadowBoltAura>(*this);
+    if (talents.improved_shadow_bolt > 0) auras.improved_shadow_bolt = arena.Create<ImprovedShadowBoltAura>(*this);
     if (settings.has_corruption || settings.rotation_option == EmbindConstant::kSimChooses)
-      auras.corruption = std::make_shared<CorruptionDot>(*this);
+      auras.corruption = arena.Create<CorruptionDot>(*this);
     if (talents.unstable_affliction == 1 &&
         (settings.has_unstable_affliction || settings.rotation_option == EmbindConstant::kSimChooses))
-      auras.unstable_affliction = std::make_shared<UnstableAfflictionDot>(*this);
+      auras.unstable_affliction = arena.Create<UnstableAfflictionDot>(*this);
     if (talents.siphon_life == 1 &&
         (settings.has_siphon_life || settings.rotation_option == EmbindConstant::kSimChooses))
-      auras.siphon_life = std::make_shared<SiphonLifeDot>(*this);
+      auras.siphon_life = arena.Create<SiphonLifeDot>(*this);
     if (settings.has_immolate || settings.rotation_option == EmbindConstant::kSimChooses)
-      auras.immolate = std::make_shared<ImmolateDot>(*this);
+      auras.immolate = arena.Create<ImmolateDot>(*this);
     if (settings.has_curse_of_agony || settings.has_curse_of_doom)
-      auras.curse_of_agony = std::make_shared<CurseOfAgonyDot>(*this);
-    if (settings.has_curse_of_the_elements)
-      auras.curse_of_the_elements = std::make_shared<CurseOfTheElementsAura>(*this);
-    if (settings.has_curse_of_recklessness)
-      auras.curse_of_recklessness = std::make_shared<CurseOfRecklessnessAura>(*this);
-    if (settings.has_curse_of_doom) auras.curse_of_doom = std::make_shared<CurseOfDoomDot>(*this);
-    if (talents.nightfall > 0) auras.shadow_trance = std::make_shared<ShadowTranceAura>(*this);
+      auras.curse_of_agony = arena.Create<CurseOfAgonyDot>(*this);
+    if (settings.has_curse_of_the_elements) auras.curse_of_the_elements = arena.Create<CurseOfTheElementsAura>(*this);
+    if (settings.has_curse_of_recklessness) auras.curse_of_recklessness = arena.Create<CurseOfRecklessnessAura>(*this);
+    if (settings.has_curse_of_doom) auras.curse_of_doom = arena.Create<CurseOfDoomDot>(*this);
+    if (talents.nightfall > 0) auras.shadow_trance = arena.Create<ShadowTranceAura>(*this);
     if (talents.amplify_curse == 1 &&
         (settings.has_amplify_curse || settings.rotation_option == EmbindConstant::kSimChooses))
-      auras.amplify_curse = std::make_shared<AmplifyCurseAura>(*this);
+      auras.amplify_curse = arena.Create<AmplifyCurseAura>(*this);
   }
   if (selected_auras.airmans_ribbon_of_gallantry)
-    auras.airmans_ribbon_of_gallantry = std::make_shared<AirmansRibbonOfGallantryAura>(*this);
-  if (selected_auras.mana_tide_totem) auras.mana_tide_totem = std::make_shared<ManaTideTotemAura>(*this);
-  if (selected_auras.chipped_power_core) auras.chipped_power_core = std::make_shared<ChippedPowerCoreAura>(*this);
-  if (selected_auras.cracked_power_core) auras.cracked_power_core = std::make_shared<CrackedPowerCoreAura>(*this);
-  if (selected_auras.power_infusion) auras.power_infusion = std::make_shared<PowerInfusionAura>(*this);
-  if (selected_auras.innervate) auras.innervate = std::make_shared<InnervateAura>(*this);
-  if (selected_auras.bloodlust) auras.bloodlust = std::make_shared<BloodlustAura>(*this);
-  if (selected_auras.destruction_potion) auras.destruction_potion = std::make_shared<DestructionPotionAura>(*this);
-  if (selected_auras.flame_cap) auras.flame_cap = std::make_shared<FlameCapAura>(*this);
-  if (settings.race == EmbindConstant::kOrc) auras.blood_fury = std::make_shared<BloodFuryAura>(*this);
+    auras.airmans_ribbon_of_gallantry = arena.Create<AirmansRibbonOfGallantryAura>(*this);
+  if (selected_auras.mana_tide_totem) auras.mana_tide_totem = arena.Create<ManaTideTotemAura>(*this);
+  if (selected_auras.chipped_power_core) auras.chipped_power_core = arena.Create<ChippedPowerCoreAura>(*this);
+  if (selected_auras.cracked_power_core) auras.cracked_power_core = arena.Create<CrackedPowerCoreAura>(*this);
+  if (selected_auras.power_infusion) auras.power_infusion = arena.Create<PowerInfusionAura>(*this);
+  if (selected_auras.innervate) auras.innervate = arena.Create<InnervateAura>(*this);
+  if (selected_auras.bloodlust) auras.bloodlust = arena.Create<BloodlustAura>(*this);
+  if (selected_auras.destruction_potion) auras.destruction_potion = arena.Create<DestructionPotionAura>(*this);
+  if (selected_auras.flame_cap) auras.flame_cap = arena.Create<FlameCapAura>(*this);
+  if (settings.race == EmbindConstant::kOrc) auras.blood_fury = arena.Create<BloodFuryAura>(*this);
   if (selected_auras.drums_of_battle)
-    auras.drums_of_battle = std::make_shared<DrumsOfBattleAura>(*this);
+    auras.drums_of_battle = arena.Create<DrumsOfBattleAura>(*this);
   else if (selected_auras.drums_of_war)
-    auras.drums_of_war = std::make_shared<DrumsOfWarAura>(*this);
+    auras.drums_of_war = arena.Create<DrumsOfWarAura>(*this);
   else if (selected_auras.drums_of_restoration)
-    auras.drums_of_restoration = std::make_shared<DrumsOfRestorationAura>(*this);
-  if (items.main_hand == ItemId::kBladeOfWizardry)
-    auras.blade_of_wizardry = std::make_shared<BladeOfWizardryAura>(*this);
+    auras.drums_of_restoration = arena.Create<DrumsOfRestorationAura>(*this);
+  if (items.main_hand == ItemId::kBladeOfWizardry) auras.blade_of_wizardry = arena.Create<BladeOfWizardryAura>(*this);
   if (items.neck == ItemId::kShatteredSunPendantOfAcumen && settings.exalted_with_shattrath_faction) {
     if (settings.shattrath_faction == EmbindConstant::kAldor)
-      auras.shattered_sun_pendant_of_acumen_aldor = std::make_shared<ShatteredSunPendantOfAcumenAldorAura>(*this);
+      auras.shattered_sun_pendant_of_acumen_aldor = arena.Create<ShatteredSunPendantOfAcumenAldorAura>(*this);
     else if (settings.shattrath_faction == EmbindConstant::kScryers)
-      spells.shattered_sun_pendant_of_acumen_scryers = std::make_shared<ShatteredSunPendantOfAcumenScryers>(*this);
+      spells.shattered_sun_pendant_of_acumen_scryers = arena.Create<ShatteredSunPendantOfAcumenScryers>(*this);
   }
   if (items.chest == ItemId::kRobeOfTheElderScribes)
-    auras.robe_of_the_elder_scribes = std::make_shared<RobeOfTheElderScribesAura>(*this);
+    auras.robe_of_the_elder_scribes = arena.Create<RobeOfTheElderScribesAura>(*this);
   if (settings.meta_gem_id == ItemId::kMysticalSkyfireDiamond)
-    auras.mystical_skyfire_diamond = std::make_shared<MysticalSkyfireDiamondAura>(*this);
+    auras.mystical_skyfire_diamond = arena.Create<MysticalSkyfireDiamondAura>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kEyeOfMagtheridon) !=
       equipped_trinket_ids.end()) {
-    auras.eye_of_magtheridon = std::make_shared<EyeOfMagtheridonAura>(*this);
-    spells.eye_of_magtheridon = std::make_shared<EyeOfMagtheridon>(*this, auras.eye_of_magtheridon);
+    auras.eye_of_magtheridon = arena.Create<EyeOfMagtheridonAura>(*this);
+    spells.eye_of_magtheridon = arena.Create<EyeOfMagtheridon>(*this, auras.eye_of_magtheridon);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kAshtongueTalismanOfShadows) !=
       equipped_trinket_ids.end())
-    auras.ashtongue_talisman_of_shadows = std::make_shared<AshtongueTalismanOfShadowsAura>(*this);
+    auras.ashtongue_talisman_of_shadows = arena.Create<AshtongueTalismanOfShadowsAura>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kDarkmoonCardCrusade) !=
       equipped_trinket_ids.end())
-    auras.darkmoon_card_crusade = std::make_shared<DarkmoonCardCrusadeAura>(*this);
+    auras.darkmoon_card_crusade = arena.Create<DarkmoonCardCrusadeAura>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kTheLightningCapacitor) !=
       equipped_trinket_ids.end())
-    auras.the_lightning_capacitor = std::make_shared<TheLightningCapacitorAura>(*this);
+    auras.the_lightning_capacitor = arena.Create<TheLightningCapacitorAura>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kQuagmirransEye) !=
       equipped_trinket_ids.end())
-    auras.quagmirrans_eye = std::make_shared<QuagmirransEyeAura>(*this);
+    auras.quagmirrans_eye = arena.Create<QuagmirransEyeAura>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kShiffarsNexusHorn) !=
       equipped_trinket_ids.end())
-    auras.shiffars_nexus_horn = std::make_shared<ShiffarsNexusHornAura>(*this);
+    auras.shiffars_nexus_horn = arena.Create<ShiffarsNexusHornAura>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kSextantOfUnstableCurrents) !=
       equipped_trinket_ids.end())
-    auras.sextant_of_unstable_currents = std::make_shared<SextantOfUnstableCurrentsAura>(*this);
+    auras.sextant_of_unstable_currents = arena.Create<SextantOfUnstableCurrentsAura>(*this);
   if (std::find(equipped_ring_ids.begin(), equipped_ring_ids.end(), ItemId::kBandOfTheEternalSage) !=
       equipped_ring_ids.end())
-    auras.band_of_the_eternal_sage = std::make_shared<BandOfTheEternalSageAura>(*this);
+    auras.band_of_the_eternal_sage = arena.Create<BandOfTheEternalSageAura>(*this);
   if (std::find(equipped_ring_ids.begin(), equipped_ring_ids.end(), ItemId::kWrathOfCenarius) !=
       equipped_ring_ids.end())
-    auras.wrath_of_cenarius = std::make_shared<WrathOfCenariusAura>(*this);
+    auras.wrath_of_cenarius = arena.Create<WrathOfCenariusAura>(*this);
   if (sets.t4 >= 2) {
-    auras.flameshadow = std::make_shared<FlameshadowAura>(*this);
-    auras.shadowflame = std::make_shared<ShadowflameAura>(*this);
+    auras.flameshadow = arena.Create<FlameshadowAura>(*this);
+    auras.shadowflame = arena.Create<ShadowflameAura>(*this);
   }
-  if (sets.spellstrike >= 2) auras.spellstrike = std::make_shared<SpellstrikeAura>(*this);
-  if (sets.mana_etched >= 4) auras.mana_etched_4_set = std::make_shared<ManaEtched4SetAura>(*this);
+  if (sets.spellstrike >= 2) auras.spellstrike = arena.Create<SpellstrikeAura>(*this);
+  if (sets.mana_etched >= 4) auras.mana_etched_4_set = arena.Create<ManaEtched4SetAura>(*this);
 
   // Spells
-  spells.life_tap = std::make_shared<LifeTap>(*this);
+  spells.life_tap = arena.Create<LifeTap>(*this);
   if (settings.fight_type == EmbindConstant::kAoe) {
-    spells.seed_of_corruption = std::make_shared<SeedOfCorruption>(*this);
+    spells.seed_of_corruption = arena.Create<SeedOfCorruption>(*this);
   } else {
     if (settings.has_shadow_bolt || talents.nightfall > 0 || settings.rotation_option == EmbindConstant::kSimChooses)
-      spells.shadow_bolt = std::make_shared<ShadowBolt>(*this);
+      spells.shadow_bolt = arena.Create<ShadowBolt>(*this);
     if (settings.has_incinerate || settings.rotation_option == EmbindConstant::kSimChooses)
-      spells.incinerate = std::make_shared<Incinerate>(*this);
+      spells.incinerate = arena.Create<Incinerate>(*this);
     if (settings.has_searing_pain || settings.rotation_option == EmbindConstant::kSimChooses)
-      spells.searing_pain = std::make_shared<SearingPain>(*this);
+      spells.searing_pain = arena.Create<SearingPain>(*this);
     if (settings.has_death_coil || settings.rotation_option == EmbindConstant::kSimChooses)
-      spells.death_coil = std::make_shared<DeathCoil>(*this);
+      spells.death_coil = arena.Create<DeathCoil>(*this);
     if (talents.conflagrate == 1 &&
         (settings.has_conflagrate || settings.rotation_option == EmbindConstant::kSimChooses))
-      spells.conflagrate = std::make_shared<Conflagrate>(*this);
+      spells.conflagrate = arena.Create<Conflagrate>(*this);
     if (talents.shadowburn == 1 &&
         (settings.has_shadow_burn || settings.rotation_option == EmbindConstant::kSimChooses))
-      spells.shadowburn = std::make_shared<Shadowburn>(*this);
+      spells.shadowburn = arena.Create<Shadowburn>(*this);
     if (talents.shadowfury == 1 && (settings.has_shadowfury || settings.rotation_option == EmbindConstant::kSimChooses))
-      spells.shadowfury = std::make_shared<Shadowfury>(*this);
+      spells.shadowfury = arena.Create<Shadowfury>(*this);
     if (auras.corruption != NULL) {
-      spells.corruption = std::make_shared<Corruption>(*this, nullptr, auras.corruption);
+      spells.corruption = arena.Create<Corruption>(*this, nullptr, auras.corruption);
       auras.corruption->parent_spell = spells.corruption;
     }
     if (auras.unstable_affliction != NULL) {
-      spells.unstable_affliction = std::make_shared<UnstableAffliction>(*this, nullptr, auras.unstable_affliction);
+      spells.unstable_affliction = arena.Create<UnstableAffliction>(*this, nullptr, auras.unstable_affliction);
       auras.unstable_affliction->parent_spell = spells.unstable_affliction;
     }
     if (auras.siphon_life != NULL) {
-      spells.siphon_life = std::make_shared<SiphonLife>(*this, nullptr, auras.siphon_life);
+      spells.siphon_life = arena.Create<SiphonLife>(*this, nullptr, auras.siphon_life);
       auras.siphon_life->parent_spell = spells.siphon_life;
     }
     if (auras.immolate != NULL) {
-      spells.immolate = std::make_shared<Immolate>(*this, nullptr, auras.immolate);
+      spells.immolate = arena.Create<Immolate>(*this, nullptr, auras.immolate);
       auras.immolate->parent_spell = spells.immolate;
     }
     if (auras.curse_of_agony != NULL || auras.curse_of_doom != NULL) {
-      spells.curse_of_agony = std::make_shared<CurseOfAgony>(*this, nullptr, auras.curse_of_agony);
+      spells.curse_of_agony = arena.Create<CurseOfAgony>(*this, nullptr, auras.curse_of_agony);
       auras.curse_of_agony->parent_spell = spells.curse_of_agony;
     }
     if (auras.curse_of_the_elements != NULL)
-      spells.curse_of_the_elements = std::make_shared<CurseOfTheElements>(*this, auras.curse_of_the_elements);
+      spells.curse_of_the_elements = arena.Create<CurseOfTheElements>(*this, auras.curse_of_the_elements);
     if (auras.curse_of_recklessness != NULL)
-      spells.curse_of_recklessness = std::make_shared<CurseOfRecklessness>(*this, auras.curse_of_recklessness);
+      spells.curse_of_recklessness = arena.Create<CurseOfRecklessness>(*this, auras.curse_of_recklessness);
     if (auras.curse_of_doom != NULL) {
-      spells.curse_of_doom = std::make_shared<CurseOfDoom>(*this, nullptr, auras.curse_of_doom);
+      spells.curse_of_doom = arena.Create<CurseOfDoom>(*this, nullptr, auras.curse_of_doom);
       auras.curse_of_doom->parent_spell = spells.curse_of_doom;
     }
-    if (auras.amplify_curse != NULL) spells.amplify_curse = std::make_shared<AmplifyCurse>(*this, auras.amplify_curse);
+    if (auras.amplify_curse != NULL) spells.amplify_curse = arena.Create<AmplifyCurse>(*this, auras.amplify_curse);
   }
   if (auras.improved_shadow_bolt != NULL)
-    spells.improved_shadow_bolt = std::make_shared<ImprovedShadowBolt>(*this, auras.improved_shadow_bolt);
-  if (auras.mana_tide_totem != NULL)
-    spells.mana_tide_totem = std::make_shared<ManaTideTotem>(*this, auras.mana_tide_totem);
+    spells.improved_shadow_bolt = arena.Create<ImprovedShadowBolt>(*this, auras.improved_shadow_bolt);
+  if (auras.mana_tide_totem != NULL) spells.mana_tide_totem = arena.Create<ManaTideTotem>(*this, auras.mana_tide_totem);
   if (auras.chipped_power_core != NULL)
-    spells.chipped_power_core = std::make_shared<ChippedPowerCore>(*this, auras.chipped_power_core);
+    spells.chipped_power_core = arena.Create<ChippedPowerCore>(*this, auras.chipped_power_core);
   if (auras.cracked_power_core != NULL)
-    spells.cracked_power_core = std::make_shared<CrackedPowerCore>(*this, auras.cracked_power_core);
-  if (selected_auras.super_mana_potion) spells.super_mana_potion = std::make_shared<SuperManaPotion>(*this);
-  if (selected_auras.demonic_rune) spells.demonic_rune = std::make_shared<DemonicRune>(*this);
+    spells.cracked_power_core = arena.Create<CrackedPowerCore>(*this, auras.cracked_power_core);
+  if (selected_auras.super_mana_potion) spells.super_mana_potion = arena.Create<SuperManaPotion>(*this);
+  if (selected_auras.demonic_rune) spells.demonic_rune = arena.Create<DemonicRune>(*this);
   if (talents.dark_pact == 1 && (settings.has_dark_pact || settings.rotation_option == EmbindConstant::kSimChooses))
-    spells.dark_pact = std::make_shared<DarkPact>(*this);
+    spells.dark_pact = arena.Create<DarkPact>(*this);
   if (auras.destruction_potion != NULL)
-    spells.destruction_potion = std::make_shared<DestructionPotion>(*this, auras.destruction_potion);
-  if (auras.flame_cap != NULL) spells.flame_cap = std::make_shared<FlameCap>(*this, auras.flame_cap);
-  if (auras.blood_fury != NULL) spells.blood_fury = std::make_shared<BloodFury>(*this, auras.blood_fury);
+    spells.destruction_potion = arena.Create<DestructionPotion>(*this, auras.destruction_potion);
+  if (auras.flame_cap != NULL) spells.flame_cap = arena.Create<FlameCap>(*this, auras.flame_cap);
+  if (auras.blood_fury != NULL) spells.blood_fury = arena.Create<BloodFury>(*this, auras.blood_fury);
   if (auras.drums_of_battle != NULL)
-    spells.drums_of_battle = std::make_shared<DrumsOfBattle>(*this, auras.drums_of_battle);
+    spells.drums_of_battle = arena.Create<DrumsOfBattle>(*this, auras.drums_of_battle);
   else if (auras.drums_of_war != NULL)
-    spells.drums_of_war = std::make_shared<DrumsOfWar>(*this, auras.drums_of_war);
+    spells.drums_of_war = arena.Create<DrumsOfWar>(*this, auras.drums_of_war);
   else if (auras.drums_of_restoration != NULL)
-    spells.drums_of_restoration = std::make_shared<DrumsOfRestoration>(*this, auras.drums_of_restoration);
+    spells.drums_of_restoration = arena.Create<DrumsOfRestoration>(*this, auras.drums_of_restoration);
   if (auras.blade_of_wizardry != NULL)
-    spells.blade_of_wizardry = std::make_shared<BladeOfWizardry>(*this, auras.blade_of_wizardry);
+    spells.blade_of_wizardry = arena.Create<BladeOfWizardry>(*this, auras.blade_of_wizardry);
   if (auras.shattered_sun_pendant_of_acumen_aldor != NULL)
     spells.shattered_sun_pendant_of_acumen_aldor =
-        std::make_shared<ShatteredSunPendantOfAcumenAldor>(*this, auras.shattered_sun_pendant_of_acumen_aldor);
+        arena.Create<ShatteredSunPendantOfAcumenAldor>(*this, auras.shattered_sun_pendant_of_acumen_aldor);
   if (auras.robe_of_the_elder_scribes != NULL)
-    spells.robe_of_the_elder_scribes = std::make_shared<RobeOfTheElderScribes>(*this, auras.robe_of_the_elder_scribes);
+    spells.robe_of_the_elder_scribes = arena.Create<RobeOfTheElderScribes>(*this, auras.robe_of_the_elder_scribes);
   if (auras.mystical_skyfire_diamond != NULL)
-    spells.mystical_skyfire_diamond = std::make_shared<MysticalSkyfireDiamond>(*this, auras.mystical_skyfire_diamond);
+    spells.mystical_skyfire_diamond = arena.Create<MysticalSkyfireDiamond>(*this, auras.mystical_skyfire_diamond);
   if (settings.meta_gem_id == ItemId::kInsightfulEarthstormDiamond)
-    spells.insightful_earthstorm_diamond = std::make_shared<InsightfulEarthstormDiamond>(*this);
+    spells.insightful_earthstorm_diamond = arena.Create<InsightfulEarthstormDiamond>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kTimbalsFocusingCrystal) !=
       equipped_trinket_ids.end())
-    spells.timbals_focusing_crystal = std::make_shared<TimbalsFocusingCrystal>(*this);
+    spells.timbals_focusing_crystal = arena.Create<TimbalsFocusingCrystal>(*this);
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kMarkOfDefiance) !=
       equipped_trinket_ids.end())
-    spells.mark_of_defiance = std::make_shared<MarkOfDefiance>(*this);
+    spells.mark_of_defiance = arena.Create<MarkOfDefiance>(*this);
   if (auras.the_lightning_capacitor != NULL)
-    spells.the_lightning_capacitor = std::make_shared<TheLightningCapacitor>(*this);
+    spells.the_lightning_capacitor = arena.Create<TheLightningCapacitor>(*this);
   if (auras.quagmirrans_eye != NULL)
-    spells.quagmirrans_eye = std::make_shared<QuagmirransEye>(*this, auras.quagmirrans_eye);
+    spells.quagmirrans_eye = arena.Create<QuagmirransEye>(*this, auras.quagmirrans_eye);
   if (auras.shiffars_nexus_horn != NULL)
-    spells.shiffars_nexus_horn = std::make_shared<ShiffarsNexusHorn>(*this, auras.shiffars_nexus_horn);
+    spells.shiffars_nexus_horn = arena.Create<ShiffarsNexusHorn>(*this, auras.shiffars_nexus_horn);
   if (auras.sextant_of_unstable_currents != NULL)
     spells.sextant_of_unstable_currents =
-        std::make_shared<SextantOfUnstableCurrents>(*this, auras.sextant_of_unstable_currents);
+        arena.Create<SextantOfUnstableCurrents>(*this, auras.sextant_of_unstable_currents);
   if (auras.band_of_the_eternal_sage != NULL)
-    spells.band_of_the_eternal_sage = std::make_shared<BandOfTheEternalSage>(*this, auras.band_of_the_eternal_sage);
-  if (selected_auras.judgement_of_wisdom) spells.judgement_of_wisdom = std::make_shared<JudgementOfWisdom>(*this);
-  if (auras.flameshadow != NULL) spells.flameshadow = std::make_shared<Flameshadow>(*this, auras.flameshadow);
-  if (auras.shadowflame != NULL) spells.shadowflame = std::make_shared<Shadowflame>(*this, auras.shadowflame);
-  if (auras.spellstrike != NULL) spells.spellstrike = std::make_shared<Spellstrike>(*this, auras.spellstrike);
+    spells.band_of_the_eternal_sage = arena.Create<BandOfTheEternalSage>(*this, auras.band_of_the_eternal_sage);
+  if (selected_auras.judgement_of_wisdom) spells.judgement_of_wisdom = arena.Create<JudgementOfWisdom>(*this);
+  if (auras.flameshadow != NULL) spells.flameshadow = arena.Create<Flameshadow>(*this, auras.flameshadow);
+  if (auras.shadowflame != NULL) spells.shadowflame = arena.Create<Shadowflame>(*this, auras.shadowflame);
+  if (auras.spellstrike != NULL) spells.spellstrike = arena.Create<Spellstrike>(*this, auras.spellstrike);
   if (auras.mana_etched_4_set != NULL)
-    spells.mana_etched_4_set = std::make_shared<ManaEtched4Set>(*this, auras.mana_etched_4_set);
+    spells.mana_etched_4_set = arena.Create<ManaEtched4Set>(*this, auras.mana_etched_4_set);
   if (auras.ashtongue_talisman_of_shadows != NULL)
     spells.ashtongue_talisman_of_shadows =
-        std::make_shared<AshtongueTalismanOfShadows>(*this, auras.ashtongue_talisman_of_shadows);
+        arena.Create<AshtongueTalismanOfShadows>(*this, auras.ashtongue_talisman_of_shadows);
   if (auras.wrath_of_cenarius != NULL)
-    spells.wrath_of_cenarius = std::make_shared<WrathOfCenarius>(*this, auras.wrath_of_cenarius);
+    spells.wrath_of_cenarius = arena.Create<WrathOfCenarius>(*this, auras.wrath_of_cenarius);
   if (auras.darkmoon_card_crusade != NULL)
-    spells.darkmoon_card_crusade = std::make_shared<DarkmoonCardCrusade>(*this, auras.darkmoon_card_crusade);
+    spells.darkmoon_card_crusade = arena.Create<DarkmoonCardCrusade>(*this, auras.darkmoon_card_crusade);
   if (auras.power_infusion != NULL) {
     for (int i = 0; i < settings.power_infusion_amount; i++) {
-      spells.power_infusion.push_back(std::make_shared<PowerInfusion>(*this, auras.power_infusion));
+      spells.power_infusion.push_back(arena.Create<PowerInfusion>(*this, auras.power_infusion));
     }
   }
   if (auras.bloodlust != NULL) {
     for (int i = 0; i < settings.bloodlust_amount; i++) {
-      spells.bloodlust.push_back(std::make_shared<Bloodlust>(*this, auras.bloodlust));
+      spells.bloodlust.push_back(arena.Create<Bloodlust>(*this, auras.bloodlust));
     }
   }
   if (auras.innervate != NULL) {
     for (int i = 0; i < settings.innervate_amount; i++) {
-      spells.innervate.push_back(std::make_shared<Innervate>(*this, auras.innervate));
+      spells.innervate.push_back(arena.Create<Innervate>(*this, auras.innervate));
     }
   }
 
@@ -425,23 +428,26 @@ void Player::Reset() {
   }
 }
 
-void Player::EndAuras() {
-  Entity::EndAuras();
+void Player::EndAuras(NotWritingCombatLog combat_log) { EndAuras<>(combat_log); }
+
+void Player::EndAuras(WritingCombatLog combat_log) { EndAuras<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void Player::EndAuras(CombatLogPolicy combat_log) {
+  Entity::EndAuras(combat_log);
 
   for (auto& trinket : trinkets) {
     if (trinket.active) {
-      trinket.Fade();
-    }
-  }
-
-  for (auto& dot : dot_list) {
-    if (dot->active) {
-      dot->Fade();
+      trinket.Fade(combat_log);
     }
   }
 }
 
 double Player::GetHastePercent() {
+  return cached_haste_percent.Get(stats_version, [this] { return CalculateHastePercent(); });
+}
+
+double Player::CalculateHastePercent() {
   auto haste_percent = stats.spell_haste_percent;
 
   // If both Bloodlust and Power Infusion are active then remove the 20% PI
@@ -459,6 +465,11 @@ double Player::GetHastePercent() {
 }
 
 double Player::GetSpellPower(bool dealing_damage, SpellSchool school) {
+  return cached_spell_power[dealing_damage][static_cast<int>(school)].Get(
+      stats_version, [this, dealing_damage, school] { return CalculateSpellPower(dealing_damage, school); });
+}
+
+double Player::CalculateSpellPower(bool dealing_damage, SpellSchool school) {
   auto spell_power = stats.spell_power;
 
   if (pet != NULL && talents.demonic_knowledge > 0) {
@@ -491,8 +502,10 @@ double Player::GetSpellPower(bool dealing_damage, SpellSchool school) {
 }
 
 double Player::GetSpellCritChance(SpellType spell_type) {
-  auto crit_chance = stats.spell_crit_chance + (GetIntellect() * StatConstant::kCritChancePerIntellect) +
-                     (stats.spell_crit_rating / StatConstant::kCritRatingPerPercent);
+  auto crit_chance = cached_spell_crit_chance.Get(stats_version, [this] {
+    return stats.spell_crit_chance + (GetIntellect() * StatConstant::kCritChancePerIntellect) +
+           (stats.spell_crit_rating / StatConstant::kCritRatingPerPercent);
+  });
 
   if (spell_type != SpellType::kDestruction) {
     crit_chance -= talents.devastation;
@@ -501,11 +514,21 @@ double Player::GetSpellCritChance(SpellType spell_type) {
   return crit_chance;
 }
 
-int Player::GetRand() { return rng.range(0, 100 * kFloatNumberMultiplier); }
+// The instances of a spell are numbered in the order they're set up in, which is the same in every configuration
+// that has them
+void Player::AddRngStream(Rng& rng, EntityType entity_type, SpellId spell_id, RollType roll_type) {
+  rng.SetStream(entity_type, spell_id, rng_stream_instances[{entity_type, spell_id, roll_type}]++, roll_type);
+  rng_streams.push_back(&rng);
+}
 
-bool Player::RollRng(double chance) { return GetRand() <= chance * kFloatNumberMultiplier; }
+void Player::SeedRngStreams(int iteration, bool mirrored) {
+  for (auto& rng_stream : rng_streams) {
+    rng_stream->seed(settings.random_seed, iteration, mirrored);
+  }
+}
 
-void Player::UseCooldowns(double fight_time_remaining) {
+template <typename CombatLogPolicy>
+void Player::UseCooldowns(CombatLogPolicy combat_log, double fight_time_remaining) {
   // Only use PI if Bloodlust isn't selected or if Bloodlust isn't active since they don't stack, or if there are enough
   // Power Infusions available to last until the end of the fight for the mana cost reduction
   if (!spells.power_infusion.empty() && !auras.power_infusion->active &&
@@ -513,7 +536,7 @@ void Player::UseCooldowns(double fight_time_remaining) {
        power_infusions_ready * auras.power_infusion->duration >= fight_time_remaining)) {
     for (auto& pi : spells.power_infusion) {
       if (pi->Ready()) {
-        pi->StartCast();
+        pi->StartCast(combat_log);
         break;
       }
     }
@@ -522,75 +545,80 @@ void Player::UseCooldowns(double fight_time_remaining) {
   if (stats.mana / stats.max_mana <= 0.5 && !spells.innervate.empty() && !auras.innervate->active) {
     for (auto& innervate : spells.innervate) {
       if (innervate->Ready()) {
-        innervate->StartCast();
+        innervate->StartCast(combat_log);
         break;
       }
     }
   }
 
   if (spells.chipped_power_core != NULL && spells.chipped_power_core->Ready()) {
-    spells.chipped_power_core->StartCast();
+    spells.chipped_power_core->StartCast(combat_log);
   } else if (spells.cracked_power_core != NULL && spells.cracked_power_core->Ready()) {
-    spells.cracked_power_core->StartCast();
+    spells.cracked_power_core->StartCast(combat_log);
   }
 
   if (spells.destruction_potion != NULL && spells.destruction_potion->Ready()) {
-    spells.destruction_potion->StartCast();
+    spells.destruction_potion->StartCast(combat_log);
   }
 
   if (spells.flame_cap != NULL && spells.flame_cap->Ready()) {
-    spells.flame_cap->StartCast();
+    spells.flame_cap->StartCast(combat_log);
   }
 
   if (spells.blood_fury != NULL && spells.blood_fury->Ready()) {
-    spells.blood_fury->StartCast();
+    spells.blood_fury->StartCast(combat_log);
   }
 
   for (auto i = 0; i < trinkets.size(); i++) {
     if (trinkets[i].Ready()) {
-      trinkets[i].Use();
+      trinkets[i].Use(combat_log);
       // Set the other on-use trinket (if another is equipped) on cooldown for
       // the duration of the trinket just used if the trinkets share cooldown
       auto kOtherTrinketSlot = i == 1 ? 0 : 1;
       if (trinkets.size() > kOtherTrinketSlot && trinkets[kOtherTrinketSlot].shares_cooldown &&
           trinkets[i].shares_cooldown) {
-        trinkets[kOtherTrinketSlot].cooldown_remaining =
-            std::max(trinkets[kOtherTrinketSlot].cooldown_remaining, static_cast<double>(trinkets[i].duration));
+        trinkets[kOtherTrinketSlot].ready_at =
+            std::max(trinkets[kOtherTrinketSlot].ready_at,
+                     simulation->current_fight_time + trinkets[i].duration * kFightTimePerSecond);
+        trinket_timers.Schedule(trinkets[kOtherTrinketSlot].cooldown_timer, trinkets[kOtherTrinketSlot].ready_at);
       }
     }
   }
 }
 
+template void Player::UseCooldowns(NotWritingCombatLog, double);
+template void Player::UseCooldowns(WritingCombatLog, double);
+
 // TODO remove this is_dot parameter
 double Player::GetDamageModifier(Spell& spell, bool is_dot) {
   auto additive_modifier = 1.0;
   auto multiplicative_modifier = Entity::GetMultiplicativeDamageModifier(spell, is_dot);
 
-  if (sets.t6 >= 4 && (spell.name == SpellName::kShadowBolt || spell.name == SpellName::kIncinerate)) {
+  if (sets.t6 >= 4 && (spell.id == SpellId::kShadowBolt || spell.id == SpellId::kIncinerate)) {
     additive_modifier += 0.06;
   }
 
-  if (sets.t3 >= 4 && spell.name == SpellName::kCorruption) {
+  if (sets.t3 >= 4 && spell.id == SpellId::kCorruption) {
     additive_modifier += 0.12;
   }
 
-  if (spell.spell_school == SpellSchool::kShadow && spell.name != SpellName::kCurseOfDoom) {
+  if (spell.spell_school == SpellSchool::kShadow && spell.id != SpellId::kCurseOfDoom) {
     additive_modifier += 0.02 * talents.shadow_mastery;
   }
 
-  if (spell.name == SpellName::kCurseOfAgony) {
+  if (spell.id == SpellId::kCurseOfAgony) {
     additive_modifier += 0.05 * talents.improved_curse_of_agony;
   }
 
-  if (spell.name == SpellName::kCurseOfAgony || spell.name == SpellName::kCorruption ||
-      spell.name == SpellName::kSeedOfCorruption) {
+  if (spell.id == SpellId::kCurseOfAgony || spell.id == SpellId::kCorruption ||
+      spell.id == SpellId::kSeedOfCorruption) {
     additive_modifier += 0.01 * talents.contagion;
   }
 
   if (spell.spell_school == SpellSchool::kFire) {
     additive_modifier += 0.02 * talents.emberstorm;
 
-    if (spell.name == SpellName::kImmolate && !is_dot) {
+    if (spell.id == SpellId::kImmolate && !is_dot) {
       additive_modifier += 0.05 * talents.improved_immolate;
     }
   }
@@ -598,14 +626,18 @@ double Player::GetDamageModifier(Spell& spell, bool is_dot) {
   return additive_modifier * multiplicative_modifier;
 }
 
-void Player::CastLifeTapOrDarkPact() {
+template <typename CombatLogPolicy>
+void Player::CastLifeTapOrDarkPact(CombatLogPolicy combat_log) {
   if (spells.dark_pact != NULL && spells.dark_pact->Ready()) {
-    spells.dark_pact->StartCast();
+    spells.dark_pact->StartCast(combat_log);
   } else {
-    spells.life_tap->StartCast();
+    spells.life_tap->StartCast(combat_log);
   }
 }
 
+template void Player::CastLifeTapOrDarkPact(NotWritingCombatLog);
+template void Player::CastLifeTapOrDarkPact(WritingCombatLog);
+
 void Player::ThrowError(const std::string& error) {
   SendCombatLogEntries();
   ErrorCallback(error.c_str());
@@ -618,38 +650,48 @@ void Player::SendCombatLogEntries() {
   }
 }
 
-double Player::FindTimeUntilNextAction() {
+FightTime Player::FindTimeUntilNextAction() {
   auto time = Entity::FindTimeUntilNextAction();
+  const FightTime kTimeUntilNextTrinketTimer = FindTimeUntilNextTimer(trinket_timers);
+
+  if (kTimeUntilNextTrinketTimer < time) {
+    time = kTimeUntilNextTrinketTimer;
+  }
 
   if (pet != NULL) {
-    const double kTimeUntilNextPetAction = pet->FindTimeUntilNextAction();
+    const FightTime kTimeUntilNextPetAction = pet->FindTimeUntilNextAction();
 
     if (kTimeUntilNextPetAction > 0 && kTimeUntilNextPetAction < time) {
       time = kTimeUntilNextPetAction;
     }
   }
 
-  for (auto& trinket : trinkets) {
-    if (trinket.active && trinket.duration_remaining < time) {
-      time = trinket.duration_remaining;
-    }
-    if (trinket.cooldown_remaining > 0 && trinket.cooldown_remaining < time) {
-      time = trinket.cooldown_remaining;
-    }
-  }
-
   return time;
 }
 
-void Player::Tick(double time) {
-  Entity::Tick(time);
+void Player::Tick(NotWritingCombatLog combat_log, FightTime time) { Tick<>(combat_log, time); }
 
-  for (auto& trinket : trinkets) {
-    trinket.Tick(time);
+void Player::Tick(WritingCombatLog combat_log, FightTime time) { Tick<>(combat_log, time); }
+
+template <typename CombatLogPolicy>
+void Player::Tick(CombatLogPolicy combat_log, FightTime time) {
+  Entity::Tick(combat_log, time);
+
+  int timer;
+
+  while ((timer = trinket_timers.PopDue(simulation->current_fight_time)) != -1) {
+    // Each trinket has two timers, its duration first and then its cooldown
+    auto& trinket = trinkets[timer / 2];
+
+    if (timer == trinket.duration_timer) {
+      trinket.Fade(combat_log);
+    } else {
+      trinket.OffCooldown(combat_log);
+    }
   }
 
   if (mp5_timer_remaining <= 0) {
-    mp5_timer_remaining = 5;
+    mp5_timer_remaining = 5 * kFightTimePerSecond;
 
     if (stats.mp5 > 0 || five_second_rule_timer_remaining <= 0 ||
         (auras.innervate != NULL && auras.innervate->active)) {
@@ -678,11 +720,11 @@ void Player::Tick(double time) {
 
       const double kManaGained = stats.mana - kCurrentPlayerMana;
       if (recording_combat_log_breakdown) {
-        combat_log_breakdown.at(StatName::kMp5)->casts++;
-        combat_log_breakdown.at(StatName::kMp5)->iteration_mana_gain += kManaGained;
+        combat_log_breakdown[mp5_breakdown_index].casts++;
+        combat_log_breakdown[mp5_breakdown_index].iteration_mana_gain += kManaGained;
       }
 
-      if (ShouldWriteToCombatLog()) {
+      if constexpr (CombatLogPolicy::kWriting) {
         CombatLog("Player gains " + DoubleToString(kManaGained) + " mana from MP5 (" +
                   DoubleToString(kCurrentPlayerMana) + " -> " + DoubleToString(stats.mana) + ")");
       }
@@ -758,7 +800,7 @@ void Player::SendPlayerInfoToCombatLog() {
                                std::to_string(std::max(settings.enemy_fire_resist, enemy_level_difference_resistance)));
   if (pet != NULL && pet->pet_name != PetName::kImp) {
     combat_log_entries.push_back("Dodge Chance: " + DoubleToString(StatConstant::kBaseEnemyDodgeChance, 2) + "%");
-    combat_log_entries.push_back("Armor: " + std::to_string(settings.enemy_armor));
+    combat_log_entries.push_back("Armor: " + std::to_string(enemy_armor));
     combat_log_entries.push_back(
         "Damage Reduction From Armor: " +
         DoubleToString(round((1 - pet->enemy_damage_reduction_from_armor) * 10000) / 100.0, 2) + "%");
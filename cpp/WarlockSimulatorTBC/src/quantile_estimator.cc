@@ -0,0 +1,111 @@
+#include "../include/quantile_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+QuantileEstimator::QuantileEstimator(double quantile) : quantile(quantile) {
+  for (int i = 0; i < 5; i++) {
+    heights[i] = 0;
+    positions[i] = i + 1;
+  }
+
+  desired_positions[0] = 1;
+  desired_positions[1] = 1 + 2 * quantile;
+  desired_positions[2] = 1 + 4 * quantile;
+  desired_positions[3] = 3 + 2 * quantile;
+  desired_positions[4] = 5;
+  desired_position_increments[0] = 0;
+  desired_position_increments[1] = quantile / 2;
+  desired_position_increments[2] = quantile;
+  desired_position_increments[3] = (1 + quantile) / 2;
+  desired_position_increments[4] = 1;
+}
+
+void QuantileEstimator::Add(double value) {
+  if (count < 5) {
+    heights[count++] = value;
+    if (count == 5) {
+      std::sort(heights, heights + 5);
+    }
+    return;
+  }
+
+  count++;
+
+  // Find the cell the value falls into, extending the minimum or maximum if needed
+  int cell = 0;
+  if (value < heights[0]) {
+    heights[0] = value;
+  } else if (value >= heights[4]) {
+    heights[4] = value;
+    cell = 3;
+  } else {
+    while (value >= heights[cell + 1]) {
+      cell++;
+    }
+  }
+
+  for (int i = cell + 1; i < 5; i++) {
+    positions[i]++;
+  }
+
+  for (int i = 0; i < 5; i++) {
+    desired_positions[i] += desired_position_increments[i];
+  }
+
+  // Move the middle markers towards their desired positions if they're off by one or more
+  for (int i = 1; i < 4; i++) {
+    const double kOffset = desired_positions[i] - positions[i];
+
+    if ((kOffset >= 1 && positions[i + 1] - positions[i] > 1) ||
+        (kOffset <= -1 && positions[i - 1] - positions[i] < -1)) {
+      const int kDirection = kOffset > 0 ? 1 : -1;
+      // Piecewise-parabolic prediction of the marker's new height
+      const double kParabolic =
+          heights[i] + kDirection / (positions[i + 1] - positions[i - 1]) *
+                           ((positions[i] - positions[i - 1] + kDirection) * (heights[i + 1] - heights[i]) /
+                                (positions[i + 1] - positions[i]) +
+                            (positions[i + 1] - positions[i] - kDirection) * (heights[i] - heights[i - 1]) /
+                                (positions[i] - positions[i - 1]));
+
+      if (heights[i - 1] < kParabolic && kParabolic < heights[i + 1]) {
+        heights[i] = kParabolic;
+      } else {
+        heights[i] += kDirection * (heights[i + kDirection] - heights[i]) /
+                      (positions[i + kDirection] - positions[i]);
+      }
+
+      positions[i] += kDirection;
+    }
+  }
+}
+
+double QuantileEstimator::Value() const {
+  if (count == 0) {
+    return 0;
+  }
+
+  if (count <= 5) {
+    // Sorted with an insertion sort that's bounded by the array's size, since std::sort over a variable amount of
+    // values trips -Warray-bounds
+    const int kValueAmount = std::min(count, 5);
+    double values[5];
+
+    for (int i = 0; i < kValueAmount; i++) {
+      int position = i;
+
+      for (; position > 0 && values[position - 1] > heights[i]; position--) {
+        values[position] = values[position - 1];
+      }
+      values[position] = heights[i];
+    }
+
+    const double kIndex = quantile * (count - 1);
+    const int kLowerIndex = static_cast<int>(std::floor(kIndex));
+    const int kUpperIndex = std::min(kLowerIndex + 1, count - 1);
+
+    return values[kLowerIndex] + (kIndex - kLowerIndex) * (values[kUpperIndex] - values[kLowerIndex]);
+  }
+
+  return heights[2];
+}
@@ -0,0 +1,109 @@
+#include "../include/result_cache.h"
+
+#include <type_traits>
+
+namespace {
+// 64-bit FNV-1a
+struct ConfigHasher {
+  uint64_t value = 14695981039346656037ull;
+
+  void AddBytes(const void* data, size_t size) {
+    const auto* kBytes = static_cast<const unsigned char*>(data);
+
+    for (size_t i = 0; i < size; i++) {
+      value ^= kBytes[i];
+      value *= 1099511628211ull;
+    }
+  }
+
+  void Add(int number) { AddBytes(&number, sizeof(number)); }
+  void Add(uint32_t number) { AddBytes(&number, sizeof(number)); }
+  void Add(bool boolean) { Add(boolean ? 1 : 0); }
+  void Add(EmbindConstant constant) { Add(static_cast<int>(constant)); }
+
+  // For the structs that only have members of one type, so that they have no padding bytes and can be hashed as a
+  // whole
+  template <typename T, typename Member>
+  void AddStruct(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) % sizeof(Member) == 0,
+                  "The struct has to only have members of the one type");
+    AddBytes(&value, sizeof(value));
+  }
+};
+}  // namespace
+
+uint64_t ConfigHash(const PlayerSettings& player_settings, const SimulationSettings& simulation_settings) {
+  auto hasher = ConfigHasher();
+
+  hasher.Add(kResultCacheVersion);
+  hasher.Add(simulation_settings.min_time);
+  hasher.Add(simulation_settings.max_time);
+  hasher.Add(simulation_settings.antithetic_variates);
+  hasher.Add(player_settings.random_seed);
+
+  hasher.AddStruct<AuraSelection, bool>(player_settings.auras);
+  hasher.AddStruct<Talents, int>(player_settings.talents);
+  hasher.AddStruct<Sets, int>(player_settings.sets);
+  hasher.AddStruct<CharacterStats, double>(player_settings.stats);
+  hasher.AddStruct<Items, int>(player_settings.items);
+
+  hasher.Add(player_settings.shattrath_faction);
+  hasher.Add(player_settings.selected_pet);
+  hasher.Add(player_settings.fight_type);
+  hasher.Add(player_settings.race);
+  hasher.Add(player_settings.lash_of_pain_usage);
+  hasher.Add(player_settings.pet_mode);
+  hasher.Add(player_settings.rotation_option);
+  hasher.Add(player_settings.meta_gem_id);
+  hasher.Add(player_settings.enemy_level);
+  hasher.Add(player_settings.enemy_shadow_resist);
+  hasher.Add(player_settings.enemy_fire_resist);
+  hasher.Add(player_settings.mage_atiesh_amount);
+  hasher.Add(player_settings.totem_of_wrath_amount);
+  hasher.Add(player_settings.sacrificing_pet);
+  hasher.Add(player_settings.ferocious_inspiration_amount);
+  hasher.Add(player_settings.improved_curse_of_the_elements);
+  hasher.Add(player_settings.using_custom_isb_uptime);
+  hasher.Add(player_settings.custom_isb_uptime_value);
+  hasher.Add(player_settings.improved_divine_spirit);
+  hasher.Add(player_settings.improved_imp);
+  hasher.Add(player_settings.shadow_priest_dps);
+  hasher.Add(player_settings.warlock_atiesh_amount);
+  hasher.Add(player_settings.improved_expose_armor);
+  hasher.Add(player_settings.enemy_amount);
+  hasher.Add(player_settings.power_infusion_amount);
+  hasher.Add(player_settings.bloodlust_amount);
+  hasher.Add(player_settings.innervate_amount);
+  hasher.Add(player_settings.chipped_power_core_amount);
+  hasher.Add(player_settings.cracked_power_core_amount);
+  hasher.Add(player_settings.battle_squawk_amount);
+  hasher.Add(player_settings.enemy_armor);
+  hasher.Add(player_settings.expose_weakness_uptime);
+  hasher.Add(player_settings.improved_faerie_fire);
+  hasher.Add(player_settings.infinite_player_mana);
+  hasher.Add(player_settings.infinite_pet_mana);
+  hasher.Add(player_settings.prepop_black_book);
+  hasher.Add(player_settings.randomize_values);
+  hasher.Add(player_settings.exalted_with_shattrath_faction);
+  hasher.Add(player_settings.survival_hunter_agility);
+  hasher.Add(player_settings.has_immolate);
+  hasher.Add(player_settings.has_corruption);
+  hasher.Add(player_settings.has_siphon_life);
+  hasher.Add(player_settings.has_unstable_affliction);
+  hasher.Add(player_settings.has_searing_pain);
+  hasher.Add(player_settings.has_shadow_bolt);
+  hasher.Add(player_settings.has_incinerate);
+  hasher.Add(player_settings.has_curse_of_recklessness);
+  hasher.Add(player_settings.has_curse_of_the_elements);
+  hasher.Add(player_settings.has_curse_of_agony);
+  hasher.Add(player_settings.has_curse_of_doom);
+  hasher.Add(player_settings.has_death_coil);
+  hasher.Add(player_settings.has_shadow_burn);
+  hasher.Add(player_settings.has_conflagrate);
+  hasher.Add(player_settings.has_shadowfury);
+  hasher.Add(player_settings.has_amplify_curse);
+  hasher.Add(player_settings.has_dark_pact);
+  hasher.Add(player_settings.has_elemental_shaman_t4_bonus);
+
+  return hasher.value;
+}
@@ -1,9 +1,81 @@
 #include "../include/rng.h"
 
-#include <math.h>
+namespace {
+constexpr uint32_t kMultiplier0 = 0xD2511F53;
+constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+constexpr uint32_t kKeyIncrement0 = 0x9E3779B9;
+constexpr uint32_t kKeyIncrement1 = 0xBB67AE85;
+constexpr int kRounds = 10;
+constexpr uint64_t kNumberAmount = 1ull << 32;  // Of distinct 32-bit numbers
+}  // namespace
 
-void Rng::seed(uint32_t s) { _random_engine.seed(s); }
+// 32-bit FNV-1a of the bytes of the entity type, the spell id, the instance and the roll type
+void Rng::SetStream(EntityType entity_type, SpellId spell_id, int instance, RollType roll_type) {
+  const uint32_t kValues[4] = {static_cast<uint32_t>(entity_type), static_cast<uint32_t>(spell_id),
+                               static_cast<uint32_t>(instance), static_cast<uint32_t>(roll_type)};
+  stream = 2166136261u;
 
-double Rng::next() { return _random(_random_engine); }
+  for (const uint32_t kValue : kValues) {
+    for (int byte = 0; byte < 4; byte++) {
+      stream ^= (kValue >> (8 * byte)) & 0xFF;
+      stream *= 16777619u;
+    }
+  }
+}
 
-int Rng::range(int min, int max) { return static_cast<int>(floor(next() * (max - min + 1) + min)); }
\ No newline at end of file
+void Rng::seed(uint32_t random_seed, uint32_t iteration, bool mirrored) {
+  key[0] = random_seed;
+  key[1] = 0;
+  counter[0] = 0;
+  counter[1] = 0;
+  counter[2] = iteration;
+  counter[3] = stream;
+  block_index = 4;
+  mirror_mask = mirrored ? 0xFFFFFFFF : 0;
+}
+
+// Scales a 32-bit number to the range with a multiply and a shift (Lemire, "Fast Random Integer Generation in an
+// Interval"). The ranges are a few thousand wide at most, so the bias of leaving out the rejection step is far below
+// anything that shows up in the dps.
+int Rng::range(int min, int max) {
+  const uint64_t kRangeSize = static_cast<uint64_t>(max - min) + 1;
+  return min + static_cast<int>((NextUint32() * kRangeSize) >> 32);
+}
+
+uint64_t Rng::ChanceThreshold(double chance) {
+  if (chance <= 0) {
+    return 0;
+  }
+  if (chance >= 100) {
+    return kNumberAmount;
+  }
+
+  return static_cast<uint64_t>(chance / 100 * kNumberAmount);
+}
+
+void Rng::GenerateBlock() {
+  uint32_t round_key[2] = {key[0], key[1]};
+  uint32_t state[4] = {counter[0], counter[1], counter[2], counter[3]};
+
+  for (int round = 0; round < kRounds; round++) {
+    const uint64_t kProduct0 = static_cast<uint64_t>(kMultiplier0) * state[0];
+    const uint64_t kProduct1 = static_cast<uint64_t>(kMultiplier1) * state[2];
+
+    state[0] = static_cast<uint32_t>(kProduct1 >> 32) ^ state[1] ^ round_key[0];
+    state[1] = static_cast<uint32_t>(kProduct1);
+    state[2] = static_cast<uint32_t>(kProduct0 >> 32) ^ state[3] ^ round_key[1];
+    state[3] = static_cast<uint32_t>(kProduct0);
+
+    round_key[0] += kKeyIncrement0;
+    round_key[1] += kKeyIncrement1;
+  }
+
+  for (int i = 0; i < 4; i++) {
+    block[i] = state[i];
+  }
+  block_index = 0;
+
+  if (++counter[0] == 0) {
+    counter[1]++;
+  }
+}
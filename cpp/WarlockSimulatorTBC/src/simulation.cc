@@ -3,10 +3,18 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "../include/batch_simulation.h"
 #include "../include/bindings.h"
 #include "../include/common.h"
 #include "../include/enums.h"
@@ -15,144 +23,737 @@ Simulation::Simulation(Player& player, const SimulationSettings& simulation_sett
     : player(player), settings(simulation_settings) {}
 
 void Simulation::Start() {
+  if (settings.simulation_type == SimulationType::kStatWeights) {
+    StartStatWeights();
+    return;
+  }
+
   player.total_fight_duration = 0;
   player.Initialize(this);
   min_dps = std::numeric_limits<double>::max();
   max_dps = 0;
   auto start = std::chrono::high_resolution_clock::now();
 
-  for (iteration = 0; iteration < settings.iterations; iteration++) {
-    const int kFightLength = player.rng.range(settings.min_time, settings.max_time);
+#if defined(EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+  // The default wasm build has no thread support, only the "threaded" Makefile target does
+  const bool kParallel = false;
+#else
+  const bool kParallel = settings.threads > 1;
+#endif
+  // The parallel mode needs the dps values to merge the blocks in iteration order
+  keeping_dps_values = kParallel || !settings.approximate_median;
+
+  int stored_iterations = 0;
+  const int kCachedIterations = LoadCachedIterations(stored_iterations);
+
+  if (kParallel) {
+    RunIterationsInParallel(kCachedIterations);
+  } else {
+    RunIterationsUntilConverged(kCachedIterations);
+  }
+
+  StoreCachedIterations(stored_iterations);
+
+  auto end = std::chrono::high_resolution_clock::now();
+  auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  SimulationEnd(microseconds);
+}
+
+void Simulation::RunIterations(int first_iteration, int last_iteration) {
+  // Merged into twin_differences once for the whole block, which is what the parallel mode does with the blocks of
+  // its threads, so that the result doesn't depend on the thread count
+  RunningStatistics block_twin_differences;
+
+  for (iteration = first_iteration; iteration < last_iteration; iteration++) {
+    RunIteration(block_twin_differences);
+  }
+
+  twin_differences.Add(block_twin_differences);
+}
+
+// Simulates the iteration's fight and, in antithetic mode, its twin on the mirrored random numbers, and adds the
+// result. The twin fight isn't in the combat log, the breakdown or the total fight duration, so those still describe
+// one fight per iteration, while the min and max dps and the histogram get the average of the pair.
+// Only the combat log iteration's fight runs the fight code that writes the combat log, see combat_log_policy.h.
+void Simulation::RunIteration(RunningStatistics& block_twin_differences) {
+  const int kFightLength = iteration == kCombatLogIteration && player.equipped_item_simulation
+                               ? RunFight(WritingCombatLog(), false)
+                               : RunFight(NotWritingCombatLog(), false);
+
+  const double kDps = player.iteration_damage / static_cast<double>(kFightLength);
+
+  if (!settings.antithetic_variates) {
+    AddIterationResult(kFightLength, kDps);
+    return;
+  }
+
+  const bool kRecordingCombatLogBreakdown = player.recording_combat_log_breakdown;
+  SetRecordingCombatLogBreakdown(false);
+  const int kTwinFightLength = RunFight(NotWritingCombatLog(), true);
+  SetRecordingCombatLogBreakdown(kRecordingCombatLogBreakdown);
+
+  const double kTwinDps = player.iteration_damage / static_cast<double>(kTwinFightLength);
+  block_twin_differences.Add((kDps - kTwinDps) / 2);
+  AddIterationResult(kFightLength, (kDps + kTwinDps) / 2);
+}
+
+// Returns the fight length
+template <typename CombatLogPolicy>
+int Simulation::RunFight(CombatLogPolicy combat_log, bool mirrored) {
+  // Seed before rolling the fight length so that a fight only depends on the seed, its iteration and whether it's
+  // mirrored
+  const int kFightLength = RollFightLength(player.rng, player.settings.random_seed, iteration, settings, mirrored);
+  player.SeedRngStreams(iteration, mirrored);
+
+  IterationReset(combat_log, kFightLength);
+
+  while (current_fight_time < kFightLength * kFightTimePerSecond) {
+    const double kFightTimeRemaining = kFightLength - FightTimeToSeconds(current_fight_time);
+
+    CastNonPlayerCooldowns(combat_log, kFightTimeRemaining);
+
+    if (player.cast_time_remaining <= 0) {
+      CastNonGcdSpells(combat_log);
+
+      if (player.gcd_remaining <= 0) {
+        CastGcdSpells(combat_log, kFightTimeRemaining);
+      }
+    }
+
+    if (player.pet != NULL && player.settings.pet_mode == EmbindConstant::kAggressive) {
+      CastPetSpells(combat_log);
+    }
+
+    if (PassTime(combat_log) <= 0) {
+      std::cout << "Iteration " << std::to_string(iteration)
+                << " fightTime: " << std::to_string(FightTimeToSeconds(current_fight_time)) << "/"
+                << std::to_string(kFightLength) << " PassTime() returned <= 0" << std::endl;
+      player.ThrowError(
+          "The simulation got stuck in an endless loop. If you'd like to "
+          "help with fixing this bug then please "
+          "export your current settings and send it to Kristofer#8003 on "
+          "Discord.");
+    }
+  }
+
+  IterationEnd(combat_log);
+
+  return kFightLength;
+}
+
+void Simulation::SetRecordingCombatLogBreakdown(bool recording_combat_log_breakdown) {
+  player.recording_combat_log_breakdown = recording_combat_log_breakdown;
+  if (player.pet != NULL) {
+    player.pet->recording_combat_log_breakdown = recording_combat_log_breakdown;
+  }
+}
+
+// Starts the rng on the iteration's stream and rolls the fight length, which is the first thing rolled in an iteration
+int Simulation::RollFightLength(Rng& rng, uint32_t random_seed, int iteration, const SimulationSettings& settings,
+                                bool mirrored) {
+  rng.seed(random_seed, iteration, mirrored);
+  return rng.range(settings.min_time, settings.max_time);
+}
+
+// Runs the iterations in blocks of 1% of the maximum iteration amount and stops after the first block at which the
+// sim has converged. The iterations before first_iteration have already been added (from the result cache), so the
+// first block can be a partial one.
+void Simulation::RunIterationsUntilConverged(int first_iteration) {
+  const int kBlockSize = std::max(1, static_cast<int>(std::floor(settings.iterations / 100.0)));
+
+  while (first_iteration < settings.iterations && !HasConverged()) {
+    const int kLastIteration = std::min((first_iteration / kBlockSize + 1) * kBlockSize, settings.iterations);
+
+    RunIterations(first_iteration, kLastIteration);
+    first_iteration = kLastIteration;
+  }
+}
+
+bool Simulation::HasConverged() const {
+  if (settings.target_standard_error <= 0 || dps_statistics.count < std::max(2, settings.min_iterations)) {
+    return false;
+  }
+
+  const double kTarget = settings.relative_standard_error ? settings.target_standard_error * dps_statistics.mean
+                                                          : settings.target_standard_error;
 
-    IterationReset(kFightLength);
+  return dps_statistics.StandardError() <= kTarget;
+}
 
-    while (current_fight_time < kFightLength) {
-      const double kFightTimeRemaining = kFightLength - current_fight_time;
+// Adds the iterations that this configuration has already been simulated for to the results as if they had just been
+// simulated and returns how many there were. Stops at the first block at which the sim has converged, like
+// RunIterationsUntilConverged() would have. stored_iterations is set to the amount of iterations in the cache entry.
+// The cache isn't used when the combat log or its breakdown is recorded since the cached iterations don't have them.
+int Simulation::LoadCachedIterations(int& stored_iterations) {
+  CachedIterations cached_iterations;
 
-      CastNonPlayerCooldowns(kFightTimeRemaining);
+  if (result_cache == NULL || player.equipped_item_simulation || player.recording_combat_log_breakdown ||
+      !result_cache->load(ConfigHash(player.settings, settings), cached_iterations)) {
+    return 0;
+  }
 
-      if (player.cast_time_remaining <= 0) {
-        CastNonGcdSpells();
+  const int kBlockSize = std::max(1, static_cast<int>(std::floor(settings.iterations / 100.0)));
+  const int kCachedIterations = std::min(static_cast<int>(cached_iterations.dps.size()), settings.iterations);
+  Rng rng;
+
+  stored_iterations = static_cast<int>(cached_iterations.dps.size());
+
+  for (iteration = 0; iteration < kCachedIterations; iteration++) {
+    if (iteration % kBlockSize == 0 && HasConverged()) {
+      break;
+    }
+
+    AddIterationResult(RollFightLength(rng, player.settings.random_seed, iteration, settings),
+                       cached_iterations.dps[iteration]);
+  }
+
+  return iteration;
+}
+
+// Stores the dps of the iterations in the result cache if there are more of them than in its entry
+void Simulation::StoreCachedIterations(int stored_iterations) {
+  if (result_cache == NULL || player.equipped_item_simulation || player.recording_combat_log_breakdown ||
+      !keeping_dps_values || dps_statistics.count <= stored_iterations) {
+    return;
+  }
+
+  CachedIterations cached_iterations;
+  cached_iterations.dps.assign(dps_vector.begin(), dps_vector.begin() + dps_statistics.count);
+  result_cache->store(ConfigHash(player.settings, settings), cached_iterations);
+}
 
-        if (player.gcd_remaining <= 0) {
-          CastGcdSpells(kFightTimeRemaining);
+// Adds the totals from `index` on to the entity's breakdown rows, which were taken from an entity of the same config
+static void AddCombatLogBreakdown(Entity& entity, const std::vector<CombatLogBreakdown>& totals, size_t& index) {
+  for (auto& breakdown : entity.combat_log_breakdown) {
+    breakdown.Add(totals[index++]);
+  }
+}
+
+// Splits the iterations into blocks (one per progress update) that the threads pick up one at a time. Every thread
+// simulates on its own Player/Pet built from the same settings, and since each iteration reseeds from the seed and
+// its index the per-iteration dps is the same as in a serial run. The per-block results are merged in iteration
+// order so the output doesn't depend on the thread count or on scheduling. In adaptive mode the
+// convergence is also checked in iteration order, block by block, so it stops at the same iteration as a serial run.
+// The iterations before first_iteration have already been added (from the result cache).
+void Simulation::RunIterationsInParallel(int first_iteration) {
+  struct BlockResult {
+    bool finished = false;
+    double min_dps = 0;
+    double max_dps = 0;
+    double fight_duration = 0;
+    RunningStatistics twin_differences;
+    std::vector<CombatLogBreakdown> breakdown;
+  };
+
+  const int kBlockSize = std::max(1, static_cast<int>(std::floor(settings.iterations / 100.0)));
+  const int kBlockAmount = (settings.iterations + kBlockSize - 1) / kBlockSize;
+  const int kFirstBlock = first_iteration / kBlockSize;
+  const int kThreadAmount = std::min(settings.threads, kBlockAmount - kFirstBlock);
+  std::vector<BlockResult> blocks(kBlockAmount);
+  int checked_blocks = kFirstBlock;  // The blocks whose dps have been added to dps_statistics
+  bool converged = false;
+  std::atomic<int> next_block = kFirstBlock;
+  int finished_threads = 0;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable progress;
+
+  if (first_iteration >= settings.iterations || HasConverged()) {
+    return;
+  }
+
+  dps_vector.resize(settings.iterations);
+
+  auto run_blocks = [&]() {
+    try {
+      auto worker_player = Player(player.settings);
+      auto worker = Simulation(worker_player, settings);
+      worker.sending_progress_updates = false;
+      worker_player.Initialize(&worker);
+      // The player info is already in the main player's combat log
+      worker_player.combat_log_entries.clear();
+
+      for (int block = next_block++; block < kBlockAmount; block = next_block++) {
+        const int kFirstIteration = std::max(block * kBlockSize, first_iteration);
+
+        worker.dps_vector.clear();
+        worker.min_dps = std::numeric_limits<double>::max();
+        worker.max_dps = 0;
+        worker_player.total_fight_duration = 0;
+        worker.twin_differences = RunningStatistics();
+        worker.RunIterations(kFirstIteration, std::min((block + 1) * kBlockSize, settings.iterations));
+
+        auto& result = blocks[block];
+        if (worker_player.recording_combat_log_breakdown) {
+          worker_player.TakeCombatLogBreakdown(result.breakdown);
+          if (worker_player.pet != NULL) {
+            worker_player.pet->TakeCombatLogBreakdown(result.breakdown);
+          }
         }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          result.finished = true;
+          result.min_dps = worker.min_dps;
+          result.max_dps = worker.max_dps;
+          result.fight_duration = worker_player.total_fight_duration;
+          result.twin_differences = worker.twin_differences;
+          std::copy(worker.dps_vector.begin(), worker.dps_vector.end(), dps_vector.begin() + kFirstIteration);
+          for (const auto& kDps : worker.dps_vector) {
+            median_estimator.Add(kDps);
+          }
+        }
+        progress.notify_one();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      player.combat_log_entries.insert(player.combat_log_entries.end(), worker_player.combat_log_entries.begin(),
+                                       worker_player.combat_log_entries.end());
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next_block = kBlockAmount;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished_threads++;
+    }
+    progress.notify_one();
+  };
+
+  // Called with the mutex locked
+  auto check_finished_blocks = [&]() {
+    while (!converged && checked_blocks < kBlockAmount && blocks[checked_blocks].finished) {
+      const int kFirstIteration = std::max(checked_blocks * kBlockSize, first_iteration);
+
+      for (int i = kFirstIteration; i < std::min((checked_blocks + 1) * kBlockSize, settings.iterations); i++) {
+        dps_statistics.Add(dps_vector[i]);
+      }
+      twin_differences.Add(blocks[checked_blocks].twin_differences);
+      checked_blocks++;
+
+      if (HasConverged()) {
+        converged = true;
+        // Blocks that are already running are still finished but their results aren't used
+        next_block = kBlockAmount;
       }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadAmount; i++) {
+    threads.emplace_back(run_blocks);
+  }
+
+  // The progress updates are sent from the calling thread since that's the one the web worker's JS runs on
+  int reported_iterations = 0;
+  std::unique_lock<std::mutex> lock(mutex);
+  while (finished_threads < kThreadAmount) {
+    progress.wait(lock, [&] {
+      return median_estimator.count != reported_iterations || finished_threads == kThreadAmount;
+    });
+    check_finished_blocks();
+
+    if (median_estimator.count != reported_iterations && !error) {
+      reported_iterations = median_estimator.count;
+      const double kMedianDps = median_estimator.Value();
+      lock.unlock();
+      SimulationUpdate(reported_iterations, settings.iterations, kMedianDps, player.settings.item_id,
+                       player.custom_stat.c_str());
+      lock.lock();
+    }
+  }
+  check_finished_blocks();
+  lock.unlock();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  dps_vector.resize(dps_statistics.count);
+  for (int block = kFirstBlock; block < checked_blocks; block++) {
+    const auto& kResult = blocks[block];
 
-      if (player.pet != NULL && player.settings.pet_mode == EmbindConstant::kAggressive) {
-        CastPetSpells();
+    min_dps = std::min(min_dps, kResult.min_dps);
+    max_dps = std::max(max_dps, kResult.max_dps);
+    player.total_fight_duration += kResult.fight_duration;
+
+    if (player.recording_combat_log_breakdown) {
+      size_t index = 0;
+      AddCombatLogBreakdown(player, kResult.breakdown, index);
+      if (player.pet != NULL) {
+        AddCombatLogBreakdown(*player.pet, kResult.breakdown, index);
       }
+    }
+  }
+
+  if (settings.simulation_type == SimulationType::kNormal && player.custom_stat == "normal") {
+    // The cached iterations have already been sent
+    for (size_t i = first_iteration; i < dps_vector.size(); i++) {
+      DpsUpdate(dps_vector[i]);
+    }
+  }
+}
+
+// The stats that stat weights are calculated for, with the names the web worker uses for them
+static const std::vector<std::pair<EmbindConstant, std::string>> kStatWeightStats{
+    {EmbindConstant::kStamina, "stamina"},         {EmbindConstant::kIntellect, "intellect"},
+    {EmbindConstant::kSpirit, "spirit"},           {EmbindConstant::kSpellPower, "spellPower"},
+    {EmbindConstant::kShadowPower, "shadowPower"}, {EmbindConstant::kFirePower, "firePower"},
+    {EmbindConstant::kHitRating, "hitRating"},     {EmbindConstant::kCritRating, "critRating"},
+    {EmbindConstant::kHasteRating, "hasteRating"}, {EmbindConstant::kMp5, "mp5"}};
+
+static void IncreaseStat(CharacterStats& stats, EmbindConstant stat, double amount) {
+  if (stat == EmbindConstant::kStamina) {
+    stats.stamina += amount;
+  } else if (stat == EmbindConstant::kIntellect) {
+    stats.intellect += amount;
+  } else if (stat == EmbindConstant::kSpirit) {
+    stats.spirit += amount;
+  } else if (stat == EmbindConstant::kSpellPower) {
+    stats.spell_power += amount;
+  } else if (stat == EmbindConstant::kShadowPower) {
+    stats.shadow_power += amount;
+  } else if (stat == EmbindConstant::kFirePower) {
+    stats.fire_power += amount;
+  } else if (stat == EmbindConstant::kHitRating) {
+    stats.spell_hit_rating += amount;
+  } else if (stat == EmbindConstant::kCritRating) {
+    stats.spell_crit_rating += amount;
+  } else if (stat == EmbindConstant::kHasteRating) {
+    stats.spell_haste_rating += amount;
+  } else if (stat == EmbindConstant::kMp5) {
+    stats.mp5 += amount;
+  }
+}
+
+// Simulates the player and one copy of it per stat with that stat increased, all on the same seeds. The stat weights
+// are the mean of the per-iteration dps differences to the unchanged player, which has a much smaller variance than
+// the difference between two independently simulated medians.
+void Simulation::StartStatWeights() {
+  auto start = std::chrono::high_resolution_clock::now();
+  auto batch = BatchSimulation(settings);
+  // The cached iterations don't have the breakdown, like in LoadCachedIterations()
+  batch.result_cache = player.recording_combat_log_breakdown ? NULL : result_cache;
+  std::vector<double> stat_increases;
+
+  batch.AddConfig(player.settings).custom_stat = EmbindConstant::kNormal;
+
+  for (const auto& kStat : kStatWeightStats) {
+    auto increase = static_cast<double>(settings.stat_weight_increase);
+
+    // Remove hit rating instead if the player isn't hit capped but adding it would overcap them, so it doesn't get
+    // wasted
+    if (kStat.first == EmbindConstant::kHitRating &&
+        player.stats.extra_spell_hit_chance <= StatConstant::kHitPercentCap - 0.01 &&
+        player.stats.extra_spell_hit_chance + increase / StatConstant::kHitRatingPerPercent >
+            StatConstant::kHitPercentCap) {
+      increase *= -1;
+    }
+
+    auto& config = batch.AddConfig(player.settings);
+    config.custom_stat = kStat.first;
+    IncreaseStat(config.stats, kStat.first, increase);
+    stat_increases.push_back(increase);
+  }
+
+  int simulated_iterations = 0;
 
-      if (PassTime() <= 0) {
-        std::cout << "Iteration " << std::to_string(iteration) << " fightTime: " << std::to_string(current_fight_time)
-                  << "/" << std::to_string(kFightLength) << " PassTime() returned <= 0" << std::endl;
-        player.ThrowError(
-            "The simulation got stuck in an endless loop. If you'd like to "
-            "help with fixing this bug then please "
-            "export your current settings and send it to Kristofer#8003 on "
-            "Discord.");
+  batch.Run(0, settings.iterations, [&](int config, int first_iteration, int last_iteration) {
+    simulated_iterations += last_iteration - first_iteration;
+
+    // The progress updates show the median of the unchanged player
+    if (config == 0) {
+      for (int i = first_iteration; i < last_iteration; i++) {
+        median_estimator.Add(batch.dps[0][i]);
       }
+      SimulationUpdate(simulated_iterations / static_cast<int>(batch.configs.size()), settings.iterations,
+                       median_estimator.Value(), player.settings.item_id, "normal");
+    }
+  });
+
+  for (size_t i = 0; i < kStatWeightStats.size(); i++) {
+    const auto& kStatDps = batch.dps[i + 1];
+    RunningStatistics differences;
+
+    for (int iteration = 0; iteration < settings.iterations; iteration++) {
+      differences.Add(kStatDps[iteration] - batch.dps[0][iteration]);
     }
 
-    IterationEnd(kFightLength, player.iteration_damage / static_cast<double>(kFightLength));
+    // Report the difference as if the stat was added even when it was removed
+    const double kSign = stat_increases[i] < 0 ? -1 : 1;
+
+    SendStatWeightResult(kStatWeightStats[i].second.c_str(), kSign * differences.mean, differences.StandardError());
   }
 
   auto end = std::chrono::high_resolution_clock::now();
   auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
-  SimulationEnd(microseconds);
+  for (const auto& kDps : batch.dps[0]) {
+    dps_statistics.Add(kDps);
+  }
+
+  SendCombatLogBreakdown(batch.breakdowns[0], player.settings.item_id, "normal");
+
+  // The batch doesn't keep the differences between the antithetic twins, and the cached iterations don't have them,
+  // so the effective iterations aren't known
+  SendSimulationResults(Median(batch.dps[0]), *std::min_element(batch.dps[0].begin(), batch.dps[0].end()),
+                        *std::max_element(batch.dps[0].begin(), batch.dps[0].end()), player.settings.item_id,
+                        settings.iterations, 0, dps_statistics.ConfidenceInterval(),
+                        static_cast<int>(batch.total_fight_durations[0]), "normal", microseconds);
+}
+
+static RunningStatistics DpsStatistics(const std::vector<double>& dps, int iteration_amount) {
+  RunningStatistics statistics;
+
+  for (int i = 0; i < iteration_amount; i++) {
+    statistics.Add(dps[i]);
+  }
+
+  return statistics;
+}
+
+// Simulates the player once per item candidate in a single batch instead of starting a new simulation per item, and
+// sends a result per item.
+// In racing mode the items are simulated in rounds that end at 1/16, 1/8, 1/4, 1/2 and all of the iterations. After
+// every round the items that are worse than the best item with 95% confidence are dropped and get their result right
+// away, so only the items that are close to the best one are simulated with every iteration, and the race ends
+// early once only the best item is left. The items are compared
+// iteration by iteration since they're simulated on the same seeds, which tells them apart a lot sooner than their
+// confidence intervals would on their own.
+// A race makes one comparison per item and round, so with a 95% confidence per comparison some items that are as good
+// as the best one would be dropped by chance whenever there are many items. The confidence is Bonferroni corrected
+// instead: each comparison uses 2.5% divided by the amount of comparisons the race can make as its one-sided error
+// rate, so the chance that any item is wrongly dropped stays below 2.5%, the same as a single comparison's.
+// The batch configs don't write a combat log, so when this player is set up with the equipped item its combat log
+// iteration is simulated on its own first, like a normal sim of it would have written it.
+void Simulation::StartAllItems(const std::vector<ItemCandidate>& item_candidates) {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  if (player.equipped_item_simulation) {
+    sending_progress_updates = false;
+    player.Initialize(this);
+    RunIterations(kCombatLogIteration, kCombatLogIteration + 1);
+    player.SendCombatLogEntries();
+  }
+
+  auto batch = BatchSimulation(settings);
+  // The cached iterations don't have the breakdown, like in LoadCachedIterations()
+  batch.result_cache = player.recording_combat_log_breakdown ? NULL : result_cache;
+
+  for (const auto& kCandidate : item_candidates) {
+    auto& config = batch.AddConfig(player.settings);
+    config.item_id = kCandidate.item_id;
+    config.meta_gem_id = kCandidate.meta_gem_id;
+    config.items = kCandidate.items;
+    config.sets = kCandidate.sets;
+    config.stats = kCandidate.stats;
+  }
+
+  const int kCandidateAmount = static_cast<int>(item_candidates.size());
+  std::vector<QuantileEstimator> median_estimators(kCandidateAmount);
+  int simulated_iterations = 0;
+
+  auto round_end = [&](int first_iteration) {
+    return settings.racing
+               ? std::min(settings.iterations, std::max({settings.iterations / 16, first_iteration * 2, 1}))
+               : settings.iterations;
+  };
+
+  // Every round but the last one compares the other items to the best one
+  int comparison_amount = 0;
+  for (int i = round_end(0); i < settings.iterations; i = round_end(i)) {
+    comparison_amount += kCandidateAmount - 1;
+  }
+  const double kDropZ = StandardNormalQuantile(1 - 0.025 / std::max(1, comparison_amount));
+
+  // The effective iterations aren't known, like in StartStatWeights()
+  auto send_result = [&](int config) {
+    const auto& kDps = batch.dps[config];
+    const auto kStatistics = DpsStatistics(kDps, simulated_iterations);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    SendCombatLogBreakdown(batch.breakdowns[config], item_candidates[config].item_id, "normal");
+    SendSimulationResults(Median(std::vector<double>(kDps.begin(), kDps.begin() + simulated_iterations)),
+                          *std::min_element(kDps.begin(), kDps.begin() + simulated_iterations),
+                          *std::max_element(kDps.begin(), kDps.begin() + simulated_iterations),
+                          item_candidates[config].item_id, simulated_iterations, 0,
+                          kStatistics.ConfidenceInterval(), static_cast<int>(batch.total_fight_durations[config]),
+                          "normal", microseconds);
+  };
+
+  while (simulated_iterations < settings.iterations) {
+    const int kLastIteration = round_end(simulated_iterations);
+
+    batch.Run(simulated_iterations, kLastIteration, [&](int config, int first_iteration, int last_iteration) {
+      for (int i = first_iteration; i < last_iteration; i++) {
+        median_estimators[config].Add(batch.dps[config][i]);
+      }
+      SimulationUpdate(median_estimators[config].count, settings.iterations, median_estimators[config].Value(),
+                       item_candidates[config].item_id, "normal");
+    });
+    simulated_iterations = kLastIteration;
+
+    if (simulated_iterations == settings.iterations) {
+      break;
+    }
+
+    int best_config = -1;
+    auto best_mean_dps = 0.0;
+
+    for (int config = 0; config < kCandidateAmount; config++) {
+      if (!batch.active[config]) {
+        continue;
+      }
+
+      const double kMeanDps = DpsStatistics(batch.dps[config], simulated_iterations).mean;
+
+      if (best_config == -1 || kMeanDps > best_mean_dps) {
+        best_config = config;
+        best_mean_dps = kMeanDps;
+      }
+    }
+
+    for (int config = 0; config < kCandidateAmount; config++) {
+      if (!batch.active[config] || config == best_config) {
+        continue;
+      }
+
+      RunningStatistics differences;
+      for (int i = 0; i < simulated_iterations; i++) {
+        differences.Add(batch.dps[best_config][i] - batch.dps[config][i]);
+      }
+
+      if (differences.mean - differences.ConfidenceInterval(kDropZ) > 0) {
+        batch.active[config] = false;
+        send_result(config);
+      }
+    }
+
+    // The ranking is settled once only the best item is left
+    if (std::count(batch.active.begin(), batch.active.end(), true) <= 1) {
+      break;
+    }
+  }
+
+  for (int config = 0; config < kCandidateAmount; config++) {
+    if (batch.active[config]) {
+      send_result(config);
+    }
+  }
 }
 
-double Simulation::PassTime() {
+template <typename CombatLogPolicy>
+FightTime Simulation::PassTime(CombatLogPolicy combat_log) {
   auto time_until_next_action = player.FindTimeUntilNextAction();
 
-  Tick(time_until_next_action);
+  Tick(combat_log, time_until_next_action);
 
   return time_until_next_action;
 }
 
-void Simulation::SelectedSpellHandler(const std::shared_ptr<Spell>& spell,
-                                      std::map<std::shared_ptr<Spell>, double>& predicted_damage_of_spells,
-                                      double fight_time_remaining) {
+template <typename CombatLogPolicy>
+void Simulation::SelectedSpellHandler(CombatLogPolicy combat_log, Spell* spell, double fight_time_remaining) {
   if ((player.settings.rotation_option == EmbindConstant::kSimChooses || spell->is_finisher) &&
-      predicted_damage_of_spells.count(spell) == 0) {
-    predicted_damage_of_spells.insert({spell, spell->PredictDamage()});
+      !IsDamagePredicted(spell)) {
+    predicted_damage_of_spells.push_back({spell, spell->PredictDamage()});
   } else if (spell->HasEnoughMana()) {
-    CastSelectedSpell(spell, fight_time_remaining);
+    CastSelectedSpell(combat_log, spell, fight_time_remaining);
   } else {
-    player.CastLifeTapOrDarkPact();
+    player.CastLifeTapOrDarkPact(combat_log);
   }
 }
 
-void Simulation::CastSelectedSpell(const std::shared_ptr<Spell>& spell, double fight_time_remaining,
+bool Simulation::IsDamagePredicted(Spell* spell) const {
+  for (const auto& kPrediction : predicted_damage_of_spells) {
+    if (kPrediction.first == spell) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <typename CombatLogPolicy>
+void Simulation::CastSelectedSpell(CombatLogPolicy combat_log, Spell* spell, double fight_time_remaining,
                                    double predicted_damage) {
-  player.UseCooldowns(fight_time_remaining);
+  player.UseCooldowns(combat_log, fight_time_remaining);
 
   if (player.spells.amplify_curse != NULL && player.spells.amplify_curse->Ready() &&
-      (spell->name == SpellName::kCurseOfAgony || spell->name == SpellName::kCurseOfDoom)) {
-    player.spells.amplify_curse->StartCast();
+      (spell->id == SpellId::kCurseOfAgony || spell->id == SpellId::kCurseOfDoom)) {
+    player.spells.amplify_curse->StartCast(combat_log);
   }
 
-  spell->StartCast(predicted_damage);
+  spell->StartCast(combat_log, predicted_damage);
 }
 
-void Simulation::Tick(double time) {
+template <typename CombatLogPolicy>
+void Simulation::Tick(CombatLogPolicy combat_log, FightTime time) {
   current_fight_time += time;
-  player.Tick(time);
+  player.Tick(combat_log, time);
   if (player.pet != NULL) {
-    player.pet->Tick(time);
+    player.pet->Tick(combat_log, time);
   }
 }
 
-void Simulation::IterationReset(double fight_length) {
+template <typename CombatLogPolicy>
+void Simulation::IterationReset(CombatLogPolicy combat_log, double fight_length) {
   current_fight_time = 0;
   player.Reset();
   if (player.pet != NULL) {
     player.pet->Reset();
   }
-  player.rng.seed(player.settings.random_seeds[iteration]);
-
-  if (player.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     player.CombatLog("Fight length: " + DoubleToString(fight_length) + " seconds");
   }
 
   if (player.auras.airmans_ribbon_of_gallantry != NULL) {
-    player.auras.airmans_ribbon_of_gallantry->Apply();
+    player.auras.airmans_ribbon_of_gallantry->Apply(combat_log);
   }
 
   if (player.auras.fel_energy != NULL) {
-    player.auras.fel_energy->Apply();
+    player.auras.fel_energy->Apply(combat_log);
   }
 
   if (player.pet != NULL) {
     if (player.pet->auras.battle_squawk != NULL) {
-      player.pet->auras.battle_squawk->Apply();
+      player.pet->auras.battle_squawk->Apply(combat_log);
     }
 
     if (player.settings.prepop_black_book && player.pet->auras.black_book != NULL) {
-      player.pet->auras.black_book->Apply();
+      player.pet->auras.black_book->Apply(combat_log);
     }
   }
 }
 
-void Simulation::CastNonPlayerCooldowns(double fight_time_remaining) {
+template <typename CombatLogPolicy>
+void Simulation::CastNonPlayerCooldowns(CombatLogPolicy combat_log, double fight_time_remaining) {
   // Use Drums
   if (player.spells.drums_of_battle != NULL && !player.auras.drums_of_battle->active &&
       player.spells.drums_of_battle->Ready()) {
-    player.spells.drums_of_battle->StartCast();
+    player.spells.drums_of_battle->StartCast(combat_log);
   } else if (player.spells.drums_of_war != NULL && !player.auras.drums_of_war->active &&
              player.spells.drums_of_war->Ready()) {
-    player.spells.drums_of_war->StartCast();
+    player.spells.drums_of_war->StartCast(combat_log);
   } else if (player.spells.drums_of_restoration != NULL && !player.auras.drums_of_restoration->active &&
              player.spells.drums_of_restoration->Ready()) {
-    player.spells.drums_of_restoration->StartCast();
+    player.spells.drums_of_restoration->StartCast(combat_log);
   }
 
   // Use Bloodlust
   if (!player.spells.bloodlust.empty() && !player.auras.bloodlust->active) {
     for (auto& bloodlust : player.spells.bloodlust) {
       if (bloodlust->Ready()) {
-        bloodlust->StartCast();
+        bloodlust->StartCast(combat_log);
         break;
       }
     }
@@ -163,89 +764,92 @@ void Simulation::CastNonPlayerCooldowns(double fight_time_remaining) {
   if (player.spells.mana_tide_totem != NULL && player.spells.mana_tide_totem->Ready() &&
       (fight_time_remaining <= player.auras.mana_tide_totem->duration ||
        player.stats.mana / static_cast<double>(player.stats.max_mana) <= 0.50)) {
-    player.spells.mana_tide_totem->StartCast();
+    player.spells.mana_tide_totem->StartCast(combat_log);
   }
 }
 
-void Simulation::CastNonGcdSpells() {
+template <typename CombatLogPolicy>
+void Simulation::CastNonGcdSpells(CombatLogPolicy combat_log) {
   // Demonic Rune
-  if ((current_fight_time > 5 || player.stats.mp5 == 0) && player.spells.demonic_rune != NULL &&
+  if ((current_fight_time > 5 * kFightTimePerSecond || player.stats.mp5 == 0) && player.spells.demonic_rune != NULL &&
       (player.stats.max_mana - player.stats.mana) > player.spells.demonic_rune->max_mana_gain &&
       player.spells.demonic_rune->Ready() &&
       (!player.spells.chipped_power_core || !player.spells.chipped_power_core->Ready()) &&
       (!player.spells.cracked_power_core || !player.spells.cracked_power_core->Ready())) {
-    player.spells.demonic_rune->StartCast();
+    player.spells.demonic_rune->StartCast(combat_log);
   }
 
   // Super Mana Potion
-  if ((current_fight_time > 5 || player.stats.mp5 == 0) && player.spells.super_mana_potion != NULL &&
+  if ((current_fight_time > 5 * kFightTimePerSecond || player.stats.mp5 == 0) &&
+      player.spells.super_mana_potion != NULL &&
       (player.stats.max_mana - player.stats.mana) > player.spells.super_mana_potion->max_mana_gain &&
       player.spells.super_mana_potion->Ready()) {
-    player.spells.super_mana_potion->StartCast();
+    player.spells.super_mana_potion->StartCast(combat_log);
   }
 }
 
-void Simulation::CastGcdSpells(double fight_time_remaining) {
+template <typename CombatLogPolicy>
+void Simulation::CastGcdSpells(CombatLogPolicy combat_log, double fight_time_remaining) {
   if (player.settings.fight_type == EmbindConstant::kSingleTarget) {
     const bool kNotEnoughTimeForFillerSpell = fight_time_remaining < player.filler->GetCastTime();
 
-    // Map of spells with their predicted Damage as the value. This is
-    // used by the sim to determine what the best spell to Cast is.
-    std::map<std::shared_ptr<Spell>, double> predicted_damage_of_spells;
+    // The spells with their predicted Damage. This is used by the sim to
+    // determine what the best spell to Cast is.
+    predicted_damage_of_spells.clear();
 
     // If the sim is choosing the rotation for the user then predict the
     // damage of the three filler spells if they're available
     if (player.settings.rotation_option == EmbindConstant::kSimChooses) {
       if (fight_time_remaining >= player.spells.shadow_bolt->GetCastTime()) {
-        predicted_damage_of_spells.insert({player.spells.shadow_bolt, player.spells.shadow_bolt->PredictDamage()});
+        predicted_damage_of_spells.push_back({player.spells.shadow_bolt, player.spells.shadow_bolt->PredictDamage()});
       }
 
       if (fight_time_remaining >= player.spells.incinerate->GetCastTime()) {
-        predicted_damage_of_spells.insert({player.spells.incinerate, player.spells.incinerate->PredictDamage()});
+        predicted_damage_of_spells.push_back({player.spells.incinerate, player.spells.incinerate->PredictDamage()});
       }
 
       if (fight_time_remaining >= player.spells.searing_pain->GetCastTime()) {
-        predicted_damage_of_spells.insert({player.spells.searing_pain, player.spells.searing_pain->PredictDamage()});
+        predicted_damage_of_spells.push_back({player.spells.searing_pain, player.spells.searing_pain->PredictDamage()});
       }
     }
 
     // Cast Conflagrate if there's not enough time for another filler
     // and Immolate is up
     if (kNotEnoughTimeForFillerSpell && player.spells.conflagrate != NULL && player.spells.conflagrate->CanCast()) {
-      SelectedSpellHandler(player.spells.conflagrate, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.conflagrate, fight_time_remaining);
     }
 
     // Cast Shadowburn if there's not enough time for another filler
     if (player.gcd_remaining <= 0 && kNotEnoughTimeForFillerSpell && player.spells.shadowburn != NULL &&
         player.spells.shadowburn->CanCast()) {
-      SelectedSpellHandler(player.spells.shadowburn, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.shadowburn, fight_time_remaining);
     }
 
     // Cast Death Coil if there's not enough time for another filler
     if (player.gcd_remaining <= 0 && kNotEnoughTimeForFillerSpell && player.spells.death_coil != NULL &&
         player.spells.death_coil->CanCast()) {
-      SelectedSpellHandler(player.spells.death_coil, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.death_coil, fight_time_remaining);
     }
 
     // Cast Curse of the Elements or Curse of Recklessness if they're
     // the selected curse and they're not active
     if (fight_time_remaining >= 10 && player.gcd_remaining <= 0 && player.curse_spell != NULL &&
-        (player.curse_spell->name == SpellName::kCurseOfRecklessness ||
-         player.curse_spell->name == SpellName::kCurseOfTheElements) &&
+        (player.curse_spell->id == SpellId::kCurseOfRecklessness ||
+         player.curse_spell->id == SpellId::kCurseOfTheElements) &&
         !player.curse_aura->active && player.curse_spell->CanCast()) {
       if (player.curse_spell->HasEnoughMana()) {
-        player.curse_spell->StartCast();
+        player.curse_spell->StartCast(combat_log);
       } else {
-        player.CastLifeTapOrDarkPact();
+        player.CastLifeTapOrDarkPact(combat_log);
       }
     }
 
     // Cast Curse of Doom if it's the selected curse and there's more
     // than 60 seconds remaining
     if (player.gcd_remaining <= 0 && fight_time_remaining > 60 && player.curse_spell != NULL &&
-        player.curse_spell->name == SpellName::kCurseOfDoom && !player.auras.curse_of_doom->active &&
+        player.curse_spell->id == SpellId::kCurseOfDoom && !player.auras.curse_of_doom->active &&
         player.spells.curse_of_doom->CanCast()) {
-      SelectedSpellHandler(player.spells.curse_of_doom, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.curse_of_doom, fight_time_remaining);
     }
 
     // Cast Curse of Agony if CoA is the selected curse or if Curse of
@@ -253,11 +857,11 @@ void Simulation::CastGcdSpells(double fight_time_remaining) {
     // remaining of the fight
     if (player.gcd_remaining <= 0 && player.auras.curse_of_agony != NULL && !player.auras.curse_of_agony->active &&
         player.spells.curse_of_agony->CanCast() && fight_time_remaining > player.auras.curse_of_agony->duration &&
-        ((player.curse_spell->name == SpellName::kCurseOfDoom && !player.auras.curse_of_doom->active &&
-          (player.spells.curse_of_doom->cooldown_remaining > player.auras.curse_of_agony->duration ||
+        ((player.curse_spell->id == SpellId::kCurseOfDoom && !player.auras.curse_of_doom->active &&
+          (player.spells.curse_of_doom->GetCooldownRemaining() > player.auras.curse_of_agony->duration ||
            fight_time_remaining < 60)) ||
-         player.curse_spell->name == SpellName::kCurseOfAgony)) {
-      SelectedSpellHandler(player.spells.curse_of_agony, predicted_damage_of_spells, fight_time_remaining);
+         player.curse_spell->id == SpellId::kCurseOfAgony)) {
+      SelectedSpellHandler(combat_log, player.spells.curse_of_agony, fight_time_remaining);
     }
 
     // Cast Corruption if Corruption isn't up or if it will expire
@@ -265,10 +869,10 @@ void Simulation::CastGcdSpells(double fight_time_remaining) {
     if (player.gcd_remaining <= 0 && player.spells.corruption != NULL &&
         (!player.auras.corruption->active ||
          (player.auras.corruption->ticks_remaining == 1 &&
-          player.auras.corruption->tick_timer_remaining < player.spells.corruption->GetCastTime())) &&
+          player.auras.corruption->GetTickTimerRemaining() < player.spells.corruption->GetCastTime())) &&
         player.spells.corruption->CanCast() &&
         (fight_time_remaining - player.spells.corruption->GetCastTime()) >= player.auras.corruption->duration) {
-      SelectedSpellHandler(player.spells.corruption, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.corruption, fight_time_remaining);
     }
 
     // Cast Shadow Bolt if Shadow Trance (Nightfall) is active and
@@ -276,7 +880,7 @@ void Simulation::CastGcdSpells(double fight_time_remaining) {
     // Nightfall proc
     if (player.gcd_remaining <= 0 && player.spells.shadow_bolt != NULL && player.auras.shadow_trance != NULL &&
         player.auras.shadow_trance->active && player.auras.corruption->active && player.spells.shadow_bolt->CanCast()) {
-      SelectedSpellHandler(player.spells.shadow_bolt, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.shadow_bolt, fight_time_remaining);
     }
 
     // Cast Unstable Affliction if it's not up or if it's about to
@@ -285,52 +889,53 @@ void Simulation::CastGcdSpells(double fight_time_remaining) {
         player.spells.unstable_affliction->CanCast() &&
         (!player.auras.unstable_affliction->active ||
          (player.auras.unstable_affliction->ticks_remaining == 1 &&
-          player.auras.unstable_affliction->tick_timer_remaining < player.spells.unstable_affliction->GetCastTime())) &&
+          player.auras.unstable_affliction->GetTickTimerRemaining() <
+              player.spells.unstable_affliction->GetCastTime())) &&
         (fight_time_remaining - player.spells.unstable_affliction->GetCastTime()) >=
             player.auras.unstable_affliction->duration) {
-      SelectedSpellHandler(player.spells.unstable_affliction, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.unstable_affliction, fight_time_remaining);
     }
 
     // Cast Siphon Life if it's not up (todo: add option to only Cast it
     // while ISB is active if not using custom ISB uptime %)
     if (player.gcd_remaining <= 0 && player.spells.siphon_life != NULL && !player.auras.siphon_life->active &&
         player.spells.siphon_life->CanCast() && fight_time_remaining >= player.auras.siphon_life->duration) {
-      SelectedSpellHandler(player.spells.siphon_life, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.siphon_life, fight_time_remaining);
     }
 
     // Cast Immolate if it's not up or about to expire
     if (player.gcd_remaining <= 0 && player.spells.immolate != NULL && player.spells.immolate->CanCast() &&
         (!player.auras.immolate->active ||
          (player.auras.immolate->ticks_remaining == 1 &&
-          player.auras.immolate->tick_timer_remaining < player.spells.immolate->GetCastTime())) &&
+          player.auras.immolate->GetTickTimerRemaining() < player.spells.immolate->GetCastTime())) &&
         (fight_time_remaining - player.spells.immolate->GetCastTime()) >= player.auras.immolate->duration) {
-      SelectedSpellHandler(player.spells.immolate, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.immolate, fight_time_remaining);
     }
 
     // Cast Shadow Bolt if Shadow Trance (Nightfall) is active
     if (player.gcd_remaining <= 0 && player.spells.shadow_bolt != NULL && player.auras.shadow_trance != NULL &&
         player.auras.shadow_trance->active && player.spells.shadow_bolt->CanCast()) {
-      SelectedSpellHandler(player.spells.shadow_bolt, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.shadow_bolt, fight_time_remaining);
     }
 
     // Cast Shadowfury
     if (player.gcd_remaining <= 0 && player.spells.shadowfury != NULL && player.spells.shadowfury->CanCast()) {
-      SelectedSpellHandler(player.spells.shadowfury, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.spells.shadowfury, fight_time_remaining);
     }
 
     // Cast filler spell if sim is not choosing the rotation for the
-    // user or if the predicted_damage_of_spells map is empty
+    // user or if no damage has been predicted yet
     if (player.gcd_remaining <= 0 &&
         ((!kNotEnoughTimeForFillerSpell && player.settings.rotation_option == EmbindConstant::kUserChooses) ||
          predicted_damage_of_spells.size() == 0) &&
         player.filler->CanCast()) {
-      SelectedSpellHandler(player.filler, predicted_damage_of_spells, fight_time_remaining);
+      SelectedSpellHandler(combat_log, player.filler, fight_time_remaining);
     }
 
-    // If the predicted_damage_of_spells map is not empty then check now
+    // If the damage of any spells has been predicted then check now
     // which spell would be the best to Cast
     if (player.gcd_remaining <= 0 && player.cast_time_remaining <= 0 && predicted_damage_of_spells.size() != 0) {
-      std::shared_ptr<Spell> max_damage_spell;
+      Spell* max_damage_spell = NULL;
       auto max_damage_spell_value = 0.0;
 
       for (auto& spell : predicted_damage_of_spells) {
@@ -344,32 +949,33 @@ void Simulation::CastGcdSpells(double fight_time_remaining) {
       // If a max Damage spell was not found or if the max Damage spell
       // isn't Ready (no mana), then Cast Life Tap
       if (max_damage_spell != NULL && max_damage_spell->HasEnoughMana()) {
-        CastSelectedSpell(max_damage_spell, fight_time_remaining, max_damage_spell_value);
+        CastSelectedSpell(combat_log, max_damage_spell, fight_time_remaining, max_damage_spell_value);
       } else {
-        player.CastLifeTapOrDarkPact();
+        player.CastLifeTapOrDarkPact(combat_log);
       }
     }
   }
   // AoE (currently just does Seed of Corruption by default)
   else {
     if (player.spells.seed_of_corruption->Ready()) {
-      player.UseCooldowns(fight_time_remaining);
-      player.spells.seed_of_corruption->StartCast();
+      player.UseCooldowns(combat_log, fight_time_remaining);
+      player.spells.seed_of_corruption->StartCast(combat_log);
     } else {
-      player.CastLifeTapOrDarkPact();
+      player.CastLifeTapOrDarkPact(combat_log);
     }
   }
 }
 
-void Simulation::CastPetSpells() {
+template <typename CombatLogPolicy>
+void Simulation::CastPetSpells(CombatLogPolicy combat_log) {
   // Auto Attack
   if (player.pet->spells.melee != NULL && player.pet->spells.melee->Ready()) {
-    player.pet->spells.melee->StartCast();
+    player.pet->spells.melee->StartCast(combat_log);
   }
 
   // Felguard Cleave
   if (player.pet->spells.cleave != NULL && player.pet->spells.cleave->Ready()) {
-    player.pet->spells.cleave->StartCast();
+    player.pet->spells.cleave->StartCast(combat_log);
   }
 
   // Succubus Lash of Pain
@@ -377,25 +983,30 @@ void Simulation::CastPetSpells() {
       (player.settings.lash_of_pain_usage == EmbindConstant::kOnCooldown ||
        (!player.settings.using_custom_isb_uptime &&
         (player.auras.improved_shadow_bolt == NULL || !player.auras.improved_shadow_bolt->active)))) {
-    player.pet->spells.lash_of_pain->StartCast();
+    player.pet->spells.lash_of_pain->StartCast(combat_log);
   }
 
   // Imp Firebolt
   if (player.pet->spells.firebolt != NULL && player.pet->spells.firebolt->Ready()) {
-    player.pet->spells.firebolt->StartCast();
+    player.pet->spells.firebolt->StartCast(combat_log);
   }
 }
 
-void Simulation::IterationEnd(double fight_length, double dps) {
-  player.EndAuras();
+template <typename CombatLogPolicy>
+void Simulation::IterationEnd(CombatLogPolicy combat_log) {
+  player.EndAuras(combat_log);
   if (player.pet != NULL) {
-    player.pet->EndAuras();
+    player.pet->EndAuras(combat_log);
   }
 
-  if (player.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     player.CombatLog("Fight end");
   }
+}
 
+// Adds the iteration to the results and sends the progress updates for it. Also used for the cached iterations, which
+// aren't simulated.
+void Simulation::AddIterationResult(double fight_length, double dps) {
   player.total_fight_duration += fight_length;
 
   if (dps > max_dps) {
@@ -406,7 +1017,16 @@ void Simulation::IterationEnd(double fight_length, double dps) {
     min_dps = dps;
   }
 
-  dps_vector.push_back(dps);
+  if (keeping_dps_values) {
+    dps_vector.push_back(dps);
+  }
+  dps_statistics.Add(dps);
+
+  if (!sending_progress_updates) {
+    return;
+  }
+
+  median_estimator.Add(dps);
 
   // Only send the iteration's dps to the web worker if we're doing a normal
   // simulation (this is just for the dps histogram)
@@ -414,12 +1034,25 @@ void Simulation::IterationEnd(double fight_length, double dps) {
     DpsUpdate(dps);
   }
 
-  if (iteration % static_cast<int>(std::floor(settings.iterations / 100.0)) == 0) {
-    SimulationUpdate(iteration, settings.iterations, Median(dps_vector), player.settings.item_id,
+  if (iteration % std::max(1, static_cast<int>(std::floor(settings.iterations / 100.0))) == 0) {
+    SimulationUpdate(iteration, settings.iterations, median_estimator.Value(), player.settings.item_id,
                      player.custom_stat.c_str());
   }
 }
 
+// The amount of independent fights that would have given the same standard error, which is more than the amount of
+// iterations when their antithetic twins cancel out some of each other's variance. A single fight's variance is the
+// variance of the averages of the pairs plus that of half their differences.
+double Simulation::EffectiveIterations() const {
+  const double kPairVariance = dps_statistics.Variance();
+
+  if (!settings.antithetic_variates || kPairVariance <= 0) {
+    return dps_statistics.count;
+  }
+
+  return dps_statistics.count * (kPairVariance + twin_differences.Variance()) / kPairVariance;
+}
+
 void Simulation::SimulationEnd(long long simulation_duration) {
   // Send the contents of the combat log to the web worker
   if (player.equipped_item_simulation) {
@@ -428,13 +1061,18 @@ void Simulation::SimulationEnd(long long simulation_duration) {
 
   // Send the combat log breakdown info
   if (player.recording_combat_log_breakdown) {
-    player.SendCombatLogBreakdown();
+    SendCombatLogBreakdown(player.combat_log_breakdown, player.settings.item_id, player.custom_stat.c_str());
 
     if (player.pet != NULL) {
-      player.pet->SendCombatLogBreakdown();
+      SendCombatLogBreakdown(player.pet->combat_log_breakdown, player.settings.item_id, player.custom_stat.c_str());
     }
   }
 
-  SendSimulationResults(Median(dps_vector), min_dps, max_dps, player.settings.item_id, settings.iterations,
+  // The dps values aren't kept when the sim was asked for an approximate median
+  const double kMedianDps = keeping_dps_values ? Median(dps_vector) : median_estimator.Value();
+
+  // Adaptive sims can stop before the maximum amount of iterations
+  SendSimulationResults(kMedianDps, min_dps, max_dps, player.settings.item_id, dps_statistics.count,
+                        static_cast<int>(std::lround(EffectiveIterations())), dps_statistics.ConfidenceInterval(),
                         static_cast<int>(player.total_fight_duration), player.custom_stat.c_str(), simulation_duration);
 }
\ No newline at end of file
@@ -1,13 +1,17 @@
 #include "../include/spell.h"
 
+#include <cmath>
+
 #include "../include/common.h"
 #include "../include/entity.h"
 #include "../include/player.h"
 
-Spell::Spell(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+Spell::Spell(Entity& entity, Aura* aura, DamageOverTime* dot)
     : entity(entity), aura_effect(aura), dot_effect(dot) {}
 
 void Spell::Setup() {
+  name = SpellIdToName(id);
+
   if (min_dmg > 0 && max_dmg > 0) {
     base_damage = (min_dmg + max_dmg) / 2.0;
   }
@@ -16,20 +20,28 @@ void Spell::Setup() {
     mana_gain = (min_mana_gain + max_mana_gain) / 2.0;
   }
 
-  if (entity.recording_combat_log_breakdown && entity.combat_log_breakdown.count(name) == 0) {
-    entity.combat_log_breakdown.insert({name, std::make_unique<CombatLogBreakdown>(name)});
+  if (entity.recording_combat_log_breakdown) {
+    breakdown_index = entity.AddCombatLogBreakdownRow(name);
   }
 
   if (entity.entity_type == EntityType::kPlayer && spell_type == SpellType::kDestruction) {
     mana_cost *= 1 - 0.01 * entity.player->talents.cataclysm;
   }
 
+  proc_threshold = Rng::ChanceThreshold(proc_chance);
+  entity.player->AddRngStream(hit_rng, entity.entity_type, id, RollType::kHit);
+  entity.player->AddRngStream(crit_rng, entity.entity_type, id, RollType::kCrit);
+  entity.player->AddRngStream(amount_rng, entity.entity_type, id, RollType::kAmount);
+  entity.player->AddRngStream(proc_rng, entity.entity_type, id, RollType::kProc);
+
   entity.spell_list.push_back(this);
+  cooldown_timer = entity.spell_timers.Add();
 }
 
 void Spell::Reset() {
-  casting = false;
-  cooldown_remaining = 0;
+  entity.active_spells.Remove(this);
+  ready_at = 0;
+  entity.spell_timers.Cancel(cooldown_timer);
   amount_of_casts_this_fight = 0;
 }
 
@@ -38,7 +50,7 @@ bool Spell::Ready() { return CanCast() && HasEnoughMana(); }
 bool Spell::HasEnoughMana() { return GetManaCost() <= entity.stats.mana; }
 
 bool Spell::CanCast() {
-  return cooldown_remaining <= 0 &&
+  return GetCooldownRemaining() <= 0 &&
          (is_non_warlock_ability ||
           ((!on_gcd || entity.gcd_remaining <= 0) && (is_proc || entity.cast_time_remaining <= 0))) &&
          (!limited_amount_of_casts || amount_of_casts_this_fight < amount_of_casts_per_fight);
@@ -48,120 +60,148 @@ double Spell::GetManaCost() { return mana_cost * entity.stats.mana_cost_modifier
 
 double Spell::GetCastTime() { return cast_time / entity.GetHastePercent(); }
 
-void Spell::Tick(double time) {
-  if (cooldown_remaining > 0 && cooldown_remaining - time <= 0) {
-    if (name == SpellName::kPowerInfusion) {
-      entity.player->power_infusions_ready++;
-    }
+template <typename CombatLogPolicy>
+void Spell::OffCooldown(CombatLogPolicy) {
+  if (id == SpellId::kPowerInfusion) {
+    entity.player->power_infusions_ready++;
+  }
 
-    if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(entity.name + "'s " + name + " off cooldown");
-    }
+  if constexpr (CombatLogPolicy::kWriting) {
+    entity.CombatLog(entity.name + "'s " + name + " off cooldown");
   }
+}
+
+template void Spell::OffCooldown(NotWritingCombatLog);
+template void Spell::OffCooldown(WritingCombatLog);
 
-  cooldown_remaining -= time;
+void Spell::StartCooldown(double cooldown_duration) {
+  ready_at = entity.simulation->current_fight_time + SecondsToFightTime(cooldown_duration);
+  entity.active_spells.Add(this);
 
-  if (casting && entity.cast_time_remaining <= 0) {
-    Cast();
+  if (cooldown_duration > 0) {
+    entity.spell_timers.Schedule(cooldown_timer, ready_at);
+  } else {
+    entity.spell_timers.Cancel(cooldown_timer);
   }
 }
 
+double Spell::GetCooldownRemaining() { return FightTimeToSeconds(ready_at - entity.simulation->current_fight_time); }
+
 double Spell::GetCooldown() { return cooldown; }
 
-void Spell::Cast() {
+void Spell::Cast(NotWritingCombatLog combat_log) { Cast<>(combat_log); }
+
+void Spell::Cast(WritingCombatLog combat_log) { Cast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void Spell::Cast(CombatLogPolicy combat_log) {
   const double kCurrentMana = entity.stats.mana;
   const double kManaCost = GetManaCost();
-  cooldown_remaining = GetCooldown();
-  casting = false;
+  StartCooldown(GetCooldown());
+  if (entity.casting_spell == this) {
+    entity.casting_spell = NULL;
+  }
   amount_of_casts_this_fight++;
 
-  for (auto& spell_name : shared_cooldown_spells) {
+  for (const auto kSpellId : shared_cooldown_spells) {
     for (auto& player_spell : entity.spell_list) {
-      if (player_spell->name == spell_name) {
-        player_spell->cooldown_remaining = cooldown;
+      if (player_spell->id == kSpellId) {
+        player_spell->StartCooldown(cooldown);
       }
     }
   }
 
-  if (name == SpellName::kPowerInfusion) {
+  if (id == SpellId::kPowerInfusion) {
     entity.player->power_infusions_ready--;
   }
 
   if (aura_effect == NULL && entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->casts++;
+    entity.combat_log_breakdown[breakdown_index].casts++;
   }
 
   if (mana_cost > 0 && !entity.infinite_mana) {
     entity.stats.mana -= kManaCost;
-    entity.five_second_rule_timer_remaining = 5;
+    entity.five_second_rule_timer_remaining = 5 * kFightTimePerSecond;
   }
 
-  if (cast_time > 0 && entity.ShouldWriteToCombatLog()) {
-    auto msg = entity.name + " finished casting " + name;
-    msg += " - Mana: " + DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana);
-    msg += " - Mana Cost: " + DoubleToString(round(kManaCost));
+  if constexpr (CombatLogPolicy::kWriting) {
+    if (cast_time > 0) {
+      auto msg = entity.name + " finished casting " + name;
+      msg += " - Mana: " + DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana);
+      msg += " - Mana Cost: " + DoubleToString(round(kManaCost));
 
-    if (entity.entity_type == EntityType::kPlayer) {
-      msg += " - Mana Cost Modifier: " + DoubleToString(round(entity.stats.mana_cost_modifier * 100)) + "%";
-    }
+      if (entity.entity_type == EntityType::kPlayer) {
+        msg += " - Mana Cost Modifier: " + DoubleToString(round(entity.stats.mana_cost_modifier * 100)) + "%";
+      }
 
-    entity.CombatLog(msg);
+      entity.CombatLog(msg);
+    }
   }
 
   if (gain_mana_on_cast) {
-    ManaGainOnCast();
+    ManaGainOnCast(combat_log);
   }
 
-  SpellCastResult spell_cast_result = (attack_type == AttackType::kPhysical ? PhysicalSpellCast() : MagicSpellCast());
+  SpellCastResult spell_cast_result =
+      (attack_type == AttackType::kPhysical ? PhysicalSpellCast(combat_log) : MagicSpellCast(combat_log));
 
   if (spell_cast_result.is_miss || spell_cast_result.is_dodge) {
     return;
   }
 
-  OnSpellHit(spell_cast_result);
+  OnSpellHit(combat_log, spell_cast_result);
 }
 
-void Spell::Damage(bool is_crit, bool is_glancing) {
-  const std::vector<double> kConstantDamage = GetConstantDamage();
-  const double kBaseDamage = kConstantDamage[0];
-  auto total_damage = kConstantDamage[1];
-  const double kDamageModifier = kConstantDamage[2];
-  const double kPartialResistMultiplier = kConstantDamage[3];
-  const double kSpellPower = kConstantDamage[4];
+void Spell::Damage(NotWritingCombatLog combat_log, bool is_crit, bool is_glancing) {
+  Damage<>(combat_log, is_crit, is_glancing);
+}
+
+void Spell::Damage(WritingCombatLog combat_log, bool is_crit, bool is_glancing) {
+  Damage<>(combat_log, is_crit, is_glancing);
+}
+
+template <typename CombatLogPolicy>
+void Spell::Damage(CombatLogPolicy combat_log, bool is_crit, bool is_glancing) {
+  const ConstantDamage kConstantDamage = GetConstantDamage();
+  const double kBaseDamage = kConstantDamage.base_damage;
+  auto total_damage = kConstantDamage.damage;
+  const double kDamageModifier = kConstantDamage.modifier;
+  const double kPartialResistMultiplier = kConstantDamage.partial_resist_multiplier;
+  const double kSpellPower = kConstantDamage.spell_power;
   auto crit_multiplier = entity.kCritDamageMultiplier;
 
   if (is_crit) {
     crit_multiplier = GetCritMultiplier(crit_multiplier);
     total_damage *= crit_multiplier;
-    OnCritProcs();
+    OnCritProcs(combat_log);
   } else if (spell_school == SpellSchool::kShadow && dot_effect == NULL &&
              entity.player->auras.improved_shadow_bolt != NULL && entity.player->auras.improved_shadow_bolt->active &&
              !entity.player->settings.using_custom_isb_uptime) {
-    entity.player->auras.improved_shadow_bolt->DecrementStacks();
+    entity.player->auras.improved_shadow_bolt->DecrementStacks(combat_log);
   }
 
   if (is_glancing) {
     total_damage *= entity.pet->glancing_blow_multiplier;
   }
 
-  OnDamageProcs();
+  OnDamageProcs(combat_log);
   entity.player->iteration_damage += total_damage;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_damage += total_damage;
+    entity.combat_log_breakdown[breakdown_index].iteration_damage += total_damage;
   }
 
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     CombatLogDamage(is_crit, is_glancing, total_damage, kBaseDamage, kSpellPower, crit_multiplier, kDamageModifier,
                     kPartialResistMultiplier);
   }
 
   // T5 4pc
   if (entity.entity_type == EntityType::kPlayer && entity.player->sets.t5 >= 4) {
-    if (name == SpellName::kShadowBolt && entity.player->auras.corruption != NULL &&
+    if (id == SpellId::kShadowBolt && entity.player->auras.corruption != NULL &&
         entity.player->auras.corruption->active) {
       entity.player->auras.corruption->t5_bonus_modifier *= 1.1;
-    } else if (name == SpellName::kIncinerate && entity.player->auras.immolate != NULL &&
+    } else if (id == SpellId::kIncinerate && entity.player->auras.immolate != NULL &&
                entity.player->auras.immolate->active) {
       entity.player->auras.immolate->t5_bonus_modifier *= 1.1;
     }
@@ -170,7 +210,7 @@ void Spell::Damage(bool is_crit, bool is_glancing) {
 
 // Returns the non-RNG Damage of the spell (basically just the base Damage +
 // spell power + Damage modifiers, no crit/miss etc.)
-std::vector<double> Spell::GetConstantDamage() {
+ConstantDamage Spell::GetConstantDamage() {
   auto total_damage = GetBaseDamage();
   const double kBaseDamage = total_damage;
   const double kSpellPower = entity.GetSpellPower(true, spell_school);
@@ -178,11 +218,11 @@ std::vector<double> Spell::GetConstantDamage() {
   const double kPartialResistMultiplier = entity.GetPartialResistMultiplier(spell_school);
 
   // If casting Incinerate and Immolate is up, add the bonus Damage
-  if (name == SpellName::kIncinerate && entity.player->auras.immolate != NULL &&
+  if (id == SpellId::kIncinerate && entity.player->auras.immolate != NULL &&
       entity.player->auras.immolate->active) {
     if (entity.player->settings.randomize_values && bonus_damage_from_immolate_min > 0 &&
         bonus_damage_from_immolate_max > 0) {
-      total_damage += entity.player->rng.range(bonus_damage_from_immolate_min, bonus_damage_from_immolate_max);
+      total_damage += amount_rng.range(bonus_damage_from_immolate_min, bonus_damage_from_immolate_max);
     } else {
       total_damage += bonus_damage_from_immolate;
     }
@@ -202,7 +242,7 @@ std::vector<double> Spell::GetConstantDamage() {
     total_damage *= entity.pet->enemy_damage_reduction_from_armor;
   }
 
-  return std::vector<double>{kBaseDamage, total_damage, kDamageModifier, kPartialResistMultiplier, kSpellPower};
+  return ConstantDamage(kBaseDamage, total_damage, kSpellPower, kDamageModifier, kPartialResistMultiplier);
 }
 
 double Spell::GetCritMultiplier(double player_crit_multiplier) {
@@ -228,15 +268,14 @@ double Spell::GetCritMultiplier(double player_crit_multiplier) {
 
 double Spell::GetBaseDamage() {
   if (entity.player->settings.randomize_values && min_dmg > 0 && max_dmg > 0) {
-    return entity.player->rng.range(min_dmg, max_dmg);
+    return amount_rng.range(min_dmg, max_dmg);
   } else {
     return base_damage;
   }
 }
 
 double Spell::PredictDamage() {
-  const std::vector<double> kConstantDamage = GetConstantDamage();
-  const double kNormalDamage = kConstantDamage[1];
+  const double kNormalDamage = GetConstantDamage().damage;
   auto crit_damage = 0.0;
   auto crit_chance = 0.0;
   auto chance_to_not_crit = 0.0;
@@ -267,208 +306,250 @@ double Spell::PredictDamage() {
   return (estimated_damage * hit_chance) / std::max(entity.GetGcdValue(), GetCastTime());
 }
 
-void Spell::OnCritProcs() {
+template <typename CombatLogPolicy>
+void Spell::OnCritProcs(CombatLogPolicy combat_log) {
   for (auto& proc : entity.on_crit_procs) {
-    if (proc->Ready() && proc->ShouldProc(this) && entity.player->RollRng(proc->proc_chance)) {
-      proc->StartCast();
+    if (proc->Ready() && proc->ShouldProc(this) && proc->proc_rng.Roll(proc->proc_threshold)) {
+      proc->StartCast(combat_log);
     }
   }
 }
 
-void Spell::OnResistProcs() {
+template <typename CombatLogPolicy>
+void Spell::OnResistProcs(CombatLogPolicy combat_log) {
   for (auto& proc : entity.on_resist_procs) {
-    if (proc->Ready() && proc->ShouldProc(this) && entity.player->RollRng(proc->proc_chance)) {
-      proc->StartCast();
+    if (proc->Ready() && proc->ShouldProc(this) && proc->proc_rng.Roll(proc->proc_threshold)) {
+      proc->StartCast(combat_log);
     }
   }
 }
 
-void Spell::OnDamageProcs() {
+template <typename CombatLogPolicy>
+void Spell::OnDamageProcs(CombatLogPolicy combat_log) {
   for (auto& proc : entity.on_damage_procs) {
-    if (proc->Ready() && proc->ShouldProc(this) && entity.player->RollRng(proc->proc_chance)) {
-      proc->StartCast();
+    if (proc->Ready() && proc->ShouldProc(this) && proc->proc_rng.Roll(proc->proc_threshold)) {
+      proc->StartCast(combat_log);
     }
   }
 }
 
-void Spell::OnHitProcs() {
+template <typename CombatLogPolicy>
+void Spell::OnHitProcs(CombatLogPolicy combat_log) {
   for (auto& proc : entity.on_hit_procs) {
-    if (proc->Ready() && proc->ShouldProc(this) && entity.player->RollRng(proc->proc_chance)) {
-      proc->StartCast();
+    if (proc->Ready() && proc->ShouldProc(this) && proc->proc_rng.Roll(proc->proc_threshold)) {
+      proc->StartCast(combat_log);
     }
   }
 }
 
-void Spell::StartCast(double predicted_damage) {
+void Spell::StartCast(NotWritingCombatLog combat_log, double predicted_damage) {
+  StartCast<>(combat_log, predicted_damage);
+}
+
+void Spell::StartCast(WritingCombatLog combat_log, double predicted_damage) {
+  StartCast<>(combat_log, predicted_damage);
+}
+
+template <typename CombatLogPolicy>
+void Spell::StartCast(CombatLogPolicy combat_log, double predicted_damage) {
   if (on_gcd && !is_non_warlock_ability) {
     // Error: Casting a spell while GCD is active
     if (entity.gcd_remaining > 0) {
       entity.player->ThrowError(entity.name + " attempting to cast " + name + " while " + entity.name +
-                                "'s GCD is at " + std::to_string(entity.gcd_remaining) + " seconds remaining");
+                                "'s GCD is at " + std::to_string(FightTimeToSeconds(entity.gcd_remaining)) +
+                                " seconds remaining");
     }
 
-    entity.gcd_remaining = entity.GetGcdValue();
+    entity.gcd_remaining = SecondsToFightTime(entity.GetGcdValue());
   }
 
   // Error: Starting to Cast a spell while casting another spell
   if (entity.cast_time_remaining > 0 && !is_non_warlock_ability && !is_proc) {
     entity.player->ThrowError(entity.name + " attempting to cast " + name + " while " + entity.name +
-                              "'s cast time remaining is at " + std::to_string(entity.cast_time_remaining) + " sec");
+                              "'s cast time remaining is at " +
+                              std::to_string(FightTimeToSeconds(entity.cast_time_remaining)) + " sec");
   }
 
   // Error: Casting a spell while it's on cooldown
-  if (cooldown > 0 && cooldown_remaining > 0) {
+  if (cooldown > 0 && GetCooldownRemaining() > 0) {
     entity.player->ThrowError(entity.name + " attempting to cast " + name + " while it's still on cooldown (" +
-                              std::to_string(cooldown_remaining) + " seconds remaining)");
+                              std::to_string(GetCooldownRemaining()) + " seconds remaining)");
   }
 
-  std::string combat_log_message = "";
   if (cast_time > 0) {
-    casting = true;
-    entity.cast_time_remaining = GetCastTime();
+    entity.casting_spell = this;
+    entity.cast_time_remaining = SecondsToFightTime(GetCastTime());
+  }
+
+  if constexpr (CombatLogPolicy::kWriting) {
+    // Built before the cast since that can change the haste in it, but written after the entries of the cast
+    const std::string kCombatLogMessage = StartCastCombatLogMessage(predicted_damage);
+
+    if (cast_time <= 0) {
+      Cast(combat_log);
+    }
 
-    if (!is_proc && entity.ShouldWriteToCombatLog()) {
-      combat_log_message.append(entity.name + " started casting " + name +
-                                " - Cast time: " + DoubleToString(entity.cast_time_remaining, 4) + " (" +
+    if (kCombatLogMessage.length() > 0) {
+      entity.CombatLog(kCombatLogMessage);
+    }
+  } else if (cast_time <= 0) {
+    Cast(combat_log);
+  }
+}
+
+std::string Spell::StartCastCombatLogMessage(double predicted_damage) {
+  std::string combat_log_message = "";
+
+  if (cast_time > 0) {
+    if (!is_proc) {
+      combat_log_message.append(entity.name + " started casting " + name + " - Cast time: " +
+                                DoubleToString(FightTimeToSeconds(entity.cast_time_remaining), 4) + " (" +
                                 DoubleToString((entity.GetHastePercent() - 1) * 100, 4) +
                                 "% haste at a base Cast speed of " + DoubleToString(cast_time, 2) + ")");
     }
-  } else {
-    if (!is_proc && entity.ShouldWriteToCombatLog()) {
-      combat_log_message.append(entity.name + " casts " + name);
+  } else if (!is_proc) {
+    combat_log_message.append(entity.name + " casts " + name);
 
-      if (name == SpellName::kMelee) {
-        combat_log_message.append(" - Attack Speed: " + DoubleToString(GetCooldown(), 2) + " (" +
-                                  DoubleToString(round(entity.GetHastePercent() * 10000) / 100.0 - 100, 4) +
-                                  "% haste at a base attack speed of " + DoubleToString(cooldown, 2) + ")");
-      }
+    if (id == SpellId::kMelee) {
+      combat_log_message.append(" - Attack Speed: " + DoubleToString(GetCooldown(), 2) + " (" +
+                                DoubleToString(round(entity.GetHastePercent() * 10000) / 100.0 - 100, 4) +
+                                "% haste at a base attack speed of " + DoubleToString(cooldown, 2) + ")");
     }
-
-    Cast();
   }
 
-  if (on_gcd && !is_non_warlock_ability && entity.ShouldWriteToCombatLog()) {
-    combat_log_message.append(" - Global cooldown: " + DoubleToString(entity.gcd_remaining, 4));
+  if (on_gcd && !is_non_warlock_ability) {
+    combat_log_message.append(" - Global cooldown: " + DoubleToString(FightTimeToSeconds(entity.gcd_remaining), 4));
   }
 
-  if (predicted_damage > 0 && entity.ShouldWriteToCombatLog()) {
+  if (predicted_damage > 0) {
     combat_log_message.append(" - Estimated Damage / Cast time: " + DoubleToString(round(predicted_damage)));
   }
 
-  if (combat_log_message.length() > 0) {
-    entity.CombatLog(combat_log_message);
-  }
+  return combat_log_message;
+}
+
+bool Spell::RollHit() {
+  return hit_rng.Roll(hit_threshold.Get(
+      entity.stats_version, [this] { return Rng::ChanceThreshold(entity.GetSpellHitChance(spell_type)); }));
+}
+
+bool Spell::RollCrit() {
+  return crit_rng.Roll(crit_threshold.Get(entity.stats_version, [this] {
+    return Rng::ChanceThreshold(entity.GetSpellCritChance(spell_type) + bonus_crit_chance);
+  }));
 }
 
-SpellCastResult Spell::MagicSpellCast() {
+template <typename CombatLogPolicy>
+SpellCastResult Spell::MagicSpellCast(CombatLogPolicy combat_log) {
   auto is_crit = false;
-  auto is_resist = can_miss && (attack_type == AttackType::kMagical && !entity.IsSpellHit(spell_type));
+  auto is_resist = can_miss && (attack_type == AttackType::kMagical && !RollHit());
 
   if (can_crit) {
-    is_crit = entity.IsSpellCrit(spell_type, bonus_crit_chance);
+    is_crit = RollCrit();
 
     if (is_crit && entity.recording_combat_log_breakdown) {
       // Increment the crit counter whether the spell hits or not so that the
       // crit % on the Damage breakdown is correct. Otherwise the crit % will be
       // lower due to lost crits when the spell misses.
-      entity.combat_log_breakdown.at(name)->crits++;
+      entity.combat_log_breakdown[breakdown_index].crits++;
     }
   }
 
   if (is_resist) {
-    if (entity.ShouldWriteToCombatLog()) {
+    if constexpr (CombatLogPolicy::kWriting) {
       entity.CombatLog(name + " *resist*");
     }
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->misses++;
+      entity.combat_log_breakdown[breakdown_index].misses++;
     }
 
-    OnResistProcs();
+    OnResistProcs(combat_log);
   }
 
   return SpellCastResult(is_resist, is_crit);
 }
 
-SpellCastResult Spell::PhysicalSpellCast() {
+template <typename CombatLogPolicy>
+SpellCastResult Spell::PhysicalSpellCast(CombatLogPolicy) {
   auto is_crit = false;
   auto is_glancing = false;
   auto is_miss = false;
   auto is_dodge = false;
-  auto crit_chance = can_crit ? static_cast<int>((entity.GetMeleeCritChance() * entity.kFloatNumberMultiplier)) : 0;
-  auto dodge_chance =
-      crit_chance + static_cast<int>(StatConstant::kBaseEnemyDodgeChance * entity.kFloatNumberMultiplier);
-  auto miss_chance =
-      dodge_chance + static_cast<int>((100 - entity.stats.melee_hit_chance) * entity.kFloatNumberMultiplier);
-  auto glancing_chance = miss_chance;
+  const double kCritChance = can_crit ? entity.GetMeleeCritChance() : 0;
+  const double kDodgeChance = kCritChance + StatConstant::kBaseEnemyDodgeChance;
+  const double kMissChance = kDodgeChance + 100 - entity.stats.melee_hit_chance;
+  auto glancing_chance = kMissChance;
 
   // Only check for a glancing if it's a normal melee attack
-  if (name == SpellName::kMelee) {
-    glancing_chance += static_cast<int>(entity.pet->glancing_blow_chance * entity.kFloatNumberMultiplier);
+  if (id == SpellId::kMelee) {
+    glancing_chance += entity.pet->glancing_blow_chance;
   }
 
-  // Check whether the roll is a crit, dodge, miss, glancing, or just a normal hit.
-  auto attack_roll = entity.player->GetRand();
+  // Check whether the roll is a crit, dodge, miss, glancing, or just a normal hit. The chances add up, so each
+  // outcome's threshold includes the chances of the ones before it.
+  const uint32_t kAttackRoll = hit_rng.NextUint32();
 
   // Crit
-  if (can_crit && attack_roll <= crit_chance) {
+  if (can_crit && kAttackRoll < Rng::ChanceThreshold(kCritChance)) {
     is_crit = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->crits++;
+      entity.combat_log_breakdown[breakdown_index].crits++;
     }
   }
   // Dodge
-  else if (attack_roll <= dodge_chance) {
+  else if (kAttackRoll < Rng::ChanceThreshold(kDodgeChance)) {
     is_dodge = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->dodge++;
+      entity.combat_log_breakdown[breakdown_index].dodge++;
     }
 
-    if (entity.ShouldWriteToCombatLog()) {
+    if constexpr (CombatLogPolicy::kWriting) {
       entity.CombatLog(entity.name + " " + name + " *dodge*");
     }
   }
   // Miss
-  else if (attack_roll <= miss_chance) {
+  else if (kAttackRoll < Rng::ChanceThreshold(kMissChance)) {
     is_miss = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->misses++;
+      entity.combat_log_breakdown[breakdown_index].misses++;
     }
 
-    if (entity.ShouldWriteToCombatLog()) {
+    if constexpr (CombatLogPolicy::kWriting) {
       entity.CombatLog(entity.name + " " + name + " *miss*");
     }
   }
   // Glancing Blow
-  else if (attack_roll <= glancing_chance && name == SpellName::kMelee) {
+  else if (kAttackRoll < Rng::ChanceThreshold(glancing_chance) && id == SpellId::kMelee) {
     is_glancing = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->glancing_blows++;
+      entity.combat_log_breakdown[breakdown_index].glancing_blows++;
     }
   }
 
   return SpellCastResult(is_miss, is_crit, is_glancing, is_dodge);
 }
 
-void Spell::OnSpellHit(SpellCastResult& spell_cast_result) {
+template <typename CombatLogPolicy>
+void Spell::OnSpellHit(CombatLogPolicy combat_log, SpellCastResult& spell_cast_result) {
   if (aura_effect != NULL) {
-    aura_effect->Apply();
+    aura_effect->Apply(combat_log);
   }
 
   if (dot_effect != NULL) {
-    dot_effect->Apply();
+    dot_effect->Apply(combat_log);
   }
 
   if (does_damage) {
-    Damage(spell_cast_result.is_crit, spell_cast_result.is_glancing);
+    Damage(combat_log, spell_cast_result.is_crit, spell_cast_result.is_glancing);
   }
 
-  if (!is_item && !is_proc && !is_non_warlock_ability && name != SpellName::kAmplifyCurse) {
-    OnHitProcs();
+  if (!is_item && !is_proc && !is_non_warlock_ability && id != SpellId::kAmplifyCurse) {
+    OnHitProcs(combat_log);
   }
 }
 
@@ -515,24 +596,25 @@ void Spell::CombatLogDamage(bool is_crit, bool is_glancing, double total_damage,
   entity.CombatLog(msg);
 }
 
-void Spell::ManaGainOnCast() {
+template <typename CombatLogPolicy>
+void Spell::ManaGainOnCast(CombatLogPolicy) {
   const double kCurrentMana = entity.stats.mana;
 
   entity.stats.mana = std::min(static_cast<double>(entity.stats.max_mana), kCurrentMana + mana_gain);
   const double kManaGained = entity.stats.mana - kCurrentMana;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
+    entity.combat_log_breakdown[breakdown_index].iteration_mana_gain += kManaGained;
   }
 
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     entity.CombatLog("Player gains " + DoubleToString(kManaGained) + " mana from " + name + " (" +
                      DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana) + ")");
   }
 }
 
 ShadowBolt::ShadowBolt(Entity& entity) : Spell(entity) {
-  name = SpellName::kShadowBolt;
+  id = SpellId::kShadowBolt;
   cast_time = CalculateCastTime();
   mana_cost = 420;
   coefficient = (3 / 3.5) + (0.04 * entity.player->talents.shadow_and_flame);
@@ -547,25 +629,30 @@ ShadowBolt::ShadowBolt(Entity& entity) : Spell(entity) {
   Setup();
 }
 
-void ShadowBolt::StartCast(double) {
+void ShadowBolt::StartCast(NotWritingCombatLog combat_log, double) { StartCast<>(combat_log); }
+
+void ShadowBolt::StartCast(WritingCombatLog combat_log, double) { StartCast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void ShadowBolt::StartCast(CombatLogPolicy combat_log) {
   const bool kHasShadowTrance = entity.player->auras.shadow_trance != NULL;
 
   if (kHasShadowTrance && entity.player->auras.shadow_trance->active) {
     cast_time = 0;
   }
 
-  Spell::StartCast();
+  Spell::StartCast(combat_log);
 
   if (kHasShadowTrance && entity.player->auras.shadow_trance->active) {
     cast_time = CalculateCastTime();
-    entity.player->auras.shadow_trance->Fade();
+    entity.player->auras.shadow_trance->Fade(combat_log);
   }
 }
 
 double ShadowBolt::CalculateCastTime() { return 3 - (0.1 * entity.player->talents.bane); }
 
 Incinerate::Incinerate(Entity& entity) : Spell(entity) {
-  name = SpellName::kIncinerate;
+  id = SpellId::kIncinerate;
   cast_time = 2.5 * (1 - 0.02 * entity.player->talents.emberstorm);
   mana_cost = 355;
   coefficient = (2.5 / 3.5) + (0.04 * entity.player->talents.shadow_and_flame);
@@ -584,7 +671,7 @@ Incinerate::Incinerate(Entity& entity) : Spell(entity) {
 }
 
 SearingPain::SearingPain(Entity& entity) : Spell(entity) {
-  name = SpellName::kSearingPain;
+  id = SpellId::kSearingPain;
   cast_time = 1.5;
   mana_cost = 205;
   coefficient = 1.5 / 3.5;
@@ -601,7 +688,7 @@ SearingPain::SearingPain(Entity& entity) : Spell(entity) {
 };
 
 SoulFire::SoulFire(Entity& entity) : Spell(entity) {
-  name = SpellName::kSoulFire;
+  id = SpellId::kSoulFire;
   cast_time = 6 - (0.4 * entity.player->talents.bane);
   mana_cost = 250;
   coefficient = 1.15;
@@ -617,7 +704,7 @@ SoulFire::SoulFire(Entity& entity) : Spell(entity) {
 };
 
 Shadowburn::Shadowburn(Entity& entity) : Spell(entity) {
-  name = SpellName::kShadowburn;
+  id = SpellId::kShadowburn;
   cooldown = 15;
   mana_cost = 515;
   coefficient = 0.22;
@@ -634,7 +721,7 @@ Shadowburn::Shadowburn(Entity& entity) : Spell(entity) {
 };
 
 DeathCoil::DeathCoil(Entity& entity) : Spell(entity) {
-  name = SpellName::kDeathCoil;
+  id = SpellId::kDeathCoil;
   cooldown = 120;
   mana_cost = 600;
   coefficient = 0.4286;
@@ -649,7 +736,7 @@ DeathCoil::DeathCoil(Entity& entity) : Spell(entity) {
 };
 
 Shadowfury::Shadowfury(Entity& entity) : Spell(entity) {
-  name = SpellName::kShadowfury;
+  id = SpellId::kShadowfury;
   cast_time = 0.5;
   mana_cost = 710;
   min_dmg = 612;
@@ -667,7 +754,7 @@ Shadowfury::Shadowfury(Entity& entity) : Spell(entity) {
 }
 
 SeedOfCorruption::SeedOfCorruption(Entity& entity) : Spell(entity) {
-  name = SpellName::kSeedOfCorruption;
+  id = SpellId::kSeedOfCorruption;
   min_dmg = 1110;
   max_dmg = 1290;
   mana_cost = 882;
@@ -682,9 +769,14 @@ SeedOfCorruption::SeedOfCorruption(Entity& entity) : Spell(entity) {
   Setup();
 };
 
-void SeedOfCorruption::Damage(bool, bool) {
+void SeedOfCorruption::Damage(NotWritingCombatLog combat_log, bool, bool) { Damage<>(combat_log); }
+
+void SeedOfCorruption::Damage(WritingCombatLog combat_log, bool, bool) { Damage<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void SeedOfCorruption::Damage(CombatLogPolicy combat_log) {
   const double kBaseDamage = entity.player->settings.randomize_values && min_dmg > 0 && max_dmg > 0
-                                 ? entity.player->rng.range(min_dmg, max_dmg)
+                                 ? amount_rng.range(min_dmg, max_dmg)
                                  : base_damage;
   const int kEnemyAmount = entity.player->settings.enemy_amount - 1;  // Minus one because the enemy that Seed is
                                                                       // being Cast on doesn't get hit
@@ -720,15 +812,15 @@ void SeedOfCorruption::Damage(bool, bool) {
 
   for (int i = 0; i < kEnemyAmount; i++) {
     // Check for a resist
-    if (!entity.IsSpellHit(spell_type)) {
+    if (!RollHit()) {
       resist_amount++;
-      OnResistProcs();
+      OnResistProcs(combat_log);
     } else {
-      OnDamageProcs();
+      OnDamageProcs(combat_log);
       // Check for a crit
-      if (entity.IsSpellCrit(spell_type)) {
+      if (RollCrit()) {
         crit_amount++;
-        OnCritProcs();
+        OnCritProcs(combat_log);
       }
     }
   }
@@ -776,7 +868,7 @@ void SeedOfCorruption::Damage(bool, bool) {
 
   entity.player->iteration_damage += total_seed_damage;
 
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     auto msg = name + " " + DoubleToString(round(total_seed_damage)) + " (" + std::to_string(kEnemyAmount) +
                " Enemies (" + std::to_string(resist_amount) + " Resists & " + std::to_string(crit_amount) +
                " Crits) - " + DoubleToString(kBaseDamage, 1) + " Base Damage - " + DoubleToString(coefficient, 3) +
@@ -789,18 +881,18 @@ void SeedOfCorruption::Damage(bool, bool) {
     entity.CombatLog(msg);
   }
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_damage += total_seed_damage;
-    entity.combat_log_breakdown.at(name)->crits += crit_amount;
-    entity.combat_log_breakdown.at(name)->misses += resist_amount;
+    entity.combat_log_breakdown[breakdown_index].iteration_damage += total_seed_damage;
+    entity.combat_log_breakdown[breakdown_index].crits += crit_amount;
+    entity.combat_log_breakdown[breakdown_index].misses += resist_amount;
     // the Cast() function already adds 1 to the amount of casts so we only need
     // to add enemiesHit - 1 to the Cast amount
-    entity.combat_log_breakdown.at(name)->casts += (kEnemiesHit - 1);
+    entity.combat_log_breakdown[breakdown_index].casts += (kEnemiesHit - 1);
   }
 }
 
-Corruption::Corruption(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+Corruption::Corruption(Entity& entity, Aura* aura, DamageOverTime* dot)
     : Spell(entity, aura, dot) {
-  name = SpellName::kCorruption;
+  id = SpellId::kCorruption;
   mana_cost = 370;
   cast_time = 2 - (0.4 * entity.player->talents.improved_corruption);
   spell_school = SpellSchool::kShadow;
@@ -810,9 +902,9 @@ Corruption::Corruption(Entity& entity, std::shared_ptr<Aura> aura, std::shared_p
   Setup();
 }
 
-UnstableAffliction::UnstableAffliction(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+UnstableAffliction::UnstableAffliction(Entity& entity, Aura* aura, DamageOverTime* dot)
     : Spell(entity, aura, dot) {
-  name = SpellName::kUnstableAffliction;
+  id = SpellId::kUnstableAffliction;
   mana_cost = 400;
   cast_time = 1.5;
   spell_school = SpellSchool::kShadow;
@@ -822,9 +914,9 @@ UnstableAffliction::UnstableAffliction(Entity& entity, std::shared_ptr<Aura> aur
   Setup();
 }
 
-SiphonLife::SiphonLife(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+SiphonLife::SiphonLife(Entity& entity, Aura* aura, DamageOverTime* dot)
     : Spell(entity, aura, dot) {
-  name = SpellName::kSiphonLife;
+  id = SpellId::kSiphonLife;
   mana_cost = 410;
   spell_school = SpellSchool::kShadow;
   spell_type = SpellType::kAffliction;
@@ -833,9 +925,9 @@ SiphonLife::SiphonLife(Entity& entity, std::shared_ptr<Aura> aura, std::shared_p
   Setup();
 }
 
-Immolate::Immolate(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+Immolate::Immolate(Entity& entity, Aura* aura, DamageOverTime* dot)
     : Spell(entity, aura, dot) {
-  name = SpellName::kImmolate;
+  id = SpellId::kImmolate;
   mana_cost = 445;
   cast_time = 2 - (0.1 * entity.player->talents.bane);
   does_damage = true;
@@ -849,9 +941,9 @@ Immolate::Immolate(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<D
   Setup();
 }
 
-CurseOfAgony::CurseOfAgony(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+CurseOfAgony::CurseOfAgony(Entity& entity, Aura* aura, DamageOverTime* dot)
     : Spell(entity, aura, dot) {
-  name = SpellName::kCurseOfAgony;
+  id = SpellId::kCurseOfAgony;
   mana_cost = 265;
   spell_school = SpellSchool::kShadow;
   spell_type = SpellType::kAffliction;
@@ -860,8 +952,8 @@ CurseOfAgony::CurseOfAgony(Entity& entity, std::shared_ptr<Aura> aura, std::shar
   Setup();
 }
 
-CurseOfTheElements::CurseOfTheElements(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kCurseOfTheElements;
+CurseOfTheElements::CurseOfTheElements(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kCurseOfTheElements;
   mana_cost = 260;
   spell_type = SpellType::kAffliction;
   spell_school = SpellSchool::kShadow;
@@ -870,8 +962,8 @@ CurseOfTheElements::CurseOfTheElements(Entity& entity, std::shared_ptr<Aura> aur
   Setup();
 }
 
-CurseOfRecklessness::CurseOfRecklessness(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kCurseOfRecklessness;
+CurseOfRecklessness::CurseOfRecklessness(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kCurseOfRecklessness;
   mana_cost = 160;
   spell_type = SpellType::kAffliction;
   spell_school = SpellSchool::kShadow;
@@ -880,9 +972,9 @@ CurseOfRecklessness::CurseOfRecklessness(Entity& entity, std::shared_ptr<Aura> a
   Setup();
 }
 
-CurseOfDoom::CurseOfDoom(Entity& entity, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+CurseOfDoom::CurseOfDoom(Entity& entity, Aura* aura, DamageOverTime* dot)
     : Spell(entity, aura, dot) {
-  name = SpellName::kCurseOfDoom;
+  id = SpellId::kCurseOfDoom;
   mana_cost = 380;
   cooldown = 60;
   spell_school = SpellSchool::kShadow;
@@ -893,7 +985,7 @@ CurseOfDoom::CurseOfDoom(Entity& entity, std::shared_ptr<Aura> aura, std::shared
 }
 
 Conflagrate::Conflagrate(Entity& entity) : Spell(entity) {
-  name = SpellName::kConflagrate;
+  id = SpellId::kConflagrate;
   mana_cost = 305;
   cooldown = 10;
   min_dmg = 579;
@@ -913,39 +1005,44 @@ bool Conflagrate::CanCast() {
   return entity.player->auras.immolate != NULL && entity.player->auras.immolate->active && Spell::CanCast();
 }
 
-void Conflagrate::Cast() {
-  Spell::Cast();
-  entity.player->auras.immolate->Fade();
+void Conflagrate::Cast(NotWritingCombatLog combat_log) { Cast<>(combat_log); }
+
+void Conflagrate::Cast(WritingCombatLog combat_log) { Cast<>(combat_log); }
+
+template <typename CombatLogPolicy>
+void Conflagrate::Cast(CombatLogPolicy combat_log) {
+  Spell::Cast(combat_log);
+  entity.player->auras.immolate->Fade(combat_log);
 }
 
-DestructionPotion::DestructionPotion(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kDestructionPotion;
+DestructionPotion::DestructionPotion(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kDestructionPotion;
   cooldown = 120;
   is_item = true;
   on_gcd = false;
   Setup();
 }
 
-FlameCap::FlameCap(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kFlameCap;
+FlameCap::FlameCap(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kFlameCap;
   cooldown = 180;
   is_item = true;
   on_gcd = false;
-  shared_cooldown_spells.push_back(SpellName::kChippedPowerCore);
-  shared_cooldown_spells.push_back(SpellName::kCrackedPowerCore);
+  shared_cooldown_spells.push_back(SpellId::kChippedPowerCore);
+  shared_cooldown_spells.push_back(SpellId::kCrackedPowerCore);
   Setup();
 }
 
-BloodFury::BloodFury(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kBloodFury;
+BloodFury::BloodFury(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kBloodFury;
   cooldown = 120;
   on_gcd = false;
   is_item = true;  // TODO create some other property for spells like this instead of making them items
   Setup();
 }
 
-Bloodlust::Bloodlust(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kBloodlust;
+Bloodlust::Bloodlust(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kBloodlust;
   cooldown = 600;
   is_item = true;
   on_gcd = false;
@@ -953,8 +1050,8 @@ Bloodlust::Bloodlust(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity,
   Setup();
 }
 
-DrumsOfBattle::DrumsOfBattle(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kDrumsOfBattle;
+DrumsOfBattle::DrumsOfBattle(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kDrumsOfBattle;
   cooldown = 120;
   on_gcd = false;
   is_non_warlock_ability = true;
@@ -962,8 +1059,8 @@ DrumsOfBattle::DrumsOfBattle(Entity& entity, std::shared_ptr<Aura> aura) : Spell
   Setup();
 }
 
-DrumsOfWar::DrumsOfWar(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kDrumsOfWar;
+DrumsOfWar::DrumsOfWar(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kDrumsOfWar;
   cooldown = 120;
   on_gcd = false;
   is_non_warlock_ability = true;
@@ -971,8 +1068,8 @@ DrumsOfWar::DrumsOfWar(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entit
   Setup();
 }
 
-DrumsOfRestoration::DrumsOfRestoration(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kDrumsOfRestoration;
+DrumsOfRestoration::DrumsOfRestoration(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kDrumsOfRestoration;
   cooldown = 120;
   on_gcd = false;
   is_non_warlock_ability = true;
@@ -980,62 +1077,62 @@ DrumsOfRestoration::DrumsOfRestoration(Entity& entity, std::shared_ptr<Aura> aur
   Setup();
 }
 
-AmplifyCurse::AmplifyCurse(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kAmplifyCurse;
+AmplifyCurse::AmplifyCurse(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kAmplifyCurse;
   cooldown = 180;
   on_gcd = false;
   Setup();
 }
 
-PowerInfusion::PowerInfusion(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kPowerInfusion;
+PowerInfusion::PowerInfusion(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kPowerInfusion;
   cooldown = 180;
   on_gcd = false;
   is_non_warlock_ability = true;
   Setup();
 }
 
-Innervate::Innervate(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kInnervate;
+Innervate::Innervate(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kInnervate;
   cooldown = 360;
   on_gcd = false;
   is_non_warlock_ability = true;
   Setup();
 }
 
-ChippedPowerCore::ChippedPowerCore(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kChippedPowerCore;
+ChippedPowerCore::ChippedPowerCore(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kChippedPowerCore;
   cooldown = 120;
   on_gcd = false;
   is_item = true;
   limited_amount_of_casts = true;
   amount_of_casts_per_fight = entity.player->settings.chipped_power_core_amount;
   shared_cooldown_spells.insert(shared_cooldown_spells.end(),
-                                {SpellName::kDemonicRune, SpellName::kFlameCap, SpellName::kCrackedPowerCore});
+                                {SpellId::kDemonicRune, SpellId::kFlameCap, SpellId::kCrackedPowerCore});
   Setup();
 };
 
-CrackedPowerCore::CrackedPowerCore(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kCrackedPowerCore;
+CrackedPowerCore::CrackedPowerCore(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kCrackedPowerCore;
   cooldown = 120;
   on_gcd = false;
   is_item = true;
   limited_amount_of_casts = true;
   amount_of_casts_per_fight = entity.player->settings.cracked_power_core_amount;
   shared_cooldown_spells.insert(shared_cooldown_spells.end(),
-                                {SpellName::kDemonicRune, SpellName::kFlameCap, SpellName::kChippedPowerCore});
+                                {SpellId::kDemonicRune, SpellId::kFlameCap, SpellId::kChippedPowerCore});
   Setup();
 };
 
-ManaTideTotem::ManaTideTotem(Entity& entity, std::shared_ptr<Aura> aura) : Spell(entity, aura) {
-  name = SpellName::kManaTideTotem;
+ManaTideTotem::ManaTideTotem(Entity& entity, Aura* aura) : Spell(entity, aura) {
+  id = SpellId::kManaTideTotem;
   cooldown = 300;
   is_non_warlock_ability = true;
   Setup();
 }
 
 ImpFirebolt::ImpFirebolt(Entity& entity) : Spell(entity) {
-  name = SpellName::kFirebolt;
+  id = SpellId::kFirebolt;
   cast_time = 2 - (0.25 * entity.player->talents.improved_firebolt);
   mana_cost = 145;
   base_damage = 119.5 * (1 + 0.1 * entity.player->talents.improved_imp);
@@ -1049,7 +1146,7 @@ ImpFirebolt::ImpFirebolt(Entity& entity) : Spell(entity) {
 }
 
 PetMelee::PetMelee(Entity& entity) : Spell(entity) {
-  name = SpellName::kMelee;
+  id = SpellId::kMelee;
   attack_type = AttackType::kPhysical;
   cooldown = 2;
   on_gcd = false;
@@ -1064,7 +1161,7 @@ double PetMelee::GetBaseDamage() { return (entity.pet->GetAttackPower() / 14 + 5
 double PetMelee::GetCooldown() { return cooldown / entity.GetHastePercent(); }
 
 FelguardCleave::FelguardCleave(Entity& entity) : Spell(entity) {
-  name = SpellName::kCleave;
+  id = SpellId::kCleave;
   cooldown = 6;
   mana_cost = 417;
   attack_type = AttackType::kPhysical;
@@ -1077,7 +1174,7 @@ FelguardCleave::FelguardCleave(Entity& entity) : Spell(entity) {
 double FelguardCleave::GetBaseDamage() { return entity.pet->spells.melee->GetBaseDamage() + 78; }
 
 SuccubusLashOfPain::SuccubusLashOfPain(Entity& entity) : Spell(entity) {
-  name = SpellName::kLashOfPain;
+  id = SpellId::kLashOfPain;
   cooldown = 12 - 3 * entity.player->talents.improved_lash_of_pain;
   mana_cost = 190;
   base_damage = 123 * (1 + 0.1 * entity.player->talents.improved_succubus);
@@ -6,30 +6,38 @@
 Stat::Stat(Entity& entity, double& character_stat, double value)
     : entity(entity), character_stat(character_stat), value(value) {}
 
-void Stat::AddStat() { ModifyStat("add"); }
+template <typename CombatLogPolicy>
+void Stat::AddStat(CombatLogPolicy combat_log) {
+  ModifyStat(combat_log, StatAction::kAdd);
+}
 
-void Stat::RemoveStat(int stacks) { ModifyStat("remove", stacks); }
+template <typename CombatLogPolicy>
+void Stat::RemoveStat(CombatLogPolicy combat_log, int stacks) {
+  ModifyStat(combat_log, StatAction::kRemove, stacks);
+}
 
-void Stat::ModifyStat(std::string action, int stacks) {
+template <typename CombatLogPolicy>
+void Stat::ModifyStat(CombatLogPolicy, StatAction action, int stacks) {
   const double kCurrentStatValue = character_stat;
   auto new_stat_value = kCurrentStatValue;
 
   if (calculation_type == CalculationType::kAdditive) {
-    new_stat_value += (value * stacks) * (action == "remove" ? -1 : action == "add" ? 1 : 0);
+    new_stat_value += (value * stacks) * (action == StatAction::kAdd ? 1 : -1);
   } else if (calculation_type == CalculationType::kMultiplicative) {
-    if (action == "add") {
+    if (action == StatAction::kAdd) {
       new_stat_value *= (value * stacks);
-    } else if (action == "remove") {
+    } else {
       new_stat_value /= (value * stacks);
     }
   }
 
   character_stat = new_stat_value;
+  entity.InvalidateDerivedStats();
 
-  if (entity.ShouldWriteToCombatLog()) {
+  if constexpr (CombatLogPolicy::kWriting) {
     auto msg = entity.name + " " + name + " ";
 
-    if (action == "add") {
+    if (action == StatAction::kAdd) {
       if (calculation_type == CalculationType::kAdditive) {
         msg += "+";
       } else {
@@ -51,6 +59,11 @@ void Stat::ModifyStat(std::string action, int stacks) {
   }
 }
 
+template void Stat::AddStat(NotWritingCombatLog);
+template void Stat::AddStat(WritingCombatLog);
+template void Stat::RemoveStat(NotWritingCombatLog, int);
+template void Stat::RemoveStat(WritingCombatLog, int);
+
 SpellPower::SpellPower(Entity& entity, double value) : Stat(entity, entity.stats.spell_power, value) {
   name = StatName::kSpellPower;
   calculation_type = CalculationType::kAdditive;
@@ -0,0 +1,108 @@
+#include "../include/timer_queue.h"
+
+#include <limits>
+#include <utility>
+
+int TimerQueue::Add(int priority) {
+  auto timer = Timer();
+  timer.priority = priority;
+  timers.push_back(timer);
+
+  return static_cast<int>(timers.size()) - 1;
+}
+
+void TimerQueue::Schedule(int timer, FightTime time) {
+  Cancel(timer);
+
+  timers[timer].time = time;
+  heap.push_back(timer);
+  timers[timer].heap_index = static_cast<int>(heap.size()) - 1;
+  SiftUp(timers[timer].heap_index);
+}
+
+void TimerQueue::Cancel(int timer) {
+  const int kHeapIndex = timers[timer].heap_index;
+  const int kLastHeapIndex = static_cast<int>(heap.size()) - 1;
+
+  if (kHeapIndex == -1) {
+    return;
+  }
+
+  if (kHeapIndex != kLastHeapIndex) {
+    Swap(kHeapIndex, kLastHeapIndex);
+  }
+  heap.pop_back();
+  timers[timer].heap_index = -1;
+
+  if (kHeapIndex < static_cast<int>(heap.size())) {
+    SiftUp(kHeapIndex);
+    SiftDown(kHeapIndex);
+  }
+}
+
+bool TimerQueue::IsScheduled(int timer) const { return timers[timer].heap_index != -1; }
+
+FightTime TimerQueue::NextTime() const {
+  return heap.empty() ? std::numeric_limits<FightTime>::max() : timers[heap[0]].time;
+}
+
+int TimerQueue::PopDue(FightTime time) {
+  if (heap.empty() || timers[heap[0]].time > time) {
+    return -1;
+  }
+
+  const int kTimer = heap[0];
+  Cancel(kTimer);
+
+  return kTimer;
+}
+
+bool TimerQueue::IsBefore(int heap_index, int other_heap_index) const {
+  const auto& kTimer = timers[heap[heap_index]];
+  const auto& kOtherTimer = timers[heap[other_heap_index]];
+
+  if (kTimer.time != kOtherTimer.time) {
+    return kTimer.time < kOtherTimer.time;
+  }
+  if (kTimer.priority != kOtherTimer.priority) {
+    return kTimer.priority < kOtherTimer.priority;
+  }
+
+  return heap[heap_index] < heap[other_heap_index];
+}
+
+void TimerQueue::Swap(int heap_index, int other_heap_index) {
+  std::swap(heap[heap_index], heap[other_heap_index]);
+  timers[heap[heap_index]].heap_index = heap_index;
+  timers[heap[other_heap_index]].heap_index = other_heap_index;
+}
+
+void TimerQueue::SiftUp(int heap_index) {
+  while (heap_index > 0 && IsBefore(heap_index, (heap_index - 1) / 2)) {
+    Swap(heap_index, (heap_index - 1) / 2);
+    heap_index = (heap_index - 1) / 2;
+  }
+}
+
+void TimerQueue::SiftDown(int heap_index) {
+  const int kSize = static_cast<int>(heap.size());
+
+  while (true) {
+    const int kLeft = 2 * heap_index + 1;
+    const int kRight = kLeft + 1;
+    int smallest = heap_index;
+
+    if (kLeft < kSize && IsBefore(kLeft, smallest)) {
+      smallest = kLeft;
+    }
+    if (kRight < kSize && IsBefore(kRight, smallest)) {
+      smallest = kRight;
+    }
+    if (smallest == heap_index) {
+      return;
+    }
+
+    Swap(heap_index, smallest);
+    heap_index = smallest;
+  }
+}
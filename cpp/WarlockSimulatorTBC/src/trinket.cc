@@ -5,63 +5,74 @@
 
 Trinket::Trinket(Player& player) : player(player) {}
 
-bool Trinket::Ready() { return cooldown_remaining <= 0; }
+bool Trinket::Ready() { return ready_at <= player.simulation->current_fight_time; }
 
-void Trinket::Reset() { cooldown_remaining = 0; }
+void Trinket::Reset() {
+  ready_at = 0;
+  player.trinket_timers.Cancel(cooldown_timer);
+}
 
 void Trinket::Setup() {
-  if (player.recording_combat_log_breakdown && player.combat_log_breakdown.count(name) == 0) {
-    player.combat_log_breakdown.insert({name, std::make_unique<CombatLogBreakdown>(name)});
+  if (player.recording_combat_log_breakdown) {
+    breakdown_index = player.AddCombatLogBreakdownRow(name);
   }
 }
 
-void Trinket::Use() {
-  if (player.ShouldWriteToCombatLog()) {
+template <typename CombatLogPolicy>
+void Trinket::Use(CombatLogPolicy combat_log) {
+  if constexpr (CombatLogPolicy::kWriting) {
     player.CombatLog(name + " used");
   }
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->applied_at = player.simulation->current_fight_time;
-    player.combat_log_breakdown.at(name)->count++;
+    player.combat_log_breakdown[breakdown_index].applied_at = FightTimeToSeconds(player.simulation->current_fight_time);
+    player.combat_log_breakdown[breakdown_index].count++;
   }
 
   for (auto& stat : stats) {
-    stat.AddStat();
+    stat.AddStat(combat_log);
   }
 
   active = true;
-  duration_remaining = duration;
-  cooldown_remaining = cooldown;
+  expires_at = player.simulation->current_fight_time + duration * kFightTimePerSecond;
+  ready_at = player.simulation->current_fight_time + cooldown * kFightTimePerSecond;
+  player.trinket_timers.Schedule(duration_timer, expires_at);
+  player.trinket_timers.Schedule(cooldown_timer, ready_at);
 }
 
-void Trinket::Fade() {
-  if (player.ShouldWriteToCombatLog()) {
+template <typename CombatLogPolicy>
+void Trinket::Fade(CombatLogPolicy combat_log) {
+  if constexpr (CombatLogPolicy::kWriting) {
     player.CombatLog(name + " faded");
   }
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->uptime +=
-        player.simulation->current_fight_time - player.combat_log_breakdown.at(name)->applied_at;
+    auto& breakdown = player.combat_log_breakdown[breakdown_index];
+    breakdown.uptime += FightTimeToSeconds(player.simulation->current_fight_time) - breakdown.applied_at;
   }
 
   for (auto& stat : stats) {
-    stat.RemoveStat();
+    stat.RemoveStat(combat_log);
   }
 
   active = false;
+  player.trinket_timers.Cancel(duration_timer);
 }
 
-void Trinket::Tick(double t) {
-  if (player.ShouldWriteToCombatLog() && cooldown_remaining > 0 && cooldown_remaining - t <= 0) {
+template <typename CombatLogPolicy>
+void Trinket::OffCooldown(CombatLogPolicy) {
+  if constexpr (CombatLogPolicy::kWriting) {
     player.CombatLog(name + " off cooldown");
   }
-  cooldown_remaining -= t;
-  duration_remaining -= t;
-  if (active && duration_remaining <= 0) {
-    Fade();
-  }
 }
 
+template void Trinket::Use(NotWritingCombatLog);
+template void Trinket::Use(WritingCombatLog);
+template void Trinket::Fade(NotWritingCombatLog);
+template void Trinket::Fade(WritingCombatLog);
+template void Trinket::OffCooldown(NotWritingCombatLog);
+template void Trinket::OffCooldown(WritingCombatLog);
+
 RestrainedEssenceOfSapphiron::RestrainedEssenceOfSapphiron(Player& player) : Trinket(player) {
   name = "The Restrained Essence of Sapphiron";
   cooldown = 120;
@@ -0,0 +1,57 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "../include/player.h"
+#include "../include/simulation.h"
+#include "test_profile.h"
+
+// Simulates the test profile and fails if an iteration allocates once the sim has warmed up. The warm-up covers the
+// iteration that writes the combat log, which is the only one that's allowed to allocate.
+constexpr int kWarmUpIterations = 20;
+constexpr int kIterations = 3000;
+
+// The global operator new is replaced to count the allocations while counting_allocations is set. operator new[]
+// goes through it as well.
+static bool counting_allocations = false;
+static int allocations = 0;
+
+void* operator new(std::size_t size) {
+  if (counting_allocations) {
+    allocations++;
+  }
+
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+int main() {
+  auto profile = TestProfile(kIterations);
+  profile.simulation_settings.threads = 1;
+  auto player = Player(profile.player_settings);
+  auto simulation = Simulation(player, profile.simulation_settings);
+
+  player.Initialize(&simulation);
+  simulation.dps_vector.reserve(kIterations);
+  simulation.RunIterations(0, kWarmUpIterations);
+
+  counting_allocations = true;
+  simulation.RunIterations(kWarmUpIterations, kIterations);
+  counting_allocations = false;
+
+  if (allocations > 0) {
+    std::cout << allocations << " allocations in " << kIterations - kWarmUpIterations << " iterations after the warm-up"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << "No allocations in " << kIterations - kWarmUpIterations << " iterations after the warm-up" << std::endl;
+  return 0;
+}
@@ -1,35 +1,132 @@
 importScripts("./WarlockSim.js");
 
-onmessage = (event) => {
-  fetch('./WarlockSim.wasm')
-    .then(response => response.arrayBuffer())
-    .then(binary => WarlockSim({ wasmBinary: binary }))
+// The WarlockSim.wasm checked into public/ can be an older build than this worker until it's rebuilt. That engine is
+// seeded with a vector of one seed per iteration instead of a single seed.
+const isLegacyEngine = (module) => module.allocRandomSeeds !== undefined;
+
+// The stats that the stat weights are simmed for, in the order that the engine sims them in
+const statWeightStats = ['stamina', 'intellect', 'spirit', 'spellPower', 'shadowPower', 'firePower', 'hitRating',
+  'critRating', 'hasteRating', 'mp5'];
+
+const postToPage = self.postMessage.bind(self);
+
+// Runs a sim with the messages that it posts going to handleMessage instead of to the page
+const withMessageHandler = (handleMessage, run) => {
+  const enginePostMessage = self.postMessage;
+  self.postMessage = handleMessage;
+  try {
+    run();
+  } finally {
+    self.postMessage = enginePostMessage;
+  }
+};
+
+// The threaded build needs SharedArrayBuffer, which is only available when the page is cross-origin isolated
+const useThreadedBuild = (threads) => threads > 1 && self.crossOriginIsolated === true;
+
+// Loads the threaded build when it's wanted and deployed, and the single-threaded one otherwise. The threaded build
+// isn't checked into public/, and a missing file can be answered with the site's index page, so the threaded binary is
+// only used when it starts with the wasm magic number.
+const loadEngine = (threads) => {
+  if (!useThreadedBuild(threads)) {
+    return fetch('./WarlockSim.wasm')
+      .then(response => response.arrayBuffer())
+      .then(binary => WarlockSim({ wasmBinary: binary }))
+      .then(w => w.ready)
+      .then(module => ({ module: module, threaded: false }));
+  }
+
+  return fetch('./WarlockSimThreaded.wasm')
+    .then(response => response.ok ? response.arrayBuffer() : Promise.reject(new Error('HTTP ' + response.status)))
+    .then(binary => {
+      const magic = new Uint8Array(binary, 0, Math.min(4, binary.byteLength));
+      if (magic.length < 4 || magic[0] !== 0x00 || magic[1] !== 0x61 || magic[2] !== 0x73 || magic[3] !== 0x6d) {
+        throw new Error('WarlockSimThreaded.wasm isn\'t a wasm binary');
+      }
+
+      importScripts("./WarlockSimThreaded.js");
+      return WarlockSimThreaded({ wasmBinary: binary, mainScriptUrlOrBlob: './WarlockSimThreaded.js' });
+    })
     .then(w => w.ready)
-    .then(module => {
+    .then(module => ({ module: module, threaded: true }))
+    .catch(e => {
+      console.warn('Falling back to the single-threaded build: ' + e.message);
+      return loadEngine(1);
+    });
+};
+
+const buildItems = (module, itemsData) => {
+  const items = module.allocItems();
+  items.head = parseInt(itemsData.head) || 0;
+  items.neck = parseInt(itemsData.neck) || 0;
+  items.shoulders = parseInt(itemsData.shoulders) || 0;
+  items.back = parseInt(itemsData.back) || 0;
+  items.chest = parseInt(itemsData.chest) || 0;
+  items.bracer = parseInt(itemsData.bracer) || 0;
+  items.gloves = parseInt(itemsData.gloves) || 0;
+  items.belt = parseInt(itemsData.belt) || 0;
+  items.legs = parseInt(itemsData.legs) || 0;
+  items.boots = parseInt(itemsData.boots) || 0;
+  items.ring1 = parseInt(itemsData.ring1) || 0;
+  items.ring2 = parseInt(itemsData.ring2) || 0;
+  items.trinket1 = parseInt(itemsData.trinket1) || 0;
+  items.trinket2 = parseInt(itemsData.trinket2) || 0;
+  items.mainhand = parseInt(itemsData.mainhand) || 0;
+  items.offhand = parseInt(itemsData.offhand) || 0;
+  items.twohand = parseInt(itemsData.twohand) || 0;
+  items.wand = parseInt(itemsData.wand) || 0;
+
+  return items;
+};
+
+const buildSets = (module, setsData) => {
+  const sets = module.allocSets();
+  sets.plagueheart = parseInt(setsData['529']) || 0;
+  sets.spellfire = parseInt(setsData['552']) || 0;
+  sets.spellstrike = parseInt(setsData['559']) || 0;
+  sets.oblivion = parseInt(setsData['644']) || 0;
+  sets.manaEtched = parseInt(setsData['658']) || 0;
+  sets.twinStars = parseInt(setsData['667']) || 0;
+  sets.t4 = parseInt(setsData['645']) || 0;
+  sets.t5 = parseInt(setsData['646']) || 0;
+  sets.t6 = parseInt(setsData['670']) || 0;
+
+  return sets;
+};
+
+const buildStats = (module, statsData) => {
+  const stats = module.allocStats();
+  stats.health = parseFloat(statsData.health);
+  stats.mana = parseFloat(statsData.mana);
+  stats.stamina = parseFloat(statsData.stamina);
+  stats.intellect = parseFloat(statsData.intellect);
+  stats.spirit = parseFloat(statsData.spirit);
+  stats.spellPower = parseFloat(statsData.spellPower);
+  stats.shadowPower = parseFloat(statsData.shadowPower);
+  stats.firePower = parseFloat(statsData.firePower);
+  stats.hasteRating = parseFloat(statsData.hasteRating);
+  stats.hitRating = parseFloat(statsData.hitRating);
+  stats.critRating = parseFloat(statsData.critRating);
+  stats.critChance = 0;
+  stats.mp5 = parseFloat(statsData.mp5);
+  stats.manaCostModifier = 1;
+  stats.spellPenetration = parseFloat(statsData.spellPenetration);
+  stats.fireModifier = parseFloat(statsData.fireModifier);
+  stats.shadowModifier = parseFloat(statsData.shadowModifier);
+  stats.staminaModifier = parseFloat(statsData.staminaModifier);
+  stats.intellectModifier = parseFloat(statsData.intellectModifier);
+  stats.spiritModifier = parseFloat(statsData.spiritModifier);
+
+  return stats;
+};
+
+onmessage = (event) => {
+  loadEngine(event.data.simulationSettings.threads)
+    .then(({ module, threaded }) => {
       try {
         const playerData = event.data.playerSettings;
         const simulationData = event.data.simulationSettings;
 
-        const items = module.allocItems();
-        items.head = parseInt(playerData.items.head) || 0;
-        items.neck = parseInt(playerData.items.neck) || 0;
-        items.shoulders = parseInt(playerData.items.shoulders) || 0;
-        items.back = parseInt(playerData.items.back) || 0;
-        items.chest = parseInt(playerData.items.chest) || 0;
-        items.bracer = parseInt(playerData.items.bracer) || 0;
-        items.gloves = parseInt(playerData.items.gloves) || 0;
-        items.belt = parseInt(playerData.items.belt) || 0;
-        items.legs = parseInt(playerData.items.legs) || 0;
-        items.boots = parseInt(playerData.items.boots) || 0;
-        items.ring1 = parseInt(playerData.items.ring1) || 0;
-        items.ring2 = parseInt(playerData.items.ring2) || 0;
-        items.trinket1 = parseInt(playerData.items.trinket1) || 0;
-        items.trinket2 = parseInt(playerData.items.trinket2) || 0;
-        items.mainhand = parseInt(playerData.items.mainhand) || 0;
-        items.offhand = parseInt(playerData.items.offhand) || 0;
-        items.twohand = parseInt(playerData.items.twohand) || 0;
-        items.wand = parseInt(playerData.items.wand) || 0;
-
         const auras = module.allocAuras();
         auras.felArmor = playerData.auras.felArmor || false;
         auras.judgementOfWisdom = playerData.auras.judgementOfWisdom || false;
@@ -140,126 +237,204 @@ onmessage = (event) => {
         talents.shadowAndFlame = parseInt(playerData.talents.shadowAndFlame) || 0;
         talents.shadowfury = parseInt(playerData.talents.shadowfury) || 0;
 
-        const sets = module.allocSets();
-        sets.plagueheart = parseInt(playerData.sets['529']) || 0;
-        sets.spellfire = parseInt(playerData.sets['552']) || 0;
-        sets.spellstrike = parseInt(playerData.sets['559']) || 0;
-        sets.oblivion = parseInt(playerData.sets['644']) || 0;
-        sets.manaEtched = parseInt(playerData.sets['658']) || 0;
-        sets.twinStars = parseInt(playerData.sets['667']) || 0;
-        sets.t4 = parseInt(playerData.sets['645']) || 0;
-        sets.t5 = parseInt(playerData.sets['646']) || 0;
-        sets.t6 = parseInt(playerData.sets['670']) || 0;
+        const buildPlayerSettings = (items, sets, stats, itemId, metaGemId, equippedItemSimulation, customStat) => {
+          const playerSettings = module.allocPlayerSettings(auras, talents, sets, stats, items);
+          if (isLegacyEngine(module)) {
+            playerSettings.randomSeeds = module.allocRandomSeeds(parseInt(simulationData.iterations), event.data.randomSeed);
+          } else {
+            playerSettings.randomSeed = event.data.randomSeed;
+          }
+          playerSettings.itemId = itemId;
+          playerSettings.metaGemId = metaGemId;
+          playerSettings.equippedItemSimulation = equippedItemSimulation;
+          playerSettings.recordingCombatLogBreakdown = playerData.simSettings["automatically-open-sim-details"] === "yes";
+          playerSettings.customStat = module.EmbindConstant[customStat];
+          playerSettings.shattrathFaction =
+            playerData.simSettings.shattrathFaction === "Aldor" ? module.EmbindConstant.aldor : module.EmbindConstant.scryers;
+          playerSettings.enemyLevel = parseInt(playerData.simSettings['target-level']);
+          playerSettings.enemyShadowResist = parseInt(playerData.simSettings['target-shadow-resistance']);
+          playerSettings.enemyFireResist = parseInt(playerData.simSettings['target-fire-resistance']);
+          playerSettings.mageAtieshAmount = parseInt(playerData.simSettings.mageAtieshAmount);
+          playerSettings.totemOfWrathAmount = parseInt(playerData.simSettings.totemOfWrathAmount);
+          playerSettings.chippedPowerCoreAmount = parseInt(playerData.simSettings.chippedPowerCoreAmount);
+          playerSettings.crackedPowerCoreAmount = parseInt(playerData.simSettings.crackedPowerCoreAmount);
+          playerSettings.sacrificingPet = playerData.simSettings.sacrificePet === "yes";
+          if (playerData.simSettings.petChoice === '0') {
+            playerSettings.selectedPet = module.EmbindConstant.imp;
+          } else if (playerData.simSettings.petChoice === '2') {
+            playerSettings.selectedPet = module.EmbindConstant.succubus;
+          } else if (playerData.simSettings.petChoice === '3') {
+            playerSettings.selectedPet = module.EmbindConstant.felhunter;
+          } else if (playerData.simSettings.petChoice === '4') {
+            playerSettings.selectedPet = module.EmbindConstant.felguard;
+          }
+          playerSettings.ferociousInspirationAmount = parseInt(playerData.simSettings.ferociousInspirationAmount);
+          playerSettings.improvedCurseOfTheElements = parseInt(playerData.simSettings.improvedCurseOfTheElements);
+          playerSettings.usingCustomIsbUptime = playerData.simSettings.customIsbUptime === "yes";
+          playerSettings.customIsbUptimeValue = parseFloat(playerData.simSettings.customIsbUptimeValue);
+          playerSettings.improvedDivineSpirit = parseInt(playerData.simSettings.improvedDivineSpirit);
+          playerSettings.improvedImp = parseInt(playerData.simSettings.improvedImpSetting);
+          playerSettings.shadowPriestDps = parseInt(playerData.simSettings.shadowPriestDps);
+          playerSettings.warlockAtieshAmount = parseInt(playerData.simSettings.warlockAtieshAmount);
+          playerSettings.improvedExposeArmor = parseInt(playerData.simSettings.improvedExposeArmor);
+          playerSettings.fightType =
+            !playerData.simSettings.fightType || playerData.simSettings.fightType === "singleTarget" ?
+              module.EmbindConstant.singleTarget : module.EmbindConstant.aoe;
+          playerSettings.enemyAmount = parseInt(playerData.simSettings.enemyAmount);
+          playerSettings.race = module.EmbindConstant[playerData.simSettings.race];
+          playerSettings.powerInfusionAmount = parseInt(playerData.simSettings.powerInfusionAmount);
+          playerSettings.bloodlustAmount = parseInt(playerData.simSettings.bloodlustAmount);
+          playerSettings.innervateAmount = parseInt(playerData.simSettings.innervateAmount);
+          playerSettings.battleSquawkAmount = parseInt(playerData.simSettings.battleSquawkAmount);
+          playerSettings.enemyArmor = parseInt(playerData.simSettings.enemyArmor);
+          playerSettings.exposeWeaknessUptime = parseFloat(playerData.simSettings.exposeWeaknessUptime);
+          playerSettings.improvedFaerieFire = playerData.simSettings.improvedFaerieFire === "yes";
+          playerSettings.infinitePlayerMana = playerData.simSettings.infinitePlayerMana === "yes";
+          playerSettings.infinitePetMana = playerData.simSettings.infinitePetMana === "yes";
+          playerSettings.lashOfPainUsage =
+            playerData.simSettings.lashOfPainUsage === "onCooldown" ? module.EmbindConstant.onCooldown : module.EmbindConstant.noIsb;
+          playerSettings.petMode =
+            playerData.simSettings.petMode === '0' ? module.EmbindConstant.passive : module.EmbindConstant.aggressive;
+          playerSettings.prepopBlackBook = playerData.simSettings.prepopBlackBook === "yes";
+          playerSettings.randomizeValues = playerData.simSettings.randomizeValues === "yes";
+          playerSettings.rotationOption =
+            playerData.simSettings.rotationOption === "simChooses" ? module.EmbindConstant.simChooses : module.EmbindConstant.userChooses;
+          playerSettings.exaltedWithShattrathFaction = playerData.simSettings.shattrathFactionReputation === "yes";
+          playerSettings.survivalHunterAgility = parseInt(playerData.simSettings.survivalHunterAgility);
+          playerSettings.hasImmolate = playerData.rotation.dot && playerData.rotation.dot.immolate;
+          playerSettings.hasCorruption = playerData.rotation.dot && playerData.rotation.dot.corruption;
+          playerSettings.hasSiphonLife = playerData.rotation.dot && playerData.rotation.dot.siphonLife;
+          playerSettings.hasUnstableAffliction = playerData.rotation.dot && playerData.rotation.dot.unstableAffliction;
+          playerSettings.hasSearingPain = playerData.rotation.filler && playerData.rotation.filler.searingPain;
+          playerSettings.hasShadowBolt = playerData.rotation.filler && playerData.rotation.filler.shadowBolt;
+          playerSettings.hasIncinerate = playerData.rotation.filler && playerData.rotation.filler.incinerate;
+          playerSettings.hasCurseOfRecklessness = playerData.rotation.curse && playerData.rotation.curse.curseOfRecklessness;
+          playerSettings.hasCurseOfTheElements = playerData.rotation.curse && playerData.rotation.curse.curseOfTheElements;
+          playerSettings.hasCurseOfAgony = playerData.rotation.curse && playerData.rotation.curse.curseOfAgony;
+          playerSettings.hasCurseOfDoom = playerData.rotation.curse && playerData.rotation.curse.curseOfDoom;
+          playerSettings.hasDeathCoil = playerData.rotation.finisher && playerData.rotation.finisher.deathCoil;
+          playerSettings.hasShadowburn = playerData.rotation.finisher && playerData.rotation.finisher.shadowburn;
+          playerSettings.hasConflagrate = playerData.rotation.finisher && playerData.rotation.finisher.conflagrate;
+          playerSettings.hasShadowfury = playerData.rotation.other && playerData.rotation.other.shadowfury;
+          playerSettings.hasAmplifyCurse = playerData.rotation.other && playerData.rotation.other.amplifyCurse;
+          playerSettings.hasDarkPact = playerData.rotation.other && playerData.rotation.other.darkPact;
+          playerSettings.hasElementalShamanT4Bonus = playerData.simSettings.improvedWrathOfAirTotem === "yes";
 
-        const stats = module.allocStats();
-        stats.health = parseFloat(playerData.stats.health);
-        stats.mana = parseFloat(playerData.stats.mana);
-        stats.stamina = parseFloat(playerData.stats.stamina);
-        stats.intellect = parseFloat(playerData.stats.intellect);
-        stats.spirit = parseFloat(playerData.stats.spirit);
-        stats.spellPower = parseFloat(playerData.stats.spellPower);
-        stats.shadowPower = parseFloat(playerData.stats.shadowPower);
-        stats.firePower = parseFloat(playerData.stats.firePower);
-        stats.hasteRating = parseFloat(playerData.stats.hasteRating);
-        stats.hitRating = parseFloat(playerData.stats.hitRating);
-        stats.critRating = parseFloat(playerData.stats.critRating);
-        stats.critChance = 0;
-        stats.mp5 = parseFloat(playerData.stats.mp5);
-        stats.manaCostModifier = 1;
-        stats.spellPenetration = parseFloat(playerData.stats.spellPenetration);
-        stats.fireModifier = parseFloat(playerData.stats.fireModifier);
-        stats.shadowModifier = parseFloat(playerData.stats.shadowModifier);
-        stats.staminaModifier = parseFloat(playerData.stats.staminaModifier);
-        stats.intellectModifier = parseFloat(playerData.stats.intellectModifier);
-        stats.spiritModifier = parseFloat(playerData.stats.spiritModifier);
+          return playerSettings;
+        };
 
-        const playerSettings = module.allocPlayerSettings(auras, talents, sets, stats, items);
-        playerSettings.randomSeeds = module.allocRandomSeeds(simulationData.iterations, event.data.randomSeed);
-        playerSettings.itemId = parseInt(event.data.itemId);
-        playerSettings.metaGemId = parseInt(event.data.playerSettings.metaGemId);
-        playerSettings.equippedItemSimulation = event.data.equippedItemSimulation === true;
-        playerSettings.recordingCombatLogBreakdown = playerData.simSettings["automatically-open-sim-details"] === "yes";
-        playerSettings.customStat = module.EmbindConstant[event.data.customStat];
-        playerSettings.shattrathFaction =
-          playerData.simSettings.shattrathFaction === "Aldor" ? module.EmbindConstant.aldor : module.EmbindConstant.scryers;
-        playerSettings.enemyLevel = parseInt(playerData.simSettings['target-level']);
-        playerSettings.enemyShadowResist = parseInt(playerData.simSettings['target-shadow-resistance']);
-        playerSettings.enemyFireResist = parseInt(playerData.simSettings['target-fire-resistance']);
-        playerSettings.mageAtieshAmount = parseInt(playerData.simSettings.mageAtieshAmount);
-        playerSettings.totemOfWrathAmount = parseInt(playerData.simSettings.totemOfWrathAmount);
-        playerSettings.chippedPowerCoreAmount = parseInt(playerData.simSettings.chippedPowerCoreAmount);
-        playerSettings.crackedPowerCoreAmount = parseInt(playerData.simSettings.crackedPowerCoreAmount);
-        playerSettings.sacrificingPet = playerData.simSettings.sacrificePet === "yes";
-        if (playerData.simSettings.petChoice === '0') {
-          playerSettings.selectedPet = module.EmbindConstant.imp;
-        } else if (playerData.simSettings.petChoice === '2') {
-          playerSettings.selectedPet = module.EmbindConstant.succubus;
-        } else if (playerData.simSettings.petChoice === '3') {
-          playerSettings.selectedPet = module.EmbindConstant.felhunter;
-        } else if (playerData.simSettings.petChoice === '4') {
-          playerSettings.selectedPet = module.EmbindConstant.felguard;
-        }
-        playerSettings.ferociousInspirationAmount = parseInt(playerData.simSettings.ferociousInspirationAmount);
-        playerSettings.improvedCurseOfTheElements = parseInt(playerData.simSettings.improvedCurseOfTheElements);
-        playerSettings.usingCustomIsbUptime = playerData.simSettings.customIsbUptime === "yes";
-        playerSettings.customIsbUptimeValue = parseFloat(playerData.simSettings.customIsbUptimeValue);
-        playerSettings.improvedDivineSpirit = parseInt(playerData.simSettings.improvedDivineSpirit);
-        playerSettings.improvedImp = parseInt(playerData.simSettings.improvedImpSetting);
-        playerSettings.shadowPriestDps = parseInt(playerData.simSettings.shadowPriestDps);
-        playerSettings.warlockAtieshAmount = parseInt(playerData.simSettings.warlockAtieshAmount);
-        playerSettings.improvedExposeArmor = parseInt(playerData.simSettings.improvedExposeArmor);
-        playerSettings.fightType =
-          !playerData.simSettings.fightType || playerData.simSettings.fightType === "singleTarget" ?
-            module.EmbindConstant.singleTarget : module.EmbindConstant.aoe;
-        playerSettings.enemyAmount = parseInt(playerData.simSettings.enemyAmount);
-        playerSettings.race = module.EmbindConstant[playerData.simSettings.race];
-        playerSettings.powerInfusionAmount = parseInt(playerData.simSettings.powerInfusionAmount);
-        playerSettings.bloodlustAmount = parseInt(playerData.simSettings.bloodlustAmount);
-        playerSettings.innervateAmount = parseInt(playerData.simSettings.innervateAmount);
-        playerSettings.battleSquawkAmount = parseInt(playerData.simSettings.battleSquawkAmount);
-        playerSettings.enemyArmor = parseInt(playerData.simSettings.enemyArmor);
-        playerSettings.exposeWeaknessUptime = parseFloat(playerData.simSettings.exposeWeaknessUptime);
-        playerSettings.improvedFaerieFire = playerData.simSettings.improvedFaerieFire === "yes";
-        playerSettings.infinitePlayerMana = playerData.simSettings.infinitePlayerMana === "yes";
-        playerSettings.infinitePetMana = playerData.simSettings.infinitePetMana === "yes";
-        playerSettings.lashOfPainUsage =
-          playerData.simSettings.lashOfPainUsage === "onCooldown" ? module.EmbindConstant.onCooldown : module.EmbindConstant.noIsb;
-        playerSettings.petMode =
-          playerData.simSettings.petMode === '0' ? module.EmbindConstant.passive : module.EmbindConstant.aggressive;
-        playerSettings.prepopBlackBook = playerData.simSettings.prepopBlackBook === "yes";
-        playerSettings.randomizeValues = playerData.simSettings.randomizeValues === "yes";
-        playerSettings.rotationOption =
-          playerData.simSettings.rotationOption === "simChooses" ? module.EmbindConstant.simChooses : module.EmbindConstant.userChooses;
-        playerSettings.exaltedWithShattrathFaction = playerData.simSettings.shattrathFactionReputation === "yes";
-        playerSettings.survivalHunterAgility = parseInt(playerData.simSettings.survivalHunterAgility);
-        playerSettings.hasImmolate = playerData.rotation.dot && playerData.rotation.dot.immolate;
-        playerSettings.hasCorruption = playerData.rotation.dot && playerData.rotation.dot.corruption;
-        playerSettings.hasSiphonLife = playerData.rotation.dot && playerData.rotation.dot.siphonLife;
-        playerSettings.hasUnstableAffliction = playerData.rotation.dot && playerData.rotation.dot.unstableAffliction;
-        playerSettings.hasSearingPain = playerData.rotation.filler && playerData.rotation.filler.searingPain;
-        playerSettings.hasShadowBolt = playerData.rotation.filler && playerData.rotation.filler.shadowBolt;
-        playerSettings.hasIncinerate = playerData.rotation.filler && playerData.rotation.filler.incinerate;
-        playerSettings.hasCurseOfRecklessness = playerData.rotation.curse && playerData.rotation.curse.curseOfRecklessness;
-        playerSettings.hasCurseOfTheElements = playerData.rotation.curse && playerData.rotation.curse.curseOfTheElements;
-        playerSettings.hasCurseOfAgony = playerData.rotation.curse && playerData.rotation.curse.curseOfAgony;
-        playerSettings.hasCurseOfDoom = playerData.rotation.curse && playerData.rotation.curse.curseOfDoom;
-        playerSettings.hasDeathCoil = playerData.rotation.finisher && playerData.rotation.finisher.deathCoil;
-        playerSettings.hasShadowburn = playerData.rotation.finisher && playerData.rotation.finisher.shadowburn;
-        playerSettings.hasConflagrate = playerData.rotation.finisher && playerData.rotation.finisher.conflagrate;
-        playerSettings.hasShadowfury = playerData.rotation.other && playerData.rotation.other.shadowfury;
-        playerSettings.hasAmplifyCurse = playerData.rotation.other && playerData.rotation.other.amplifyCurse;
-        playerSettings.hasDarkPact = playerData.rotation.other && playerData.rotation.other.darkPact;
-        playerSettings.hasElementalShamanT4Bonus = playerData.simSettings.improvedWrathOfAirTotem === "yes";
+        const items = buildItems(module, playerData.items);
+        const sets = buildSets(module, playerData.sets);
+        const stats = buildStats(module, playerData.stats);
+        const playerSettings = buildPlayerSettings(items, sets, stats, parseInt(event.data.itemId),
+          parseInt(playerData.metaGemId), event.data.equippedItemSimulation === true, event.data.customStat);
 
         const simulationSettings = module.allocSimSettings();
         simulationSettings.iterations = parseInt(simulationData.iterations);
         simulationSettings.minTime = parseInt(simulationData.minTime);
         simulationSettings.maxTime = parseInt(simulationData.maxTime);
         simulationSettings.simulationType = parseInt(event.data.simulationType);
+        simulationSettings.threads = threaded ? parseInt(simulationData.threads) : 1;
+        simulationSettings.statWeightIncrease = parseInt(simulationData.statWeightIncrease) || 0;
+        simulationSettings.targetStandardError = parseFloat(simulationData.targetStandardError) || 0;
+        simulationSettings.relativeStandardError = simulationData.relativeStandardError === true;
+        simulationSettings.minIterations = parseInt(simulationData.minIterations) || 0;
+        simulationSettings.racing = simulationData.racing === true;
+        simulationSettings.antitheticVariates = simulationData.antitheticVariates === true;
 
         const player = module.allocPlayer(playerSettings);
         const simulation = module.allocSim(player, simulationSettings);
-        simulation.start();
+
+        if (event.data.itemCandidates && isLegacyEngine(module)) {
+          // The old engine has no all-items batch, so the items are simmed one after the other and every sim sends
+          // its own results like it did when it had a worker of its own
+          for (const candidateData of event.data.itemCandidates) {
+            const itemId = parseInt(candidateData.itemId);
+            const candidatePlayerSettings = buildPlayerSettings(buildItems(module, candidateData.items),
+              buildSets(module, candidateData.sets), buildStats(module, candidateData.stats), itemId,
+              parseInt(candidateData.metaGemId),
+              event.data.equippedItemSimulation === true && itemId === parseInt(event.data.itemId), 'normal');
+            module.allocSim(module.allocPlayer(candidatePlayerSettings), simulationSettings).start();
+          }
+        } else if (isLegacyEngine(module) &&
+          parseInt(event.data.simulationType) === module.SimulationType.statWeights.value) {
+          // The old engine sims one configuration at a time, so the player and every stat increase are simmed one
+          // after the other on the same seeds. The stat sims only report their progress and the player's sim ends
+          // last, after the stat weights. Their standard errors aren't known.
+          const iterations = parseInt(simulationData.iterations);
+          // The progress is that of all the sims together
+          const postProgress = (update, config, medianDps) => postToPage({
+            event: 'update',
+            data: Object.assign({}, update.data, {
+              iteration: config * iterations + update.data.iteration,
+              iterationAmount: (statWeightStats.length + 1) * iterations,
+              medianDps: medianDps,
+              customStat: 'normal',
+            }),
+          });
+          let playerEnd;
+
+          withMessageHandler(message => {
+            if (message.event === 'end') {
+              playerEnd = message;
+            } else if (message.event === 'update') {
+              postProgress(message, 0, message.data.medianDps);
+            } else {
+              postToPage(message);
+            }
+          }, () => simulation.start());
+
+          statWeightStats.forEach((stat, i) => {
+            let increase = parseInt(simulationData.statWeightIncrease);
+            // Remove hit rating instead if the player isn't hit capped but adding it would overcap them, so it doesn't
+            // get wasted
+            if (stat === 'hitRating' && event.data.hitPercent <= 15.99 &&
+              event.data.hitPercent + increase / 12.62 > 16) {
+              increase *= -1;
+            }
+
+            const statsData = Object.assign({}, playerData.stats);
+            statsData[stat] = parseFloat(statsData[stat]) + increase;
+            const statPlayerSettings = buildPlayerSettings(items, sets, buildStats(module, statsData),
+              parseInt(event.data.itemId), parseInt(playerData.metaGemId), false, stat);
+            let statMedianDps;
+
+            withMessageHandler(message => {
+              if (message.event === 'end') {
+                statMedianDps = message.data.medianDps;
+              } else if (message.event === 'update') {
+                postProgress(message, i + 1, playerEnd.data.medianDps);
+              }
+            }, () => module.allocSim(module.allocPlayer(statPlayerSettings), simulationSettings).start());
+
+            postToPage({
+              event: 'statWeight',
+              data: {
+                customStat: stat,
+                dpsDifference: (increase < 0 ? -1 : 1) * (statMedianDps - playerEnd.data.medianDps),
+                standardError: 0,
+              },
+            });
+          });
+
+          postToPage(playerEnd);
+        } else if (event.data.itemCandidates) {
+          const itemCandidates = module.allocItemCandidates();
+
+          for (const candidateData of event.data.itemCandidates) {
+            const candidate = module.allocItemCandidate();
+            candidate.itemId = parseInt(candidateData.itemId);
+            candidate.metaGemId = parseInt(candidateData.metaGemId);
+            candidate.items = buildItems(module, candidateData.items);
+            candidate.sets = buildSets(module, candidateData.sets);
+            candidate.stats = buildStats(module, candidateData.stats);
+            itemCandidates.push_back(candidate);
+          }
+
+          simulation.startAllItems(itemCandidates);
+        } else {
+          simulation.start();
+        }
       } catch (exceptionPtr) {
         console.error(module.getExceptionMessage(exceptionPtr));
       }
@@ -1,5 +1,5 @@
 class SimWorker {
-  constructor (dpsUpdate, combatLogVector, errorCallback, combatLogUpdate, combatLogBreakdown, simulationEnd, simulationUpdate, workerParams) {
+  constructor (dpsUpdate, combatLogVector, errorCallback, combatLogUpdate, combatLogBreakdown, simulationEnd, simulationUpdate, statWeightResult, workerParams) {
     this.worker = new Worker(`${process.env.PUBLIC_URL}/web.worker.js`);
     this.workerParams = workerParams;
     this.worker.onmessage = function (event) {
@@ -26,6 +26,9 @@ class SimWorker {
         case 'combatLogVector':
           combatLogVector(data);
           break;
+        case 'statWeight':
+          statWeightResult(data);
+          break;
         default:
           return;
       }
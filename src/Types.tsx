@@ -225,6 +225,9 @@ export interface CombatLogBreakdownData {
   glancingBlows: number,
   damage: number,
   manaGain: number,
+  // The sim that it's from, not sent by the old engine
+  itemId?: number,
+  customStat?: string,
 }
 
 export type StatsCollection = {
@@ -284,6 +287,9 @@ export enum Setting {
   improvedImpSetting = 'improvedImpSetting',
   improvedWrathOfAirTotem = 'improvedWrathOfAirTotem',
   maxWebWorkers = 'maxWebWorkers',
+  targetStandardError = 'targetStandardError',
+  racing = 'racing',
+  antitheticVariates = 'antitheticVariates',
 }
 
 export type Settings = {
@@ -333,6 +339,9 @@ export const InitialSettings: { [key in Setting]: string } = {
   improvedImpSetting: '0',
   improvedWrathOfAirTotem: 'no',
   maxWebWorkers: '0',
+  targetStandardError: '0',
+  racing: 'no',
+  antitheticVariates: 'no',
   chippedPowerCoreAmount: '1',
   crackedPowerCoreAmount: '1',
 }
@@ -537,11 +546,14 @@ export interface UiState {
   savedItemDps: SavedItemDps,
   combatLog: { visible: boolean, data: string[] },
   combatLogBreakdown: CombatLogBreakdown,
-  histogram: { visible: boolean, data?: { [key: string]: number } },
+  // pairAverages when the sim simulated mirrored fights, whose iterations are the averages of two fights
+  histogram: { visible: boolean, data?: { [key: string]: number }, pairAverages?: boolean },
   simulationInProgress: boolean,
   statWeights: {
     visible: boolean,
-    statValues: { [key in Stat]?: number }
+    statValues: { [key in Stat]?: number },
+    // Of the stat values, from the standard error of the dps differences they're calculated from
+    statStandardErrors: { [key in Stat]?: number }
   },
 }
 
@@ -585,6 +597,16 @@ export interface WorkerParams {
     iterations: number,
     minTime: number,
     maxTime: number,
+    threads: number,
+    statWeightIncrease: number,
+    // Stops the sim early once the standard error of the mean dps is this low, `iterations` is then the maximum
+    targetStandardError?: number,
+    relativeStandardError?: boolean,
+    minIterations?: number,
+    // All-items sims stop simulating the items that are clearly worse than the best one
+    racing?: boolean,
+    // Every iteration is also simulated on the mirrored random numbers and counts as the average of the two fights
+    antitheticVariates?: boolean,
   },
   randomSeed: number,
   itemId: number,
@@ -592,6 +614,19 @@ export interface WorkerParams {
   itemSubSlot: SubSlotValue,
   customStat: string,
   equippedItemSimulation: boolean,
+  itemCandidates?: ItemCandidate[],
+  // Only used by the worker to sim stat weights on the prebuilt wasm, which can't check the hit cap itself
+  hitPercent?: number,
+}
+
+// The player's items, stats, sets and meta gem with an item equipped, for simulating every item of a slot in one
+// worker
+export interface ItemCandidate {
+  itemId: number,
+  items: ItemAndEnchantStruct,
+  stats: StatsCollection,
+  sets: SetsStruct,
+  metaGemId: number,
 }
 
 export enum SimulationType {
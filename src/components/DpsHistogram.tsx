@@ -11,7 +11,7 @@ export default function DpsHistogram() {
         {
           labels: Object.keys(histogramState.data),
           datasets: [{
-              label: 'DPS Histogram',
+              label: histogramState.pairAverages ? 'DPS Histogram (averages of mirrored fight pairs)' : 'DPS Histogram',
               data: Object.keys(histogramState.data).map(key => histogramState.data![key]),
               borderWidth: 1,
               borderColor: '#9482C9'
@@ -75,6 +75,35 @@ export default function SettingsDisplay() {
             className="settings-right"
           />
         </li>
+        <li title={t('Stops the sim early once the standard error of the mean DPS is this low. The iterations are then the maximum amount of iterations.')}>
+          <label htmlFor='targetStandardError' className="settings-left">
+            {t('Stop at DPS standard error (0 to sim every iteration)')}
+          </label>
+          <input
+            id="targetStandardError"
+            onChange={(e) => settingModifiedHandler(Setting.targetStandardError, e.target.value)}
+            value={playerStore.settings.targetStandardError || 0}
+            step='0.1'
+            min="0"
+            type="number"
+            name="targetStandardError"
+            className="settings-right"
+          />
+        </li>
+        <li title={t('Also simulates every iteration on the mirrored random numbers and counts it as the average of the two fights, which lowers the standard error of the DPS more than simulating twice as many iterations usually would.')}>
+          <label className="settings-left" htmlFor="antitheticVariates">
+            {t('Simulate mirrored fights')}
+          </label>
+          <select
+            className="settings-right"
+            name="antitheticVariates"
+            onChange={(e) => settingModifiedHandler(Setting.antitheticVariates, e.target.value)}
+            value={playerStore.settings.antitheticVariates || 'no'}
+          >
+            <option value="no">{t('No')}</option>
+            <option value="yes">{t('Yes')}</option>
+          </select>
+        </li>
         <li>
           <label htmlFor='min-fight-length' className="settings-left">
             {t('Min Fight Length')}
@@ -746,6 +775,20 @@ export default function SettingsDisplay() {
             />
           </li>
         }
+        <li title={t('Stops simulating the items that are worse than the best item when simulating all items, with 97.5% confidence that none of the items are dropped wrongly.')}>
+          <label className="settings-left" htmlFor="racing">
+            {t('Drop clearly worse items early')}
+          </label>
+          <select
+            className="settings-right"
+            name="racing"
+            onChange={(e) => settingModifiedHandler(Setting.racing, e.target.value)}
+            value={playerStore.settings.racing || 'no'}
+          >
+            <option value="no">{t('No')}</option>
+            <option value="yes">{t('Yes')}</option>
+          </select>
+        </li>
         <li>
           <label className='settings-left'>
             {t('Concurrent item sims amount (set to 0 to use the default amount)')}
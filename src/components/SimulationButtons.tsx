@@ -6,7 +6,7 @@ import { Items } from "../data/Items";
 import { RootState } from "../redux/Store"
 import { clearSavedItemSlotDps, setCombatLogBreakdownValue, setCombatLogData, setCombatLogVisibility, setHistogramData, setHistogramVisibility, setSavedItemDps, setSimulationInProgressStatus, setStatWeightValue, setStatWeightVisibility } from "../redux/UiSlice";
 import { SimWorker } from "../SimWorker.js";
-import { CombatLogBreakdownData, GemColor, ItemAndEnchantStruct, ItemSlot, PlayerState, SelectedGemsStruct, SimulationType, Stat, StatConstant, StatWeightStats, WorkerParams } from "../Types";
+import { CombatLogBreakdownData, GemColor, ItemAndEnchantStruct, ItemCandidate, ItemSlot, PlayerState, SelectedGemsStruct, SimulationType, StatWeightStats, WorkerParams } from "../Types";
 
 interface SimulationUpdate {
   medianDps: number,
@@ -20,21 +20,29 @@ interface SimulationEnd {
   customStat: string,
   itemId: number,
   iterationAmount: number,
+  // The amount of independent iterations that the confidence interval is worth, more than iterationAmount in
+  // antithetic mode. 0 when it isn't known, which it isn't for stat weight and all-items sims.
+  effectiveIterations: number,
+  confidenceInterval: number,
   totalDuration: number,
   maxDps: number,
   minDps: number,
   medianDps: number
 }
 
+interface StatWeightResult {
+  customStat: string,
+  dpsDifference: number,
+  standardError: number
+}
+
 interface IGetWorkerParams {
   itemId: number,
   equippedItemId: number,
   simulationType: SimulationType,
   randomSeed: number,
-  customStat?: {
-    stat: string,
-    value: number
-  }
+  customStat?: string,
+  itemIdsToSim?: number[]
 }
 
 interface ISimulationProgressPercent {
@@ -43,20 +51,8 @@ interface ISimulationProgressPercent {
   customStat?: string
 }
 
+// The amount of each stat the sim adds to the player when calculating stat weights
 const statWeightStatIncrease = 100;
-const statWeightValues: { [key: string]: number } = {
-  'normal': 0,
-  [Stat.stamina]: statWeightStatIncrease,
-  [Stat.intellect]: statWeightStatIncrease,
-  [Stat.spirit]: statWeightStatIncrease,
-  [Stat.spellPower]: statWeightStatIncrease,
-  [Stat.shadowPower]: statWeightStatIncrease,
-  [Stat.firePower]: statWeightStatIncrease,
-  [Stat.hitRating]: statWeightStatIncrease,
-  [Stat.critRating]: statWeightStatIncrease,
-  [Stat.hasteRating]: statWeightStatIncrease,
-  [Stat.mp5]: statWeightStatIncrease,
-}
 
 function getEquippedMetaGemId(items: ItemAndEnchantStruct, gems: SelectedGemsStruct): number {
   if ([null, 0].includes(items.head) || !gems.head || !gems.head[items.head]) { return 0; }
@@ -70,8 +66,6 @@ function getEquippedMetaGemId(items: ItemAndEnchantStruct, gems: SelectedGemsStr
   return 0;
 }
 
-let lastStatWeightUpdateTime: { [key: string]: number } = {};
-
 export function SimulationButtons() {
   const playerState = useSelector((state: RootState) => state.player);
   const uiState = useSelector((state: RootState) => state.ui);
@@ -80,10 +74,13 @@ export function SimulationButtons() {
     useState(localStorage.getItem('medianDps') || '');
   const [minDps, setMinDps] = useState(localStorage.getItem('minDps') || '');
   const [maxDps, setMaxDps] = useState(localStorage.getItem('maxDps') || '');
+  // Whether the min and max dps are of the averages of mirrored fight pairs rather than of single fights
+  const [pairAverageDps, setPairAverageDps] = useState(localStorage.getItem('pairAverageDps') === 'yes');
   const [simulationDuration, setSimulationDuration] =
     useState(localStorage.getItem('simulationDuration') || '');
   const [simulationProgressPercent, setSimulationProgressPercent] = useState(0);
   const [dpsStdev, setDpsStdev] = useState('');
+  const [effectiveIterations, setEffectiveIterations] = useState(0);
   const [simulationType, setSimulationType] = useState(SimulationType.Normal);
   let combatLogEntries: string[] = [];
 
@@ -95,46 +92,39 @@ export function SimulationButtons() {
     return uiState.histogram.data === undefined;
   }
 
-  function getWorkerParams(params: IGetWorkerParams): WorkerParams {
+  function getPlayerStateWithItem(itemId: number): PlayerState {
     let customPlayerState: PlayerState = JSON.parse(JSON.stringify(playerState));
-    let iterationAmount = parseInt(customPlayerState.settings.iterations);
+    customPlayerState
+      .selectedItems[ItemSlotKeyToItemSlot(false, uiState.selectedItemSlot, uiState.selectedItemSubSlot)] = itemId;
 
-    if (params.simulationType === SimulationType.StatWeights) {
-      // Set minimum iteration amount to 100,000 for stat weight sims
-      iterationAmount = Math.max(iterationAmount, 100000);
-      // Increase the iteration amount for stat weight sims if it's not the 'normal' sim with no added stats.
-      if (params.customStat?.stat !== 'normal') {
-        iterationAmount += 20000;
-      }
-    }
+    return customPlayerState;
+  }
+
+  function getItemCandidate(itemId: number): ItemCandidate {
+    const customPlayerState = getPlayerStateWithItem(itemId);
 
-    if (params.simulationType !== SimulationType.StatWeights) {
-      customPlayerState
-        .selectedItems[ItemSlotKeyToItemSlot(false, uiState.selectedItemSlot, uiState.selectedItemSubSlot)] =
-        params.itemId;
+    return {
+      itemId: itemId,
+      items: customPlayerState.selectedItems,
+      stats: calculatePlayerStats(customPlayerState),
+      sets: getItemSetCounts(customPlayerState.selectedItems),
+      metaGemId: getEquippedMetaGemId(customPlayerState.selectedItems, customPlayerState.selectedGems),
     }
+  }
 
-    let playerStats = calculatePlayerStats(customPlayerState);
+  function getWorkerParams(params: IGetWorkerParams): WorkerParams {
+    let customPlayerState: PlayerState = params.simulationType === SimulationType.StatWeights ?
+      JSON.parse(JSON.stringify(playerState)) : getPlayerStateWithItem(params.itemId);
+    let iterationAmount = parseInt(customPlayerState.settings.iterations);
 
     if (params.simulationType === SimulationType.StatWeights) {
-      if (params.customStat?.stat && params.customStat.stat !== 'normal') {
-        let statValue = params.customStat.value;
-
-        if (params.customStat.stat === Stat.hitRating) {
-          const hitPercent = getPlayerHitPercent(customPlayerState);
-          // If the user isn't hitcapped but adding the extra hit rating would overcap them
-          // then instead remove hit rating instead of adding it so it doesn't get wasted.
-          // Using 15.99 instead of 16 because using 16 was causing issues when a player had 
-          // e.g. 15.995 hit percent which would show as 16% in the sidebar but not technically be hit capped.
-          if (hitPercent <= 15.99 &&
-            hitPercent + statWeightValues[Stat.hitRating] / StatConstant.hitRatingPerPercent > StatConstant.hitPercentCap) {
-            statValue *= -1;
-          }
-        }
-        playerStats[params.customStat.stat as Stat]! += statValue;
-      }
+      // Set minimum iteration amount to 10,000 for stat weight sims. Every stat is simmed on the same seeds as the
+      // player without the added stats so the weights need a lot fewer iterations than independent sims would.
+      iterationAmount = Math.max(iterationAmount, 10000);
     }
 
+    const playerStats = calculatePlayerStats(customPlayerState);
+
     return {
       playerSettings: {
         auras: customPlayerState.auras,
@@ -151,15 +141,27 @@ export function SimulationButtons() {
       simulationSettings: {
         iterations: iterationAmount,
         minTime: parseInt(customPlayerState.settings["min-fight-length"]),
-        maxTime: parseInt(customPlayerState.settings['max-fight-length'])
+        maxTime: parseInt(customPlayerState.settings['max-fight-length']),
+        // All-items sims already run one worker per core so they don't get any extra threads
+        threads: params.simulationType === SimulationType.AllItems ? 1 : window.navigator.hardwareConcurrency || 1,
+        statWeightIncrease: statWeightStatIncrease,
+        // Only normal sims stop early. The standard error isn't trusted before a sim has at least a thousand
+        // iterations.
+        targetStandardError: parseFloat(customPlayerState.settings.targetStandardError) || 0,
+        minIterations: 1000,
+        racing: customPlayerState.settings.racing === 'yes',
+        antitheticVariates: customPlayerState.settings.antitheticVariates === 'yes',
       },
       randomSeed: params.randomSeed,
       itemId: params.itemId,
       simulationType: params.simulationType,
       itemSubSlot: uiState.selectedItemSubSlot,
-      customStat: params.customStat?.stat || 'normal',
+      customStat: params.customStat || 'normal',
       equippedItemSimulation: params.itemId === params.equippedItemId ||
         (params.itemId === 0 && params.equippedItemId == null),
+      itemCandidates: params.itemIdsToSim?.map(itemId => getItemCandidate(itemId)),
+      hitPercent: params.simulationType === SimulationType.StatWeights ?
+        getPlayerHitPercent(customPlayerState) : undefined,
     }
   }
 
@@ -173,8 +175,6 @@ export function SimulationButtons() {
     const itemSlot: ItemSlot = ItemSlotKeyToItemSlot(false, uiState.selectedItemSlot, uiState.selectedItemSubSlot);
     const equippedItemId = playerState.selectedItems[itemSlot];
     let simulationsFinished = 0;
-    let simulationsRunning = 0;
-    let simIndex = 0;
     let dpsArray: number[] = [];
     let dpsCount: { [key: string]: number } = {};
     let combatLogBreakdownArr: CombatLogBreakdownData[] = [];
@@ -185,25 +185,36 @@ export function SimulationButtons() {
     // Used to keep track of the progress % of sims for the progress bar.
     let simulationProgressPercentages: ISimulationProgressPercent[] = [];
     let simWorkerParameters: IGetWorkerParams[] = [];
+    // The end of the sim whose breakdown is shown
+    let shownSimulationEnd: SimulationEnd | undefined;
     combatLogEntries = [];
     dispatch(setSimulationInProgressStatus(true));
     setSimulationType(simulationParams.type);
+    // Only normal sims know it, the other sims would otherwise leave the previous sim's amount under their DPS
+    setEffectiveIterations(0);
     if (simulationParams.type === SimulationType.AllItems) {
       dispatch(clearSavedItemSlotDps(itemSlot));
     } else if (simulationParams.type === SimulationType.StatWeights) {
       dispatch(setStatWeightVisibility(true));
     }
     const randomSeed = random(0, 4294967295);
+    const simulatingMirroredFights = playerState.settings.antitheticVariates === 'yes';
+    // The sim of the currently equipped item, or of the unchanged player in stat weight sims. Every sim records a
+    // breakdown but only this one's is shown. The old engine's breakdown messages don't say which sim they're from,
+    // but only the equipped item's sim sends them there.
+    const isShownSimulation = (itemId?: number, customStat?: string) => itemId === undefined ||
+      simulationParams.type === SimulationType.Normal ||
+      (simulationParams.type === SimulationType.AllItems && itemId === equippedItemId) ||
+      (simulationParams.type === SimulationType.StatWeights && customStat === 'normal');
 
     if (simulationParams.type === SimulationType.StatWeights) {
-      Object.entries(statWeightValues).forEach(statWeight => {
-        simWorkerParameters.push({
-          randomSeed: randomSeed,
-          itemId: equippedItemId,
-          equippedItemId: equippedItemId,
-          simulationType: simulationParams.type,
-          customStat: { stat: statWeight[0], value: statWeight[1] }
-        });
+      // A single worker sims the player and every stat increase and sends back a result per stat
+      simWorkerParameters.push({
+        randomSeed: randomSeed,
+        itemId: equippedItemId,
+        equippedItemId: equippedItemId,
+        simulationType: simulationParams.type,
+        customStat: 'normal'
       });
     } else if (simulationParams.itemIdsToSim) {
       simulationParams.itemIdsToSim.forEach(itemId => {
@@ -216,20 +227,40 @@ export function SimulationButtons() {
       });
     }
 
+    // All-items sims split the items between at most one worker per core and each worker sims its items in one batch.
+    // The equipped item goes first so that its worker is set up with it and writes its combat log.
+    let workerParameterGroups: IGetWorkerParams[][] = simWorkerParameters.map(e => [e]);
+    if (simulationParams.type === SimulationType.AllItems) {
+      simWorkerParameters.sort((a, b) => Number(b.itemId === equippedItemId) - Number(a.itemId === equippedItemId));
+      workerParameterGroups = [];
+      simWorkerParameters.forEach((simWorkerParameter, i) => {
+        if (i < maxWorkers) {
+          workerParameterGroups.push([]);
+        }
+        workerParameterGroups[i % maxWorkers].push(simWorkerParameter);
+      });
+    }
+
     try {
       simWorkerParameters.forEach(simWorkerParameter => {
         simulationProgressPercentages.push({
           itemId: simWorkerParameter.itemId,
           progressPercent: 0,
-          customStat: simWorkerParameter.customStat?.stat
+          customStat: simWorkerParameter.customStat
         });
+      });
+
+      workerParameterGroups.forEach(workerParameters => {
         simulations.push(new SimWorker(
           (dpsUpdate: { dps: number }) => {
             dpsArray.push(dpsUpdate.dps);
             const dps: string = Math.round(dpsUpdate.dps).toString();
             dpsCount[dps] = Math.round(dpsCount[dps]) + 1 || 1;
           },
-          (combatLogVector: { name: string, damage: number, manaGain: number }) => {
+          (combatLogVector: { name: string, damage: number, manaGain: number, itemId?: number, customStat?: string }) => {
+            if (!isShownSimulation(combatLogVector.itemId, combatLogVector.customStat)) {
+              return;
+            }
             spellDamageDict[combatLogVector.name] =
               spellDamageDict[combatLogVector.name] + combatLogVector.damage || combatLogVector.damage;
             spellManaGainDict[combatLogVector.name] =
@@ -245,7 +276,9 @@ export function SimulationButtons() {
             combatLogEntries.push(combatLogUpdate.combatLogEntry);
           },
           (combatLogBreakdown: CombatLogBreakdownData) => {
-            combatLogBreakdownArr.push(combatLogBreakdown);
+            if (isShownSimulation(combatLogBreakdown.itemId, combatLogBreakdown.customStat)) {
+              combatLogBreakdownArr.push(combatLogBreakdown);
+            }
           },
           (params: SimulationEnd) => {
             const newMedianDps = params.medianDps;
@@ -262,18 +295,14 @@ export function SimulationButtons() {
             }
 
             // Callback for the currently equipped item
-            if (simulationParams.type === SimulationType.Normal ||
-              (simulationParams.type === SimulationType.AllItems && params.itemId === equippedItemId) ||
-              (simulationParams.type === SimulationType.StatWeights && params.customStat === 'normal')) {
+            if (isShownSimulation(params.itemId, params.customStat)) {
+              shownSimulationEnd = params;
               const newMinDps = Math.round(params.minDps * 100) / 100;
               const newMaxDps = Math.round(params.maxDps * 100) / 100;
               setNewMedianDps(newMedianDps.toString(), true);
               setNewMinDps(newMinDps.toString(), true);
               setNewMaxDps(newMaxDps.toString(), true);
-            }
-
-            if (simulationParams.type === SimulationType.StatWeights) {
-              updateStatWeightValue(params.customStat, newMedianDps, true);
+              setNewPairAverageDps(simulatingMirroredFights, true);
             }
 
             if (simulationsFinished === simWorkerParameters.length) {
@@ -289,27 +318,22 @@ export function SimulationButtons() {
 
               if (simulationParams.type === SimulationType.Normal) {
                 setDpsStdev(Math.round(getStdev(dpsArray)).toString());
-                dispatch(setHistogramData(dpsCount));
-
-                if (playerState.settings["automatically-open-sim-details"] === 'yes') {
-                  dispatch(setCombatLogBreakdownValue({
-                    totalDamageDone: totalDamageDone,
-                    totalManaGained: totalManaRegenerated,
-                    totalSimulationFightLength: params.totalDuration,
-                    totalIterationAmount: params.iterationAmount,
-                    spellDamageDict: spellDamageDict,
-                    spellManaGainDict: spellManaGainDict,
-                    data: combatLogBreakdownArr,
-                  }));
-                  jQuery('.breakdown-table').trigger('update');
-                }
+                setEffectiveIterations(params.effectiveIterations !== params.iterationAmount ?
+                  params.effectiveIterations : 0);
+                dispatch(setHistogramData({ data: dpsCount, pairAverages: simulatingMirroredFights }));
               }
-            }
-            else if (simulationParams.type === SimulationType.AllItems) {
-              if (simulationsRunning - simulationsFinished < maxWorkers &&
-                simIndex < simulations.length) {
-                simulations[simIndex++].start();
-                simulationsRunning++;
+
+              if (shownSimulationEnd && playerState.settings["automatically-open-sim-details"] === 'yes') {
+                dispatch(setCombatLogBreakdownValue({
+                  totalDamageDone: totalDamageDone,
+                  totalManaGained: totalManaRegenerated,
+                  totalSimulationFightLength: shownSimulationEnd.totalDuration,
+                  totalIterationAmount: shownSimulationEnd.iterationAmount,
+                  spellDamageDict: spellDamageDict,
+                  spellManaGainDict: spellManaGainDict,
+                  data: combatLogBreakdownArr,
+                }));
+                jQuery('.breakdown-table').trigger('update');
               }
             }
           },
@@ -338,49 +362,41 @@ export function SimulationButtons() {
               (simulationParams.type === SimulationType.AllItems && params.itemId === equippedItemId) ||
               (simulationParams.type === SimulationType.StatWeights && params.customStat === 'normal')) {
               setNewMedianDps(newMedianDps.toString(), false);
-            } else if (simulationParams.type === SimulationType.StatWeights) {
-              // Limit the updates to once every 5 seconds
-              const dateNow = Date.now();
-              if (!lastStatWeightUpdateTime[params.customStat] ||
-                dateNow - lastStatWeightUpdateTime[params.customStat] > 5000) {
-                updateStatWeightValue(params.customStat, params.medianDps, false);
-                lastStatWeightUpdateTime[params.customStat] = dateNow;
-              }
             }
           },
+          (statWeight: StatWeightResult) => {
+            updateStatWeightValue(statWeight.customStat, statWeight.dpsDifference, statWeight.standardError);
+          },
           getWorkerParams({
             randomSeed: randomSeed,
-            itemId: simWorkerParameter.itemId,
-            equippedItemId: simWorkerParameter.equippedItemId,
-            simulationType: simWorkerParameter.simulationType,
-            customStat: simWorkerParameter.customStat,
+            itemId: workerParameters[0].itemId,
+            equippedItemId: workerParameters[0].equippedItemId,
+            simulationType: workerParameters[0].simulationType,
+            customStat: workerParameters[0].customStat,
+            itemIdsToSim: simulationParams.type === SimulationType.AllItems ?
+              workerParameters.map(e => e.itemId) : undefined,
           })
         ));
       });
 
       const startTime = performance.now();
-      while ((simulationsRunning < maxWorkers ||
-        simulationParams.type === SimulationType.StatWeights) &&
-        simIndex < simulations.length) {
-        simulations[simIndex++].start();
-        simulationsRunning++;
-      }
+      simulations.forEach(simulation => simulation.start());
     } catch (error) {
       dispatch(setSimulationInProgressStatus(false));
       throw new Error("Error when trying to run simulation. " + error);
     }
   }
 
-  function updateStatWeightValue(stat: string, value: number, finalStatWeightUpdate: boolean): void {
-    let dpsDifference =
-      Math.abs(Math.round(((value - Number(medianDps)) / statWeightStatIncrease) * 1000) / 1000);
-    if (dpsDifference < 0.05) {
-      dpsDifference = 0;
+  function updateStatWeightValue(stat: string, dpsDifference: number, standardError: number): void {
+    let statWeight = Math.abs(Math.round((dpsDifference / statWeightStatIncrease) * 1000) / 1000);
+    if (statWeight < 0.05) {
+      statWeight = 0;
     }
 
     dispatch(setStatWeightValue({
       stat: stat as unknown as [keyof StatWeightStats],
-      value: dpsDifference
+      value: statWeight,
+      standardError: Math.round((standardError / statWeightStatIncrease) * 1000) / 1000
     }));
   }
 
@@ -434,6 +450,13 @@ export function SimulationButtons() {
     }
   }
 
+  function setNewPairAverageDps(newPairAverageDps: boolean, savingLocalStorage: boolean) {
+    setPairAverageDps(newPairAverageDps);
+    if (savingLocalStorage) {
+      localStorage.setItem('pairAverageDps', newPairAverageDps ? 'yes' : 'no');
+    }
+  }
+
   function setNewSimulationDuration(newSimulationDuration: string, savingLocalStorage: boolean) {
     setSimulationDuration(newSimulationDuration);
     if (savingLocalStorage) {
@@ -452,11 +475,22 @@ export function SimulationButtons() {
                 Math.round(Number(medianDps) * 100) / 100
               }
             </span>
-            <span> DPS</span> <span id="dps-stdev">{dpsStdev.length > 0 ? '±' + dpsStdev : ''}</span>
+            <span> DPS</span> <span id="dps-stdev" title={pairAverageDps ? 'Of the averages of the mirrored fight pairs' : undefined}>
+              {dpsStdev.length > 0 ? '±' + dpsStdev : ''}
+            </span>
           </p>
           {
             maxDps.length > 0 && minDps.length > 0 &&
-            <p>Min: <span id="min-dps">{minDps}</span> Max: <span id="max-dps">{maxDps}</span></p>
+            <p title={pairAverageDps ? 'Of the averages of the mirrored fight pairs, not of single fights' : undefined}>
+              Min: <span id="min-dps">{minDps}</span> Max: <span id="max-dps">{maxDps}</span>
+              {pairAverageDps ? ' (pair averages)' : ''}
+            </p>
+          }
+          {
+            effectiveIterations > 0 &&
+            <p title='The amount of independent iterations that would have given the same standard error'>
+              Worth <span id="effective-iterations">{effectiveIterations}</span> iterations
+            </p>
           }
         </div>
       }
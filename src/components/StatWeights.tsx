@@ -44,8 +44,12 @@ export default function StatWeights() {
           statDisplay.map(stat =>
             <li key={nanoid()}>
               <p className='character-stat'>{stat.displayName}</p>
-              <p className='character-stat-val'>
+              <p className='character-stat-val' title={t('Standard error')}>
                 {uiState.statWeights.statValues[stat.stat as unknown as Stat]}
+                {
+                  (uiState.statWeights.statStandardErrors[stat.stat as unknown as Stat] || 0) > 0 &&
+                  ' ±' + uiState.statWeights.statStandardErrors[stat.stat as unknown as Stat]
+                }
               </p>
             </li>
           )
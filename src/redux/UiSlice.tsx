@@ -30,7 +30,8 @@ const initialUiState : UiState = {
       [Stat.critRating]: 0,
       [Stat.hasteRating]: 0,
       [Stat.mp5]: 0,
-    }
+    },
+    statStandardErrors: {},
   },
 }
 
@@ -118,14 +119,16 @@ export const UiSlice = createSlice({
     setHistogramVisibility: (state, action: PayloadAction<boolean>) => {
       state.histogram.visible = action.payload;
     },
-    setHistogramData: (state, action: PayloadAction<{[key: string]: number}>) => {
-      state.histogram.data = action.payload;
+    setHistogramData: (state, action: PayloadAction<{ data: {[key: string]: number}, pairAverages: boolean }>) => {
+      state.histogram.data = action.payload.data;
+      state.histogram.pairAverages = action.payload.pairAverages;
     },
     setStatWeightVisibility: (state, action: PayloadAction<boolean>) => {
       state.statWeights.visible = action.payload;
     },
-    setStatWeightValue: (state, action: PayloadAction<{ stat: [keyof StatWeightStats], value: number }>) => {
+    setStatWeightValue: (state, action: PayloadAction<{ stat: [keyof StatWeightStats], value: number, standardError: number }>) => {
       state.statWeights.statValues[action.payload.stat as unknown as Stat] = action.payload.value;
+      state.statWeights.statStandardErrors[action.payload.stat as unknown as Stat] = action.payload.standardError;
     },
     setSimulationInProgressStatus: (state, action: PayloadAction<boolean>) => {
       state.simulationInProgress = action.payload;